@@ -41,6 +41,9 @@
 //#define ENH_DISABLE_FORCED_SAVE_UPGRADES // Prevents the forced format-version upgrade of world/level saves, effectively opting-out of new save formats. See LEVEL_STORAGE_VERSION_DEFAULT in LevelData.hpp.
 //#define ENH_FACED_TERRAIN_PARTICLES 	   // Sets the TerrainParticle's texture depending on the face the block is being hit from. This is something Notch never did for whatever reason.
 #define ENH_NEW_LADDER_BEHAVIOR 	       // Use Java Beta 1.5 ladder behavior
+#define ENH_ASYNC_CHUNK_IO 	               // Read and write chunks.dat on a dedicated I/O thread instead of the game thread
+#define ENH_COMPACT_CHUNK_VERTICES 	       // Store chunk meshes with 16-bit positions and texture coordinates, 16 bytes per vertex instead of 24
+#define ENH_CULL_OCCLUDED_CHUNKS 	       // Skip chunk sections the camera can't see into, by flooding through the faces each section lets it see through
 
 // TODO: Implement this permanently?
 #define ENH_IMPROVED_SAVING     	 // Improve world saving. The original Minecraft doesn't always really save for some reason
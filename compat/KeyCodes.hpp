@@ -37,4 +37,31 @@
 
     #define AKEYCODE_ARROW_LEFT  AKEYCODE_DPAD_LEFT
     #define AKEYCODE_ARROW_RIGHT AKEYCODE_DPAD_RIGHT
-#endif
\ No newline at end of file
+#endif
+
+#if !defined(USE_SDL) && !defined(_WIN32) && !defined(__APPLE__) && !defined(USE_NATIVE_ANDROID)
+    // Custom: Headless builds, like the dedicated server, never get a key press, but
+    // the GUI code in the core still has to compile. These are the Windows virtual
+    // key codes, same as the default key mappings in Options when there's no SDL.
+    #define AKEYCODE_FORWARD_DEL   0x2E
+    #define AKEYCODE_ARROW_LEFT    0x25
+    #define AKEYCODE_ARROW_RIGHT   0x27
+    #define AKEYCODE_DEL           0x08
+    #define AKEYCODE_ENTER         0x0D
+    #define AKEYCODE_A             'A'
+    #define AKEYCODE_Z             'Z'
+    #define AKEYCODE_0             '0'
+    #define AKEYCODE_9             '9'
+    #define AKEYCODE_SPACE         0x20
+    #define AKEYCODE_COMMA         0xBC
+    #define AKEYCODE_PERIOD        0xBE
+    #define AKEYCODE_PLUS          0xBB
+    #define AKEYCODE_MINUS         0xBD
+    #define AKEYCODE_SEMICOLON     0xBA
+    #define AKEYCODE_SLASH         0xBF
+    #define AKEYCODE_GRAVE         0xC0
+    #define AKEYCODE_BACKSLASH     0xDC
+    #define AKEYCODE_APOSTROPHE    0xDE
+    #define AKEYCODE_LEFT_BRACKET  0xDB
+    #define AKEYCODE_RIGHT_BRACKET 0xDD
+#endif
@@ -0,0 +1,243 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#include "DedicatedServer.hpp"
+#include "common/CThread.hpp"
+#include "common/Utils.hpp"
+#include "network/RakNetInstance.hpp"
+#include "network/ServerSideNetworkHandler.hpp"
+#include "world/level/Level.hpp"
+#include "world/level/storage/ExternalFileLevelStorageSource.hpp"
+#include "world/tile/SandTile.hpp"
+
+// how many ticks a slow loop makes up for, the rest is skipped
+#define C_MAX_CATCH_UP_TICKS (10)
+// the longest it sleeps without looking at the network
+#define C_MAX_IDLE_SLEEP_MS (10)
+
+DedicatedServerConfig::DedicatedServerConfig()
+{
+	m_storagePath = ".";
+	m_levelDir = "world";
+	m_levelName = "world";
+	m_serverName = "Dedicated Server";
+	m_seed = 0;
+	m_port = C_DEFAULT_PORT;
+	m_maxPlayers = C_MAX_CONNECTIONS;
+	m_ticksPerSecond = 20;
+	m_autosaveTicks = 20 * 60 * 5;
+	m_bVisible = true;
+}
+
+DedicatedServer::DedicatedServer(const DedicatedServerConfig& config) : m_config(config)
+{
+	m_pLevelStorageSource = nullptr;
+	m_pLevel = nullptr;
+	m_pRakNetInstance = nullptr;
+	m_pNetworkHandler = nullptr;
+	m_bStop = false;
+	m_nTicks = 0;
+	m_nSkippedTicks = 0;
+}
+
+DedicatedServer::~DedicatedServer()
+{
+	// the handler stops listening to the level when it's deleted
+	SAFE_DELETE(m_pNetworkHandler);
+	SAFE_DELETE(m_pRakNetInstance);
+
+	if (m_pLevel)
+	{
+		LevelStorage* pStorage = m_pLevel->getLevelStorage();
+		SAFE_DELETE(pStorage);
+		SAFE_DELETE(m_pLevel);
+	}
+
+	SAFE_DELETE(m_pLevelStorageSource);
+}
+
+bool DedicatedServer::start()
+{
+	m_pLevelStorageSource = new ExternalFileLevelStorageSource(m_config.m_storagePath);
+
+	if (m_pLevelStorageSource->requiresConversion(m_config.m_levelDir))
+	{
+		LOG_E("Level \"%s\" is in an old format. Open it in the game once to convert it.", m_config.m_levelDir.c_str());
+		return false;
+	}
+
+	LevelStorage* pStor = m_pLevelStorageSource->selectLevel(m_config.m_levelDir, false, false);
+	m_pLevel = new Level(pStor, m_config.m_levelName, m_config.m_seed, LEVEL_STORAGE_VERSION_DEFAULT, Dimension::getNew(0));
+
+	LOG_I("Preparing level \"%s\"", m_config.m_levelDir.c_str());
+	double startTime = getTimeS();
+	_prepareLevel();
+	LOG_I("Level prepared in %.2f seconds", getTimeS() - startTime);
+	(void)startTime; // LOG_I compiles to nothing in some builds
+
+	m_pRakNetInstance = new RakNetInstance;
+	if (!m_pRakNetInstance->host(m_config.m_serverName, m_config.m_port, m_config.m_maxPlayers))
+	{
+		LOG_E("Can't listen on port %d", m_config.m_port);
+		return false;
+	}
+
+	m_pNetworkHandler = new ServerSideNetworkHandler(this, m_pRakNetInstance);
+	m_pNetworkHandler->levelGenerated(m_pLevel);
+
+	LOG_I("Serving \"%s\" on port %d, up to %d players", m_config.m_serverName.c_str(), m_config.m_port, m_config.m_maxPlayers);
+	return true;
+}
+
+void DedicatedServer::_prepareLevel()
+{
+	// What Minecraft::prepareLevel does, without the progress tracking
+	Level* pLevel = m_pLevel;
+
+	if (!pLevel->field_B0C)
+		pLevel->setUpdateLights(0);
+	else
+		pLevel->getChunkSource()->prepareChunks(ChunkPos(0, 0), ChunkPos(C_MAX_CHUNKS_X - 1, C_MAX_CHUNKS_Z - 1));
+
+	for (int x = 8; x < C_MAX_CHUNKS_X * 16; x += 16)
+	{
+		for (int z = 8; z < C_MAX_CHUNKS_Z * 16; z += 16)
+		{
+			(void)pLevel->getTile(TilePos(x, (C_MAX_Y + C_MIN_Y) / 2, z));
+
+			if (pLevel->field_B0C)
+			{
+				while (pLevel->updateLights());
+			}
+		}
+	}
+
+	pLevel->setUpdateLights(1);
+
+	ChunkPos cp(0, 0);
+	for (cp.x = 0; cp.x < C_MAX_CHUNKS_X; cp.x++)
+	{
+		for (cp.z = 0; cp.z < C_MAX_CHUNKS_Z; cp.z++)
+		{
+			LevelChunk* pChunk = pLevel->getChunk(cp);
+			if (!pChunk || pChunk->field_237)
+				continue;
+
+			pChunk->m_bUnsaved = false;
+			pChunk->clearUpdateMap();
+		}
+	}
+
+	if (pLevel->field_B0C)
+	{
+		pLevel->setInitialSpawn();
+		pLevel->saveLevelData();
+		pLevel->getChunkSource()->saveAll();
+		pLevel->saveGame();
+	}
+	else
+	{
+		pLevel->saveLevelData();
+		pLevel->loadEntities();
+	}
+
+	pLevel->prepare();
+	pLevel->validateSpawn();
+
+	SandTile::instaFall = false;
+}
+
+void DedicatedServer::_runEvents()
+{
+	m_pRakNetInstance->runEvents(m_pNetworkHandler);
+	m_pNetworkHandler->tick();
+}
+
+void DedicatedServer::tick()
+{
+	m_pLevel->tickEntities();
+	m_pLevel->tick();
+
+	m_nTicks++;
+	if (m_config.m_autosaveTicks > 0 && m_nTicks % m_config.m_autosaveTicks == 0)
+		save();
+}
+
+void DedicatedServer::run()
+{
+	double tickLength = 1.0 / double(m_config.m_ticksPerSecond);
+	double nextTick = getTimeS();
+
+	while (!m_bStop)
+	{
+		_runEvents();
+
+		double now = getTimeS();
+		int nTicks = 0;
+		while (now >= nextTick && nTicks < C_MAX_CATCH_UP_TICKS)
+		{
+			tick();
+			nextTick += tickLength;
+			nTicks++;
+		}
+
+		// too far behind, the level just runs slower for a bit
+		if (now >= nextTick)
+		{
+			int nSkipped = int((now - nextTick) / tickLength) + 1;
+			nextTick += nSkipped * tickLength;
+			m_nSkippedTicks += nSkipped;
+			LOG_W("Can't keep up! Skipped %d ticks, %d in total", nSkipped, m_nSkippedTicks);
+		}
+
+		m_pLevel->updateLights();
+
+		double waitMs = (nextTick - getTimeS()) * 1000.0;
+		if (waitMs >= 1.0)
+			CThread::sleep(uint32_t(waitMs < C_MAX_IDLE_SLEEP_MS ? waitMs : C_MAX_IDLE_SLEEP_MS));
+	}
+
+	LOG_I("Stopping after %d ticks", m_nTicks);
+	save();
+}
+
+void DedicatedServer::save()
+{
+	m_pLevel->saveUnsavedChunks();
+	m_pLevel->saveLevelData();
+	m_pLevel->savePlayerData();
+}
+
+Player* DedicatedServer::getHostPlayer()
+{
+	return nullptr;
+}
+
+std::string DedicatedServer::getServerName()
+{
+	return m_config.m_serverName;
+}
+
+bool DedicatedServer::isServerVisibleByDefault()
+{
+	return m_config.m_bVisible;
+}
+
+void DedicatedServer::displayMessage(const std::string& msg)
+{
+	LOG_I("%s", msg.c_str());
+}
+
+void DedicatedServer::showDestroyEffect(const TilePos& pos)
+{
+}
+
+bool DedicatedServer::handleCrafting(Player* pPlayer, CraftingGrid& grid)
+{
+	return pPlayer->m_pInventory->craft(grid);
+}
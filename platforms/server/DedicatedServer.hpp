@@ -0,0 +1,77 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#pragma once
+
+#include <string>
+#include "network/GameCallbacks.hpp"
+
+class Level;
+class LevelStorageSource;
+class RakNetInstance;
+class ServerSideNetworkHandler;
+
+// DedicatedServer - Serves a level without a Minecraft instance.
+//
+// Nobody plays on the server itself, so there's nothing to render, play or
+// show. The level is ticked at a fixed rate, and the network events are run
+// in between the ticks.
+
+struct DedicatedServerConfig
+{
+	std::string m_storagePath;
+	std::string m_levelDir;
+	std::string m_levelName;
+	std::string m_serverName;
+	int32_t m_seed;
+	int m_port;
+	int m_maxPlayers;
+	int m_ticksPerSecond;
+	int m_autosaveTicks; // 0 to only save when stopping
+	bool m_bVisible;
+
+	DedicatedServerConfig();
+};
+
+class DedicatedServer : public GameCallbacks
+{
+public:
+	DedicatedServer(const DedicatedServerConfig& config);
+	~DedicatedServer();
+
+	// Loads or generates the level, and starts listening. Returns false if the port can't be used.
+	bool start();
+	// Ticks until stop() is called, then saves the level
+	void run();
+	// Can be called from a signal handler
+	void stop() { m_bStop = true; }
+	void tick();
+	void save();
+
+	// Overridden from GameCallbacks
+	Player* getHostPlayer() override;
+	std::string getServerName() override;
+	bool isServerVisibleByDefault() override;
+	void displayMessage(const std::string& msg) override;
+	void showDestroyEffect(const TilePos& pos) override;
+	bool handleCrafting(Player* pPlayer, CraftingGrid& grid) override;
+
+private:
+	void _prepareLevel();
+	void _runEvents();
+
+private:
+	DedicatedServerConfig m_config;
+	LevelStorageSource* m_pLevelStorageSource;
+	Level* m_pLevel;
+	RakNetInstance* m_pRakNetInstance;
+	ServerSideNetworkHandler* m_pNetworkHandler;
+	volatile bool m_bStop;
+	int m_nTicks;
+	int m_nSkippedTicks;
+};
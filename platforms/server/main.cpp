@@ -0,0 +1,133 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+
+#include "common/Logger.hpp"
+#include "common/Mth.hpp"
+#include "common/Utils.hpp"
+#include "world/entity/EntityTypeDescriptor.hpp"
+#include "world/entity/MobCategory.hpp"
+#include "world/item/Item.hpp"
+#include "world/level/Material.hpp"
+#include "world/level/levelgen/biome/Biome.hpp"
+#include "world/tile/Tile.hpp"
+#include "ToolConfig.hpp"
+#include "DedicatedServer.hpp"
+
+static DedicatedServer* g_pServer;
+
+static void handleSignal(int sig)
+{
+	if (g_pServer)
+		g_pServer->stop();
+}
+
+static void printUsage(const char* name)
+{
+	printf("Usage: %s [options]\n", name);
+	printf("  --path <dir>         where games/com.mojang/minecraftWorlds is (default: .)\n");
+	printf("  --level <dir>        the level's folder in there (default: world)\n");
+	printf("  --level-name <name>  the name of a new level (default: world)\n");
+	printf("  --seed <n>           the seed of a new level (default: random)\n");
+	printf("  --name <name>        the name the server is announced with\n");
+	printf("  --port <n>           (default: %d)\n", C_DEFAULT_PORT);
+	printf("  --max-players <n>    (default: %d)\n", C_MAX_CONNECTIONS);
+	printf("  --autosave <s>       seconds between saves, 0 to only save when stopping (default: 300)\n");
+	printf("  --hidden             don't announce the server on the LAN\n");
+}
+
+static bool parseArgs(int argc, char* argv[], DedicatedServerConfig& config)
+{
+	bool bHaveSeed = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+		if (!strcmp(arg, "--hidden"))
+		{
+			config.m_bVisible = false;
+			continue;
+		}
+
+		if (!value)
+			return false;
+		i++;
+
+		if (!strcmp(arg, "--path"))
+			config.m_storagePath = value;
+		else if (!strcmp(arg, "--level"))
+			config.m_levelDir = value;
+		else if (!strcmp(arg, "--level-name"))
+			config.m_levelName = value;
+		else if (!strcmp(arg, "--seed"))
+		{
+			config.m_seed = int32_t(atoi(value));
+			bHaveSeed = true;
+		}
+		else if (!strcmp(arg, "--name"))
+			config.m_serverName = value;
+		else if (!strcmp(arg, "--port"))
+			config.m_port = atoi(value);
+		else if (!strcmp(arg, "--max-players"))
+			config.m_maxPlayers = atoi(value);
+		else if (!strcmp(arg, "--autosave"))
+			config.m_autosaveTicks = atoi(value) * config.m_ticksPerSecond;
+		else
+			return false;
+	}
+
+	if (!bHaveSeed)
+		config.m_seed = int32_t(getEpochTimeS());
+
+	return config.m_port > 0 && config.m_maxPlayers > 0 && config.m_autosaveTicks >= 0;
+}
+
+int main(int argc, char* argv[])
+{
+	Logger::setSingleton(new Logger);
+
+	DedicatedServerConfig config;
+	if (!parseArgs(argc, argv, config))
+	{
+		printUsage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	// What NinecraftApp::init sets up, minus the graphics and sound
+	Mth::initMth();
+	Material::initMaterials();
+	EntityTypeDescriptor::initDescriptors();
+	MobCategory::initMobCategories();
+	Tile::initTiles();
+	Item::initItems();
+	ToolConfig::initializeToolEfficiency();
+	Biome::initBiomes();
+
+	DedicatedServer* pServer = new DedicatedServer(config);
+	if (!pServer->start())
+	{
+		delete pServer;
+		return EXIT_FAILURE;
+	}
+
+	g_pServer = pServer;
+	signal(SIGINT, handleSignal);
+	signal(SIGTERM, handleSignal);
+
+	pServer->run();
+
+	g_pServer = nullptr;
+	delete pServer;
+
+	return EXIT_SUCCESS;
+}
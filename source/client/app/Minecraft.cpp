@@ -414,7 +414,8 @@ void Minecraft::handleBuildAction(const BuildActionIntention& action)
 						hitSide = Facing::DOWN;
 					}
 
-					m_pRakNetInstance->send(new PlaceBlockPacket(player->m_EntityID, tp.relative(hitSide, 1), TileID(pItem->m_itemID), hitSide, pItem->getAuxValue()));
+					PlaceBlockPacket packet(player->m_EntityID, tp.relative(hitSide, 1), TileID(pItem->m_itemID), hitSide, pItem->getAuxValue());
+					m_pRakNetInstance->send(packet);
 				}
 			}
 		}
@@ -801,6 +802,9 @@ void Minecraft::update()
 	if (m_pRakNetInstance)
 	{
 		m_pRakNetInstance->runEvents(m_pNetEventCallback);
+
+		if (m_pNetEventCallback)
+			m_pNetEventCallback->tick();
 	}
 
 	for (int i = 0; i < m_timer.m_ticks; i++)
@@ -898,6 +902,13 @@ void Minecraft::prepareLevel(const std::string& unused)
 	{
 		pLevel->setUpdateLights(0);
 	}
+	else
+	{
+		// Nothing is saved yet, so build the terrain of the whole world first,
+		// on a thread per core. The loop below still post-processes and lights
+		// every chunk in the same order, so the world comes out the same.
+		pLevel->getChunkSource()->prepareChunks(ChunkPos(0, 0), ChunkPos(C_MAX_CHUNKS_X - 1, C_MAX_CHUNKS_Z - 1));
+	}
 
 	for (int i = 8, i2 = 0; i != 8 + C_MAX_CHUNKS_X * 16; i += 16)
 	{
@@ -1282,6 +1293,36 @@ void Minecraft::hostMultiplayer()
 #endif
 }
 
+Player* Minecraft::getHostPlayer()
+{
+	return m_pLocalPlayer;
+}
+
+std::string Minecraft::getServerName()
+{
+	return m_options->m_playerName;
+}
+
+bool Minecraft::isServerVisibleByDefault()
+{
+	return m_options->m_bServerVisibleDefault;
+}
+
+void Minecraft::displayMessage(const std::string& msg)
+{
+	m_gui.addMessage(msg);
+}
+
+void Minecraft::showDestroyEffect(const TilePos& pos)
+{
+	m_pParticleEngine->destroyEffect(pos);
+}
+
+bool Minecraft::handleCrafting(Player* pPlayer, CraftingGrid& grid)
+{
+	return m_pGameMode->handleCrafting(pPlayer, grid);
+}
+
 void Minecraft::joinMultiplayer(const PingedCompatibleServer& serverInfo)
 {
 #ifndef __EMSCRIPTEN__
@@ -16,6 +16,7 @@
 #include "client/gui/Screen.hpp"
 #include "network/RakNetInstance.hpp"
 #include "network/NetEventCallback.hpp"
+#include "network/GameCallbacks.hpp"
 #include "client/player/input/IInputHolder.hpp"
 #include "client/player/input/MouseHandler.hpp"
 #include "client/player/input/BuildActionIntention.hpp"
@@ -31,7 +32,7 @@
 
 class Screen; // in case we're included from Screen.hpp
 
-class Minecraft : public App
+class Minecraft : public App, public GameCallbacks
 {
 public:
 	Minecraft();
@@ -75,6 +76,14 @@ public:
 	virtual void sizeUpdate(int newWidth, int newHeight) override;
 	virtual int getFpsIntlCounter();
 
+	// Overridden from GameCallbacks
+	Player* getHostPlayer() override;
+	std::string getServerName() override;
+	bool isServerVisibleByDefault() override;
+	void displayMessage(const std::string& msg) override;
+	void showDestroyEffect(const TilePos& pos) override;
+	bool handleCrafting(Player* pPlayer, CraftingGrid& grid) override;
+
 	float getBestScaleForThisScreenSize(int width, int height);
 	void generateLevel(const std::string& unused, Level* pLevel);
 	void prepareLevel(const std::string& unused);
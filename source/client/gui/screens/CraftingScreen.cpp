@@ -14,7 +14,6 @@
 #include "world/item/Item.hpp"
 #include <map>
 #include <algorithm>
-#include <SDL2/SDL.h>
 #include <chrono>
 
 CraftingScreen::CraftingScreen(Player* player) 
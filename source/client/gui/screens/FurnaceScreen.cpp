@@ -252,7 +252,7 @@ void FurnaceScreen::mouseClicked(int x, int y, int type)
 
 void FurnaceScreen::keyPressed(int key)
 {
-    if (key == SDLVK_ESCAPE) {
+    if (m_pMinecraft->getOptions()->isKey(KM_MENU_CANCEL, key)) {
         m_pMinecraft->setScreen(new IngameBlockSelectionScreen());
         return;
     }
@@ -12,6 +12,7 @@
 #include "client/gui/screens/StartMenuScreen.hpp"
 #include "client/gui/screens/DisconnectionScreen.hpp"
 #include "network/packets/CraftingPacket.hpp"
+#include "network/ChunkStreamer.hpp"
 
 // This lets you make the client shut up and not log events in the debug console.
 //#define VERBOSE_CLIENT
@@ -24,6 +25,9 @@
 #define printf_ignorable(str, ...)
 #endif
 
+// the chunks this far from the spawn have to be in before the game counts as playable
+#define C_PLAYABLE_CHUNK_RADIUS (2)
+
 ClientSideNetworkHandler::ClientSideNetworkHandler(Minecraft* pMinecraft, RakNetInstance* pRakNetInstance)
 {
 	m_pMinecraft = pMinecraft;
@@ -34,6 +38,11 @@ ClientSideNetworkHandler::ClientSideNetworkHandler(Minecraft* pMinecraft, RakNet
 	m_pLevel = nullptr;
 	m_field_14 = 0;
 	m_field_24 = 0;
+	m_bServerStreamsLevel = false;
+	m_nChunksLoaded = 0;
+	m_connectTime = 0;
+	m_timeToPlayable = -1;
+	clearChunksLoaded();
 }
 
 void ClientSideNetworkHandler::levelGenerated(Level* level)
@@ -55,11 +64,15 @@ void ClientSideNetworkHandler::onConnect(const RakNet::RakNetGUID& rakGuid) // s
 	printf_ignorable("onConnect, server guid: %s, local guid: %s", rakGuid.ToString(), localGuid.ToString());
 
 	m_serverGUID = rakGuid;
+	m_connectTime = getTimeMs();
+	m_timeToPlayable = -1;
 
 	LoginPacket* pLoginPkt = new LoginPacket;
 	pLoginPkt->m_str = RakNet::RakString(m_pMinecraft->m_pUser->field_0.c_str());
 	pLoginPkt->m_clientNetworkVersion = NETWORK_PROTOCOL_VERSION;
 	pLoginPkt->m_clientNetworkVersion2 = NETWORK_PROTOCOL_VERSION;
+	pLoginPkt->m_bTakesTileBatches = true;
+	pLoginPkt->m_bTakesPackedMoves = true;
 	
 	m_pRakNetInstance->send(pLoginPkt);
 }
@@ -150,6 +163,8 @@ void ClientSideNetworkHandler::handle(const RakNet::RakNetGUID& rakGuid, StartGa
 	m_pLevel->setTime(pStartGamePkt->m_time);
 
 	m_serverProtocolVersion = pStartGamePkt->m_serverVersion;
+	m_bServerStreamsLevel = pStartGamePkt->m_bStreamsLevel;
+	m_entityMoves.clear();
 
 	m_pMinecraft->setLevel(m_pLevel, "ClientSideNetworkHandler -> setLevel", pLocalPlayer);
 }
@@ -185,6 +200,8 @@ void ClientSideNetworkHandler::handle(const RakNet::RakNetGUID& rakGuid, RemoveE
 
 	Entity* pEnt = m_pLevel->getEntity(pRemoveEntityPkt->m_id);
 
+	m_entityMoves.erase(pRemoveEntityPkt->m_id);
+
 	if (pEnt)
 		m_pLevel->removeEntity(pEnt);
 }
@@ -203,6 +220,53 @@ void ClientSideNetworkHandler::handle(const RakNet::RakNetGUID& rakGuid, MovePla
 	pEntity->lerpTo(packet->m_pos, packet->m_rot, 3);
 }
 
+void ClientSideNetworkHandler::handle(const RakNet::RakNetGUID& rakGuid, MoveEntitiesPacket* packet)
+{
+	if (!m_pLevel) return;
+
+	for (size_t i = 0; i < packet->m_moves.size(); i++)
+	{
+		const MoveEntitiesPacket::Move& move = packet->m_moves[i];
+
+		MoveEntitiesPacket::Move& state = m_entityMoves[move.m_id];
+		if (move.m_flags & MoveEntitiesPacket::MOVE_POS_DELTA)
+		{
+			for (int j = 0; j < 3; j++)
+				state.m_pos[j] += move.m_pos[j];
+		}
+		else if (move.m_flags & MoveEntitiesPacket::MOVE_POS)
+		{
+			for (int j = 0; j < 3; j++)
+				state.m_pos[j] = move.m_pos[j];
+		}
+
+		if (move.m_flags & MoveEntitiesPacket::MOVE_ROT)
+		{
+			state.m_rot[0] = move.m_rot[0];
+			state.m_rot[1] = move.m_rot[1];
+		}
+
+		Entity* pEntity = m_pLevel->getEntity(move.m_id);
+		if (!pEntity)
+			continue;
+
+		Vec3 pos(
+			MoveEntitiesPacket::unpackCoord(state.m_pos[0]),
+			MoveEntitiesPacket::unpackCoord(state.m_pos[1]),
+			MoveEntitiesPacket::unpackCoord(state.m_pos[2]));
+
+		Vec2 rot(MoveEntitiesPacket::unpackAngle(state.m_rot[0]), MoveEntitiesPacket::unpackAngle(state.m_rot[1]));
+
+		// the yaw is sent as -180 to 180, but the entity doesn't wrap it while it lerps
+		while (rot.x - pEntity->m_rot.x > 180.0f)
+			rot.x -= 360.0f;
+		while (rot.x - pEntity->m_rot.x < -180.0f)
+			rot.x += 360.0f;
+
+		pEntity->lerpTo(pos, rot, 3);
+	}
+}
+
 void ClientSideNetworkHandler::handle(const RakNet::RakNetGUID& rakGuid, PlaceBlockPacket* pPlaceBlockPkt)
 {
 	puts_ignorable("PlaceBlockPacket");
@@ -274,17 +338,83 @@ void ClientSideNetworkHandler::handle(const RakNet::RakNetGUID& rakGuid, RemoveB
 }
 
 void ClientSideNetworkHandler::handle(const RakNet::RakNetGUID& rakGuid, UpdateBlockPacket* pkt)
+{
+	_updateTile(pkt->m_pos, pkt->m_tileTypeId, pkt->m_data);
+}
+
+void ClientSideNetworkHandler::handle(const RakNet::RakNetGUID& rakGuid, UpdateBlocksPacket* pkt)
+{
+	if (!m_pLevel)
+		return;
+
+	for (size_t i = 0; i < pkt->m_changes.size(); i++)
+	{
+		const UpdateBlocksPacket::Change& change = pkt->m_changes[i];
+		_updateTile(pkt->getChangePos(change), change.m_tile, change.m_data);
+	}
+}
+
+void ClientSideNetworkHandler::_updateTile(const TilePos& pos, TileID tile, TileData data)
 {
 	if (!areAllChunksLoaded())
 	{
-		m_bufferedBlockUpdates.push_back(SBufferedBlockUpdate(pkt->m_pos, pkt->m_tileTypeId, pkt->m_data));
+		m_bufferedBlockUpdates.push_back(SBufferedBlockUpdate(pos, tile, data));
 		return;
 	}
 
-	m_pLevel->setTileAndData(pkt->m_pos, pkt->m_tileTypeId, pkt->m_data);
+	m_pLevel->setTileAndData(pos, tile, data);
 }
 
 void ClientSideNetworkHandler::handle(const RakNet::RakNetGUID& rakGuid, ChunkDataPacket* pChunkDataPkt)
+{
+	if (m_serverProtocolVersion < 2)
+	{
+		_loadChunkData(pChunkDataPkt);
+
+		if (areAllChunksLoaded())
+			flushAllBufferedUpdates();
+		else
+			requestNextChunk();
+
+		return;
+	}
+
+	// Newer servers send whole chunks inside a LevelDataPacket or CompressedChunkDataPackets.
+	// One on its own holds the sections with the tiles that changed during a tick.
+	if (!m_pLevel)
+		return;
+
+	const ChunkPos& cp = pChunkDataPkt->m_chunkPos;
+	if (cp.x < 0 || cp.z < 0 || cp.x >= C_MAX_CHUNKS_X || cp.z >= C_MAX_CHUNKS_Z)
+		return;
+
+	for (int k = 0; k < 256; k++)
+	{
+		uint8_t updMap = 0;
+		if (!pChunkDataPkt->m_data.Read(updMap))
+			return;
+
+		for (int j = 0; j < 8; j++)
+		{
+			if (!((updMap >> j) & 1))
+				continue;
+
+			TileID  tiles[16];
+			uint8_t datas[16 / 2];
+
+			if (!pChunkDataPkt->m_data.Read((char*)tiles, 16 * sizeof(TileID)) || !pChunkDataPkt->m_data.Read((char*)datas, 16 / 2))
+				return;
+
+			for (int i = 0; i < 16; i++)
+			{
+				TileData data = (i & 1) ? (datas[i >> 1] >> 4) : (datas[i >> 1] & 0xF);
+				_updateTile(TilePos(16 * cp.x + (k & 0xF), j * 16 + i, 16 * cp.z + (k >> 4)), tiles[i], data);
+			}
+		}
+	}
+}
+
+void ClientSideNetworkHandler::_loadChunkData(ChunkDataPacket* pChunkDataPkt)
 {
 	if (!m_pLevel)
 	{
@@ -361,13 +491,7 @@ void ClientSideNetworkHandler::handle(const RakNet::RakNetGUID& rakGuid, ChunkDa
 
 	pChunk->m_bUnsaved = true;
 
-	if (m_serverProtocolVersion < 2)
-	{
-		if (areAllChunksLoaded())
-			flushAllBufferedUpdates();
-		else
-			requestNextChunk();
-	}
+	_chunkLoaded(pChunkDataPkt->m_chunkPos);
 }
 
 void ClientSideNetworkHandler::handle(const RakNet::RakNetGUID& rakGuid, PlayerEquipmentPacket* pPlayerEquipmentPkt)
@@ -488,7 +612,7 @@ void ClientSideNetworkHandler::handle(const RakNet::RakNetGUID& guid, LevelDataP
 			cdp.read(&bs2);
 
 			if (pChunk)
-				handle(guid, &cdp);
+				_loadChunkData(&cdp);
 
 			// Handle lighting immediately, to ensure it doesn't get out of control.
 			while (m_pLevel->updateLights());
@@ -500,6 +624,86 @@ void ClientSideNetworkHandler::handle(const RakNet::RakNetGUID& guid, LevelDataP
 	flushAllBufferedUpdates();
 }
 
+void ClientSideNetworkHandler::handle(const RakNet::RakNetGUID& guid, CompressedChunkDataPacket* packet)
+{
+	if (!m_pLevel)
+		return;
+
+	RakNet::BitStream* bs = &packet->m_data, bs2;
+
+	if (packet->m_uncompSize)
+	{
+		uint8_t* pUncompData = ZlibInflateToMemory(packet->m_data.GetData(), packet->m_data.GetNumberOfBytesUsed(), packet->m_uncompSize);
+		if (!pUncompData)
+		{
+			LOG_E("Failed to decompress chunk data!");
+			return;
+		}
+
+		bs2.Write((const char*)pUncompData, packet->m_uncompSize);
+		SAFE_DELETE_ARRAY(pUncompData);
+		bs = &bs2;
+	}
+
+	uint8_t ptype = 0;
+	bs->Read(ptype);
+	if (ptype != PACKET_CHUNK_DATA)
+	{
+		LOG_E("Invalid compressed chunk data, packet type %d", ptype);
+		return;
+	}
+
+	ChunkDataPacket cdp(ChunkPos(0, 0), nullptr);
+	cdp.read(bs);
+
+	if (cdp.m_chunkPos.x < 0 || cdp.m_chunkPos.z < 0 || cdp.m_chunkPos.x >= C_MAX_CHUNKS_X || cdp.m_chunkPos.z >= C_MAX_CHUNKS_Z)
+	{
+		LOG_E("Chunk data for a chunk outside the level, %d, %d", cdp.m_chunkPos.x, cdp.m_chunkPos.z);
+		return;
+	}
+
+	_loadChunkData(&cdp);
+
+	// Handle lighting immediately, to ensure it doesn't get out of control.
+	while (m_pLevel->updateLights());
+
+	if (m_nChunksLoaded == C_MAX_CHUNKS_X * C_MAX_CHUNKS_Z && !areAllChunksLoaded())
+	{
+		// All chunks are loaded. Also flush all the updates we've buffered.
+		m_chunksRequested = 256;
+		flushAllBufferedUpdates();
+	}
+}
+
+void ClientSideNetworkHandler::_chunkLoaded(const ChunkPos& pos)
+{
+	int index = pos.x + pos.z * C_MAX_CHUNKS_X;
+	if (pos.x < 0 || pos.z < 0 || pos.x >= C_MAX_CHUNKS_X || pos.z >= C_MAX_CHUNKS_Z || m_bChunkLoaded[index])
+		return;
+
+	m_bChunkLoaded[index] = true;
+	m_nChunksLoaded++;
+
+	if (m_timeToPlayable >= 0)
+		return;
+
+	// playable once everything around the spawn is in
+	for (int z = m_spawnChunk.z - C_PLAYABLE_CHUNK_RADIUS; z <= m_spawnChunk.z + C_PLAYABLE_CHUNK_RADIUS; z++)
+	{
+		for (int x = m_spawnChunk.x - C_PLAYABLE_CHUNK_RADIUS; x <= m_spawnChunk.x + C_PLAYABLE_CHUNK_RADIUS; x++)
+		{
+			if (x < 0 || z < 0 || x >= C_MAX_CHUNKS_X || z >= C_MAX_CHUNKS_Z)
+				continue;
+
+			if (!m_bChunkLoaded[x + z * C_MAX_CHUNKS_X])
+				return;
+		}
+	}
+
+	m_timeToPlayable = getTimeMs() - m_connectTime;
+	LOG_I("Playable %d ms after connecting, with %d chunks loaded", m_timeToPlayable, m_nChunksLoaded);
+}
+
 bool ClientSideNetworkHandler::areAllChunksLoaded()
 {
 	return m_chunksRequested > 255;
@@ -508,12 +712,25 @@ bool ClientSideNetworkHandler::areAllChunksLoaded()
 void ClientSideNetworkHandler::arrangeRequestChunkOrder()
 {
 	clearChunksLoaded();
-	// @TODO: Implement arrangeRequestChunkOrder()
+
+	if (m_pMinecraft->m_pLocalPlayer)
+		m_spawnChunk = ChunkPos(m_pMinecraft->m_pLocalPlayer->m_pos);
+
+	for (int z = 0; z < C_MAX_CHUNKS_Z; z++)
+	{
+		for (int x = 0; x < C_MAX_CHUNKS_X; x++)
+			m_chunkOrder.push_back(ChunkPos(x, z));
+	}
+
+	ChunkStreamer::arrangeChunkOrder(m_chunkOrder, m_spawnChunk);
 }
 
 void ClientSideNetworkHandler::clearChunksLoaded()
 {
-	// @TODO: Implement clearChunksLoaded()
+	m_chunkOrder.clear();
+	memset(m_bChunkLoaded, 0, sizeof m_bChunkLoaded);
+	m_nChunksLoaded = 0;
+	m_spawnChunk = ChunkPos(C_MAX_CHUNKS_X / 2, C_MAX_CHUNKS_Z / 2);
 }
 
 void ClientSideNetworkHandler::requestNextChunk()
@@ -526,12 +743,20 @@ void ClientSideNetworkHandler::requestNextChunk()
 
 	if (m_serverProtocolVersion < 2)
 	{
-		m_pRakNetInstance->send(new RequestChunkPacket(ChunkPos(m_chunksRequested % 16, m_chunksRequested / 16)));
+		ChunkPos pos(m_chunksRequested % 16, m_chunksRequested / 16);
+		if (m_chunksRequested < int(m_chunkOrder.size()))
+			pos = m_chunkOrder[m_chunksRequested];
+
+		m_pRakNetInstance->send(new RequestChunkPacket(pos));
 		m_chunksRequested++;
 	}
+	else if (m_bServerStreamsLevel)
+	{
+		m_pRakNetInstance->send(new RequestChunkPacket(ChunkPos(C_REQUEST_LEVEL_STREAM, C_REQUEST_LEVEL_STREAM)));
+	}
 	else
 	{
-		m_pRakNetInstance->send(new RequestChunkPacket(ChunkPos(-9999, -9999)));
+		m_pRakNetInstance->send(new RequestChunkPacket(ChunkPos(C_REQUEST_LEVEL_DATA, C_REQUEST_LEVEL_DATA)));
 	}
 }
 
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <map>
 #include "network/NetEventCallback.hpp"
 #include "client/app/Minecraft.hpp"
 #include "network/RakNetInstance.hpp"
@@ -39,10 +40,13 @@ public:
 	void handle(const RakNet::RakNetGUID&, AddPlayerPacket*) override;
 	void handle(const RakNet::RakNetGUID&, RemoveEntityPacket*) override;
 	void handle(const RakNet::RakNetGUID&, MovePlayerPacket*) override;
+	void handle(const RakNet::RakNetGUID&, MoveEntitiesPacket*) override;
 	void handle(const RakNet::RakNetGUID&, PlaceBlockPacket*) override;
 	void handle(const RakNet::RakNetGUID&, RemoveBlockPacket*) override;
 	void handle(const RakNet::RakNetGUID&, UpdateBlockPacket*) override;
+	void handle(const RakNet::RakNetGUID&, UpdateBlocksPacket*) override;
 	void handle(const RakNet::RakNetGUID&, ChunkDataPacket*) override;
+	void handle(const RakNet::RakNetGUID&, CompressedChunkDataPacket*) override;
 	void handle(const RakNet::RakNetGUID&, PlayerEquipmentPacket*) override;
 	void handle(const RakNet::RakNetGUID&, LevelDataPacket*) override;
 	void handle(const RakNet::RakNetGUID&, CraftingPacket*);
@@ -53,6 +57,14 @@ public:
 	void requestNextChunk();
 	void flushAllBufferedUpdates(); // inlined
 
+	// Custom: how long it took from connecting until the chunks around the spawn were in, -1 if they aren't yet
+	int getTimeToPlayable() const { return m_timeToPlayable; }
+
+private:
+	void _loadChunkData(ChunkDataPacket* pChunkDataPkt);
+	void _chunkLoaded(const ChunkPos& pos);
+	void _updateTile(const TilePos& pos, TileID tile, TileData data);
+
 private:
 	Minecraft* m_pMinecraft;
 	Level* m_pLevel;
@@ -64,5 +76,16 @@ private:
 	std::vector<SBufferedBlockUpdate> m_bufferedBlockUpdates;
 	int m_chunksRequested;
 	int m_serverProtocolVersion;
+
+	// Custom
+	bool m_bServerStreamsLevel;
+	std::vector<ChunkPos> m_chunkOrder;
+	bool m_bChunkLoaded[C_MAX_CHUNKS_X * C_MAX_CHUNKS_Z];
+	int m_nChunksLoaded;
+	ChunkPos m_spawnChunk;
+	int m_connectTime;
+	int m_timeToPlayable;
+	// What the server last said about each entity's movement, as the deltas are relative to it
+	std::map<int, MoveEntitiesPacket::Move> m_entityMoves;
 };
 
@@ -11,6 +11,11 @@
 #include "world/level/Region.hpp"
 #include "TileRenderer.hpp"
 
+// Custom: the chunks are 16 tiles wide, the tiles are indexed as x | z << 4 | y << 8
+#define C_FACE_LINK_SIZE (16)
+#define C_FACE_LINK_VOLUME (C_FACE_LINK_SIZE * C_FACE_LINK_SIZE * C_FACE_LINK_SIZE)
+#define C_ALL_FACES (0x3F)
+
 int Chunk::updates;
 
 float Chunk::distanceToSqr(const Entity* pEnt) const
@@ -41,7 +46,7 @@ void Chunk::reset()
 
 int Chunk::getList(int idx)
 {
-	if (!m_bVisible)
+	if (!m_bVisible || m_bOccluded)
 		return -1;
 
 	if (field_1C[idx])
@@ -57,7 +62,7 @@ RenderChunk* Chunk::getRenderChunk(int idx)
 
 int Chunk::getAllLists(int* arr, int arr_idx, int idx)
 {
-	if (!m_bVisible)
+	if (!m_bVisible || m_bOccluded)
 		return arr_idx;
 
 	if (field_1C[idx])
@@ -108,6 +113,8 @@ void Chunk::setPos(const TilePos& pos)
 
 	m_aabb = AABB(m_pos - 1, m_pos + field_10 + 1);
 
+	// what was seen through it was somewhere else
+	openAllFaces();
 	setDirty();
 }
 
@@ -128,14 +135,13 @@ void Chunk::rebuild()
 
 	updates++;
 
-	LevelChunk::touchedSky = false;
-
 	field_1C[0] = true;
 	field_1C[1] = true;
 
 	TilePos min(m_pos), max(m_pos + field_10);
 
-	Region region(m_pLevel, min - 1, max + 1);
+	// same box as ChunkBuilder::queue
+	Region region(m_pLevel, min - 2, max + 1, true);
 	TileRenderer tileRenderer(&region);
 
 	Tesselator& t = Tesselator::instance;
@@ -179,7 +185,11 @@ void Chunk::rebuild()
 
 		if (bTesselatedAnything)
 		{
+#ifdef ENH_COMPACT_CHUNK_VERTICES
+			RenderChunk rchk = t.endCompact(field_90[layer]);
+#else
 			RenderChunk rchk = t.end(field_90[layer]);
+#endif
 			RenderChunk* pRChk = &m_renderChunks[layer];
 
 			*pRChk = rchk;
@@ -197,8 +207,10 @@ void Chunk::rebuild()
 			break;
 	}
 
-	field_54 = LevelChunk::touchedSky;
+	field_54 = region.hasTouchedSky();
 	field_94 = true;
+
+	computeFaceLinks(region, m_pos, m_faceLinks);
 }
 
 void Chunk::translateToPos()
@@ -206,12 +218,97 @@ void Chunk::translateToPos()
 	glTranslatef(float(m_pos.x), float(m_pos.y), float(m_pos.z));
 }
 
+void Chunk::openAllFaces()
+{
+	for (int i = 0; i < 6; i++)
+		m_faceLinks[i] = C_ALL_FACES;
+}
+
+void Chunk::computeFaceLinks(Region& region, const TilePos& min, uint8_t faceLinks[6])
+{
+	// 1 if the tile hides what's behind it, or the flood got there already
+	uint8_t closed[C_FACE_LINK_VOLUME];
+	int nOpaque = 0;
+
+	TilePos tp(min);
+	int index = 0;
+	for (tp.y = min.y; tp.y < min.y + C_FACE_LINK_SIZE; tp.y++)
+	{
+		for (tp.z = min.z; tp.z < min.z + C_FACE_LINK_SIZE; tp.z++)
+		{
+			for (tp.x = min.x; tp.x < min.x + C_FACE_LINK_SIZE; tp.x++, index++)
+			{
+				TileID tile = region.getTile(tp);
+				closed[index] = tile > 0 && Tile::tiles[tile] && Tile::tiles[tile]->isSolidRender();
+				nOpaque += closed[index];
+			}
+		}
+	}
+
+	// It takes at least a whole 16x16 wall to keep two faces apart
+	if (nOpaque < C_FACE_LINK_SIZE * C_FACE_LINK_SIZE)
+	{
+		for (int i = 0; i < 6; i++)
+			faceLinks[i] = C_ALL_FACES;
+		return;
+	}
+
+	for (int i = 0; i < 6; i++)
+		faceLinks[i] = 0;
+
+	uint16_t stack[C_FACE_LINK_VOLUME];
+	for (int start = 0; start < C_FACE_LINK_VOLUME; start++)
+	{
+		if (closed[start])
+			continue;
+
+		// every open tile is on the stack once, so it can't overflow
+		int nStack = 0;
+		stack[nStack++] = uint16_t(start);
+		closed[start] = 1;
+
+		int faces = 0;
+		while (nStack > 0)
+		{
+			int i = stack[--nStack];
+			int x = i & 15, z = (i >> 4) & 15, y = i >> 8;
+
+			if (y == 0)  faces |= 1 << Facing::DOWN;
+			if (y == 15) faces |= 1 << Facing::UP;
+			if (z == 0)  faces |= 1 << Facing::NORTH;
+			if (z == 15) faces |= 1 << Facing::SOUTH;
+			if (x == 0)  faces |= 1 << Facing::WEST;
+			if (x == 15) faces |= 1 << Facing::EAST;
+
+			if (y > 0  && !closed[i - 256]) { closed[i - 256] = 1; stack[nStack++] = uint16_t(i - 256); }
+			if (y < 15 && !closed[i + 256]) { closed[i + 256] = 1; stack[nStack++] = uint16_t(i + 256); }
+			if (z > 0  && !closed[i - 16])  { closed[i - 16]  = 1; stack[nStack++] = uint16_t(i - 16); }
+			if (z < 15 && !closed[i + 16])  { closed[i + 16]  = 1; stack[nStack++] = uint16_t(i + 16); }
+			if (x > 0  && !closed[i - 1])   { closed[i - 1]   = 1; stack[nStack++] = uint16_t(i - 1); }
+			if (x < 15 && !closed[i + 1])   { closed[i + 1]   = 1; stack[nStack++] = uint16_t(i + 1); }
+		}
+
+		for (int face = 0; face < 6; face++)
+		{
+			if (faces & (1 << face))
+				faceLinks[face] |= uint8_t(faces);
+		}
+	}
+}
+
 Chunk::Chunk(Level* level, const TilePos& pos, int a, int b, GLuint* bufs)
 {
 	field_4D = true;
 	field_4E = false;
 	field_94 = false;
 	m_bDirty = false;
+	m_rebuildId = 0;
+	m_uploadedId = 0;
+	m_bOccluded = false;
+	m_visitFrame = 0;
+	m_pPrevDirty = nullptr;
+	m_pNextDirty = nullptr;
+	m_dirtyBand = -1;
 
 	m_pLevel = level;
 	field_10 = TilePos(a, a, a);
@@ -15,6 +15,7 @@
 
 class Level;
 class Entity;
+class Region;
 
 class Chunk
 {
@@ -36,6 +37,13 @@ public:
 	bool isDirty();
 	void rebuild();
 	void translateToPos();
+	// Custom: Lets every face see every other one, until a mesh says otherwise
+	void openAllFaces();
+	bool linksFaces(int from, int to) const { return (m_faceLinks[from] >> to) & 1; }
+
+	// Custom: Floods the tiles that don't hide what's behind them, from min to min + 16.
+	// For each face, sets a bit for every face that can be seen from it through the chunk.
+	static void computeFaceLinks(Region& region, const TilePos& min, uint8_t faceLinks[6]);
 
 public:
 	static int updates;
@@ -60,5 +68,18 @@ public:
 	GLuint* field_90;
 	bool field_94;
 	bool m_bDirty;
+	// bumped each time a mesh is queued, so that a stale one isn't uploaded over a newer one
+	int m_rebuildId;
+	int m_uploadedId;
+	// Custom: indexed by Facing, the faces that can be seen from that one through this chunk
+	uint8_t m_faceLinks[6];
+	// Custom: set by LevelRenderer::cull if the camera can't see into this chunk through the ones around it
+	bool m_bOccluded;
+	// Custom: the last LevelRenderer::m_visitFrame its flood got here in
+	int m_visitFrame;
+	// Custom: the links of DirtyChunkQueue's lists, and the band it's in there, or -1 if it isn't
+	Chunk* m_pPrevDirty;
+	Chunk* m_pNextDirty;
+	int m_dirtyBand;
 };
 
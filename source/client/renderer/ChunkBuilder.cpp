@@ -0,0 +1,382 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#include "ChunkBuilder.hpp"
+#include "Chunk.hpp"
+#include "TileRenderer.hpp"
+#include "client/app/Minecraft.hpp"
+#include "world/level/Level.hpp"
+#include "world/level/Region.hpp"
+#include "world/level/levelgen/biome/BiomeSource.hpp"
+
+#define C_CHUNK_BUILDER_THREADS (2)
+#define C_CHUNK_BUILDER_IDLE_SLEEP_MS (2)
+
+ChunkBuilder::ChunkBuilder()
+{
+	m_nBuilding = 0;
+	m_nUploaded = 0;
+	m_nUploadedVertices = 0;
+	m_bStop = false;
+
+	m_pWorkers = new Worker[C_CHUNK_BUILDER_THREADS];
+	for (int i = 0; i < C_CHUNK_BUILDER_THREADS; i++)
+	{
+		Worker& worker = m_pWorkers[i];
+		worker.m_pBuilder = this;
+		// a chunk never comes close to the instance's 8 MB
+		worker.m_pTesselator = new Tesselator(0x200000);
+		worker.m_pBiomeSource = nullptr;
+		worker.m_pThread = new CThread(&ChunkBuilder::_threadRoutine, &worker);
+	}
+}
+
+ChunkBuilder::~ChunkBuilder()
+{
+	m_bStop = true;
+	for (int i = 0; i < C_CHUNK_BUILDER_THREADS; i++)
+		SAFE_DELETE(m_pWorkers[i].m_pThread);
+
+	clear();
+
+	for (int i = 0; i < C_CHUNK_BUILDER_THREADS; i++)
+	{
+		SAFE_DELETE(m_pWorkers[i].m_pTesselator);
+		SAFE_DELETE(m_pWorkers[i].m_pBiomeSource);
+	}
+
+	delete[] m_pWorkers;
+}
+
+void* ChunkBuilder::_threadRoutine(void* ptr)
+{
+	Worker* pWorker = (Worker*)ptr;
+	ChunkBuilder* pThis = pWorker->m_pBuilder;
+
+	while (!pThis->m_bStop)
+	{
+		pThis->m_lock.lock();
+
+		if (pThis->m_queued.empty())
+		{
+			pThis->m_lock.unlock();
+			CThread::sleep(C_CHUNK_BUILDER_IDLE_SLEEP_MS);
+			continue;
+		}
+
+		ChunkMesh* pMesh = pThis->m_queued.front();
+		pThis->m_queued.pop_front();
+		pThis->m_nBuilding++;
+
+		pThis->m_lock.unlock();
+
+		pThis->_build(pWorker, pMesh);
+
+		pThis->m_lock.lock();
+		pThis->m_finished.push_back(pMesh);
+		pThis->m_nBuilding--;
+		pThis->m_lock.unlock();
+	}
+
+	return nullptr;
+}
+
+bool ChunkBuilder::_isDeferred(int renderShape)
+{
+	switch (renderShape)
+	{
+		case SHAPE_CACTUS:
+		case SHAPE_STAIRS:
+		case SHAPE_FENCE:
+		case SHAPE_DOOR:
+			return true;
+	}
+
+	return false;
+}
+
+void ChunkBuilder::_build(Worker* pWorker, ChunkMesh* pMesh)
+{
+	Region* pRegion = pMesh->m_pRegion;
+	pRegion->setBiomeSource(pWorker->m_pBiomeSource);
+
+	TileRenderer tileRenderer(pRegion, pWorker->m_pTesselator);
+	Tesselator& t = *pWorker->m_pTesselator;
+
+	TilePos min(pMesh->m_pos), max(pMesh->m_pos + pMesh->m_pChunk->field_10);
+
+	TilePos tp(min);
+	for (int layer = 0; layer < 2; layer++)
+	{
+		bool bTesselatedAnything = false, bDrewThisLayer = false, bNeedAnotherLayer = false;
+		for (tp.y = min.y; tp.y < max.y; tp.y++)
+		{
+			for (tp.z = min.z; tp.z < max.z; tp.z++)
+			{
+				for (tp.x = min.x; tp.x < max.x; tp.x++)
+				{
+					TileID tile = pRegion->getTile(tp);
+					if (tile <= 0) continue;
+
+					if (!bTesselatedAnything)
+					{
+						bTesselatedAnything = true;
+						t.begin();
+						t.offset(float(-min.x), float(-min.y), float(-min.z));
+					}
+
+					Tile* pTile = Tile::tiles[tile];
+
+					if (layer != pTile->getRenderLayer())
+					{
+						bNeedAnotherLayer = true;
+						continue;
+					}
+
+					if (_isDeferred(pTile->getRenderShape()))
+						pMesh->m_deferredTiles[layer].push_back(tp);
+					else if (tileRenderer.tesselateInWorld(pTile, tp))
+						bDrewThisLayer = true;
+				}
+			}
+		}
+
+		if (bTesselatedAnything)
+		{
+			t.end(pMesh->m_vertices[layer]);
+			t.offset(0.0f, 0.0f, 0.0f);
+
+			pMesh->m_bTesselated[layer] = true;
+			pMesh->m_bDrew[layer] = bDrewThisLayer;
+		}
+
+		if (!bNeedAnotherLayer)
+			break;
+	}
+
+	pMesh->m_bTouchedSky = pRegion->hasTouchedSky();
+	pMesh->m_stats = tileRenderer.getStats();
+
+	Chunk::computeFaceLinks(*pRegion, min, pMesh->m_faceLinks);
+
+	// the copied tiles aren't needed anymore
+	SAFE_DELETE(pMesh->m_pRegion);
+}
+
+bool ChunkBuilder::_upload(ChunkMesh* pMesh)
+{
+	Chunk* pChunk = pMesh->m_pChunk;
+
+	// something newer is up already, or the chunk got moved elsewhere
+	if (pMesh->m_rebuildId <= pChunk->m_uploadedId || pMesh->m_pos != pChunk->m_pos)
+		return false;
+
+	Chunk::updates++;
+	LevelChunk::touchedSky = false;
+
+	pChunk->field_1C[0] = true;
+	pChunk->field_1C[1] = true;
+
+	TilePos min(pMesh->m_pos), max(pMesh->m_pos + pChunk->field_10);
+
+	// the deferred tiles are tesselated from the live level
+	Region* pRegion = nullptr;
+	TileRenderer* pTileRenderer = nullptr;
+
+	Tesselator& t = Tesselator::instance;
+
+	for (int layer = 0; layer < 2; layer++)
+	{
+		if (!pMesh->m_bTesselated[layer])
+			continue;
+
+		bool bDrewThisLayer = pMesh->m_bDrew[layer];
+
+		if (Minecraft::useAmbientOcclusion)
+			glShadeModel(GL_SMOOTH);
+
+		t.begin();
+		t.offset(float(-min.x), float(-min.y), float(-min.z));
+
+		std::vector<Tesselator::Vertex>& vertices = pMesh->m_vertices[layer];
+		if (!vertices.empty())
+			t.addVertices(&vertices[0], int(vertices.size()));
+
+		std::vector<TilePos>& deferredTiles = pMesh->m_deferredTiles[layer];
+		for (size_t i = 0; i < deferredTiles.size(); i++)
+		{
+			if (!pRegion)
+			{
+				pRegion = new Region(pChunk->m_pLevel, min - 1, max + 1);
+				pTileRenderer = new TileRenderer(pRegion);
+			}
+
+			// it may be something else by now, a newer mesh will come for that
+			TileID tile = pRegion->getTile(deferredTiles[i]);
+			if (tile <= 0)
+				continue;
+
+			Tile* pTile = Tile::tiles[tile];
+			if (layer != pTile->getRenderLayer())
+				continue;
+
+			if (pTileRenderer->tesselateInWorld(pTile, deferredTiles[i]))
+				bDrewThisLayer = true;
+		}
+
+#ifdef ENH_COMPACT_CHUNK_VERTICES
+		RenderChunk rchk = t.endCompact(pChunk->field_90[layer]);
+#else
+		RenderChunk rchk = t.end(pChunk->field_90[layer]);
+#endif
+		m_nUploadedVertices += rchk.field_4;
+		RenderChunk* pRChk = &pChunk->m_renderChunks[layer];
+
+		*pRChk = rchk;
+		pRChk->field_C  = float(min.x);
+		pRChk->field_10 = float(min.y);
+		pRChk->field_14 = float(min.z);
+
+		t.offset(0.0f, 0.0f, 0.0f);
+
+		if (bDrewThisLayer)
+			pChunk->field_1C[layer] = false;
+	}
+
+	SAFE_DELETE(pTileRenderer);
+	SAFE_DELETE(pRegion);
+
+	pChunk->field_54 = pMesh->m_bTouchedSky || LevelChunk::touchedSky;
+	pChunk->field_94 = true;
+	pChunk->m_uploadedId = pMesh->m_rebuildId;
+
+	for (int i = 0; i < 6; i++)
+		pChunk->m_faceLinks[i] = pMesh->m_faceLinks[i];
+
+	m_stats.add(pMesh->m_stats);
+	return true;
+}
+
+void ChunkBuilder::_deleteMesh(ChunkMesh* pMesh)
+{
+	SAFE_DELETE(pMesh->m_pRegion);
+	delete pMesh;
+}
+
+void ChunkBuilder::setLevel(Level* pLevel)
+{
+	clear();
+
+	// no worker is building anything, so their biome sources can be swapped out
+	for (int i = 0; i < C_CHUNK_BUILDER_THREADS; i++)
+	{
+		SAFE_DELETE(m_pWorkers[i].m_pBiomeSource);
+		if (pLevel)
+			m_pWorkers[i].m_pBiomeSource = new BiomeSource(pLevel);
+	}
+}
+
+void ChunkBuilder::queue(Chunk* pChunk)
+{
+	pChunk->m_rebuildId++;
+
+	ChunkMesh* pMesh = new ChunkMesh;
+	pMesh->m_pChunk = pChunk;
+	pMesh->m_rebuildId = pChunk->m_rebuildId;
+	pMesh->m_pos = pChunk->m_pos;
+	// Tiles look one tile out of the chunk. Slabs and farmland take the light
+	// of their neighbours, so the ones out there look one tile further.
+	pMesh->m_pRegion = new Region(pChunk->m_pLevel, pChunk->m_pos - 2, pChunk->m_pos + pChunk->field_10 + 1, true);
+	pMesh->m_bTesselated[0] = pMesh->m_bTesselated[1] = false;
+	pMesh->m_bDrew[0] = pMesh->m_bDrew[1] = false;
+	pMesh->m_bTouchedSky = false;
+
+	m_lock.lock();
+
+	bool bReplaced = false;
+	for (std::deque<ChunkMesh*>::iterator it = m_queued.begin(); it != m_queued.end(); ++it)
+	{
+		if ((*it)->m_pChunk != pChunk)
+			continue;
+
+		_deleteMesh(*it);
+		*it = pMesh;
+		bReplaced = true;
+		break;
+	}
+
+	if (!bReplaced)
+		m_queued.push_back(pMesh);
+
+	m_lock.unlock();
+}
+
+int ChunkBuilder::uploadFinished(double maxTimeMs)
+{
+	double startTime = getTimeS();
+
+	int nUploaded = 0;
+	for (int n = 0; n == 0 || (getTimeS() - startTime) * 1000.0 < maxTimeMs; n++)
+	{
+		m_lock.lock();
+
+		if (m_finished.empty())
+		{
+			m_lock.unlock();
+			break;
+		}
+
+		ChunkMesh* pMesh = m_finished.front();
+		m_finished.pop_front();
+
+		m_lock.unlock();
+
+		if (_upload(pMesh))
+			nUploaded++;
+
+		_deleteMesh(pMesh);
+	}
+
+	m_nUploaded += nUploaded;
+	return nUploaded;
+}
+
+void ChunkBuilder::clear()
+{
+	m_lock.lock();
+	for (std::deque<ChunkMesh*>::iterator it = m_queued.begin(); it != m_queued.end(); ++it)
+		_deleteMesh(*it);
+	m_queued.clear();
+	m_lock.unlock();
+
+	// nothing new gets picked up, so this only has to wait for what's in flight
+	while (getBuildingCount() > 0)
+		CThread::sleep(1);
+
+	m_lock.lock();
+	for (std::deque<ChunkMesh*>::iterator it = m_finished.begin(); it != m_finished.end(); ++it)
+		_deleteMesh(*it);
+	m_finished.clear();
+	m_lock.unlock();
+}
+
+int ChunkBuilder::getQueuedCount()
+{
+	m_lock.lock();
+	int count = int(m_queued.size());
+	m_lock.unlock();
+	return count;
+}
+
+int ChunkBuilder::getBuildingCount()
+{
+	m_lock.lock();
+	int count = m_nBuilding;
+	m_lock.unlock();
+	return count;
+}
@@ -0,0 +1,97 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <stdint.h>
+#include "common/CThread.hpp"
+#include "world/level/TilePos.hpp"
+#include "Tesselator.hpp"
+#include "TileRenderer.hpp"
+
+class Chunk;
+class Level;
+class Region;
+class BiomeSource;
+
+// ChunkBuilder - Builds chunk meshes on worker threads.
+//
+// When a chunk is queued, the tiles and light around it are copied into a
+// Region snapshot. A worker tesselates that into its own Tesselator, and the
+// render thread then only has to upload the vertices into the chunk's
+// buffers. Stairs, fences, doors and cacti change the shape of their (shared)
+// tile while they're tesselated, so those are left for the render thread to
+// add during the upload.
+
+struct ChunkMesh
+{
+	Chunk* m_pChunk;
+	int m_rebuildId;
+	TilePos m_pos;
+	Region* m_pRegion;
+	std::vector<Tesselator::Vertex> m_vertices[2];
+	std::vector<TilePos> m_deferredTiles[2];
+	bool m_bTesselated[2];
+	bool m_bDrew[2];
+	bool m_bTouchedSky;
+	// Custom: see Chunk::computeFaceLinks
+	uint8_t m_faceLinks[6];
+	TileRendererStats m_stats;
+};
+
+class ChunkBuilder
+{
+public:
+	ChunkBuilder();
+	~ChunkBuilder();
+
+	// Drops every job, and sets the level the workers look biomes up in
+	void setLevel(Level* pLevel);
+	// Snapshots the chunk and queues it. Replaces a job for the same chunk that hasn't started yet.
+	void queue(Chunk* pChunk);
+	// Uploads finished meshes for up to maxTimeMs, and at least one. Returns how many were uploaded, stale ones are dropped.
+	int uploadFinished(double maxTimeMs);
+	// Drops every job. Waits for the ones that are being built.
+	void clear();
+
+	int getQueuedCount();
+	int getBuildingCount();
+	int getUploadedCount() const { return m_nUploaded; }
+	int64_t getUploadedVertexCount() const { return m_nUploadedVertices; }
+	// What the tile renderers did for the uploaded meshes
+	const TileRendererStats& getStats() const { return m_stats; }
+
+private:
+	struct Worker
+	{
+		ChunkBuilder* m_pBuilder;
+		Tesselator* m_pTesselator;
+		BiomeSource* m_pBiomeSource;
+		CThread* m_pThread;
+	};
+
+	static void* _threadRoutine(void* ptr);
+	static bool _isDeferred(int renderShape);
+	void _build(Worker* pWorker, ChunkMesh* pMesh);
+	bool _upload(ChunkMesh* pMesh);
+	void _deleteMesh(ChunkMesh* pMesh);
+
+private:
+	Worker* m_pWorkers;
+	// Guards m_queued, m_finished and m_nBuilding
+	CMutex m_lock;
+	std::deque<ChunkMesh*> m_queued;
+	std::deque<ChunkMesh*> m_finished;
+	int m_nBuilding;
+	int m_nUploaded;
+	int64_t m_nUploadedVertices;
+	TileRendererStats m_stats;
+	volatile bool m_bStop;
+};
@@ -8,6 +8,49 @@
 
 #include "Culler.hpp"
 
+AABBArray::AABBArray()
+{
+	m_count = 0;
+}
+
+void AABBArray::resize(int count)
+{
+	m_count = count;
+	m_minX.resize(count);
+	m_minY.resize(count);
+	m_minZ.resize(count);
+	m_maxX.resize(count);
+	m_maxY.resize(count);
+	m_maxZ.resize(count);
+}
+
+void AABBArray::set(int index, const AABB& aabb)
+{
+	m_minX[index] = aabb.min.x;
+	m_minY[index] = aabb.min.y;
+	m_minZ[index] = aabb.min.z;
+	m_maxX[index] = aabb.max.x;
+	m_maxY[index] = aabb.max.y;
+	m_maxZ[index] = aabb.max.z;
+}
+
+AABB AABBArray::get(int index) const
+{
+	return AABB(m_minX[index], m_minY[index], m_minZ[index], m_maxX[index], m_maxY[index], m_maxZ[index]);
+}
+
+void Culler::areVisible(const AABBArray& boxes, uint32_t* visible)
+{
+	for (int i = 0; i < (boxes.size() + 31) / 32; i++)
+		visible[i] = 0;
+
+	for (int i = 0; i < boxes.size(); i++)
+	{
+		if (isVisible(boxes.get(i)))
+			visible[i >> 5] |= 1U << (i & 31);
+	}
+}
+
 void Culler::prepare(float x, float y, float z)
 {
 }
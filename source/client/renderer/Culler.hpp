@@ -8,13 +8,36 @@
 
 #pragma once
 
+#include <vector>
+#include <stdint.h>
 #include "world/phys/AABB.hpp"
 
+// Custom: Boxes kept as a structure of arrays, so that a culler can test several of them at once
+class AABBArray
+{
+public:
+	AABBArray();
+
+	void resize(int count);
+	void set(int index, const AABB& aabb);
+	AABB get(int index) const;
+	int size() const { return m_count; }
+
+public:
+	std::vector<float> m_minX, m_minY, m_minZ;
+	std::vector<float> m_maxX, m_maxY, m_maxZ;
+
+private:
+	int m_count;
+};
+
 class Culler
 {
 public:
 	virtual ~Culler();
 	virtual bool isVisible(const AABB&) = 0;
+	// Custom: Sets bit (i & 31) of visible[i >> 5] if box i is visible, and clears it if not
+	virtual void areVisible(const AABBArray& boxes, uint32_t* visible);
 	virtual bool cubeInFrustum(float, float, float, float, float, float) = 0;
 	virtual bool cubeFullyInFrustum(float, float, float, float, float, float) = 0;
 	virtual void prepare(float, float, float);
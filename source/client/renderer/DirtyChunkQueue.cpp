@@ -0,0 +1,164 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#include "DirtyChunkQueue.hpp"
+#include "Chunk.hpp"
+
+DirtyChunkQueue::DirtyChunkQueue()
+{
+	for (int i = 0; i < C_DIRTY_CHUNK_BANDS; i++)
+	{
+		m_pFirst[i] = nullptr;
+		m_pLast[i] = nullptr;
+	}
+
+	m_size = 0;
+}
+
+void DirtyChunkQueue::add(Chunk* pChunk)
+{
+	if (pChunk->m_dirtyBand >= 0)
+		return;
+
+	pChunk->m_dirtyBand = _getBand(pChunk);
+	_link(pChunk);
+	m_size++;
+}
+
+void DirtyChunkQueue::remove(Chunk* pChunk)
+{
+	if (pChunk->m_dirtyBand < 0)
+		return;
+
+	_unlink(pChunk);
+	pChunk->m_dirtyBand = -1;
+	m_size--;
+}
+
+void DirtyChunkQueue::clear()
+{
+	for (int i = 0; i < C_DIRTY_CHUNK_BANDS; i++)
+	{
+		Chunk* pChunk = m_pFirst[i];
+		while (pChunk)
+		{
+			Chunk* pNext = pChunk->m_pNextDirty;
+			pChunk->m_pPrevDirty = nullptr;
+			pChunk->m_pNextDirty = nullptr;
+			pChunk->m_dirtyBand = -1;
+			pChunk = pNext;
+		}
+
+		m_pFirst[i] = nullptr;
+		m_pLast[i] = nullptr;
+	}
+
+	m_size = 0;
+}
+
+void DirtyChunkQueue::setOrigin(const Vec3& pos)
+{
+	m_origin = pos;
+
+	Chunk* pFirst[C_DIRTY_CHUNK_BANDS];
+	for (int i = 0; i < C_DIRTY_CHUNK_BANDS; i++)
+	{
+		pFirst[i] = m_pFirst[i];
+		m_pFirst[i] = nullptr;
+		m_pLast[i] = nullptr;
+	}
+
+	// the nearer bands go first, so the order within a band mostly stays the same
+	for (int i = 0; i < C_DIRTY_CHUNK_BANDS; i++)
+	{
+		Chunk* pChunk = pFirst[i];
+		while (pChunk)
+		{
+			Chunk* pNext = pChunk->m_pNextDirty;
+			pChunk->m_dirtyBand = _getBand(pChunk);
+			_link(pChunk);
+			pChunk = pNext;
+		}
+	}
+}
+
+Chunk* DirtyChunkQueue::getNearest() const
+{
+	for (int i = 0; i < C_DIRTY_CHUNK_BANDS; i++)
+	{
+		if (m_pFirst[i])
+			return m_pFirst[i];
+	}
+
+	return nullptr;
+}
+
+Chunk* DirtyChunkQueue::getNext(const Chunk* pChunk) const
+{
+	if (pChunk->m_pNextDirty)
+		return pChunk->m_pNextDirty;
+
+	for (int i = pChunk->m_dirtyBand + 1; i < C_DIRTY_CHUNK_BANDS; i++)
+	{
+		if (m_pFirst[i])
+			return m_pFirst[i];
+	}
+
+	return nullptr;
+}
+
+int DirtyChunkQueue::getBand(float distSqr) const
+{
+	float band = distSqr / C_DIRTY_CHUNK_BAND_SIZE;
+	if (band >= float(C_DIRTY_CHUNK_BANDS - 1))
+		return C_DIRTY_CHUNK_BANDS - 1;
+
+	return int(band);
+}
+
+int DirtyChunkQueue::_getBand(const Chunk* pChunk) const
+{
+	float dX = float(pChunk->m_pos2.x) - m_origin.x;
+	float dY = float(pChunk->m_pos2.y) - m_origin.y;
+	float dZ = float(pChunk->m_pos2.z) - m_origin.z;
+
+	return getBand(dX * dX + dY * dY + dZ * dZ);
+}
+
+void DirtyChunkQueue::_link(Chunk* pChunk)
+{
+	int band = pChunk->m_dirtyBand;
+
+	pChunk->m_pPrevDirty = m_pLast[band];
+	pChunk->m_pNextDirty = nullptr;
+
+	if (m_pLast[band])
+		m_pLast[band]->m_pNextDirty = pChunk;
+	else
+		m_pFirst[band] = pChunk;
+
+	m_pLast[band] = pChunk;
+}
+
+void DirtyChunkQueue::_unlink(Chunk* pChunk)
+{
+	int band = pChunk->m_dirtyBand;
+
+	if (pChunk->m_pPrevDirty)
+		pChunk->m_pPrevDirty->m_pNextDirty = pChunk->m_pNextDirty;
+	else
+		m_pFirst[band] = pChunk->m_pNextDirty;
+
+	if (pChunk->m_pNextDirty)
+		pChunk->m_pNextDirty->m_pPrevDirty = pChunk->m_pPrevDirty;
+	else
+		m_pLast[band] = pChunk->m_pPrevDirty;
+
+	pChunk->m_pPrevDirty = nullptr;
+	pChunk->m_pNextDirty = nullptr;
+}
@@ -0,0 +1,58 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#pragma once
+
+#include "world/phys/Vec3.hpp"
+
+class Chunk;
+
+// Custom: The chunks that need a new mesh, the ones nearest to the camera first.
+//
+// Each chunk is kept in the bucket of the band its squared distance to the
+// camera falls into, and the buckets are lists that run through the chunks
+// themselves. So adding a chunk, taking one out and finding the nearest one
+// don't depend on how many there are, and nothing is allocated. The chunks of
+// a band come out in the order they were added. The bands are worked out
+// again whenever the camera moves.
+#define C_DIRTY_CHUNK_BANDS (64)
+#define C_DIRTY_CHUNK_BAND_SIZE (256.0f) // the squared distance a band covers, the last one has everything past it
+
+class DirtyChunkQueue
+{
+public:
+	DirtyChunkQueue();
+
+	// Does nothing if the chunk is in the queue already
+	void add(Chunk* pChunk);
+	void remove(Chunk* pChunk);
+	// Takes every chunk out
+	void clear();
+	// Sorts the chunks into bands around the camera's new position
+	void setOrigin(const Vec3& pos);
+
+	// The nearest chunk, or null if there are none
+	Chunk* getNearest() const;
+	// The chunk that comes after this one, or null if it's the last
+	Chunk* getNext(const Chunk* pChunk) const;
+	// The band a chunk this far from the camera's last position goes in
+	int getBand(float distSqr) const;
+	int size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+
+private:
+	int _getBand(const Chunk* pChunk) const;
+	void _link(Chunk* pChunk);
+	void _unlink(Chunk* pChunk);
+
+private:
+	Chunk* m_pFirst[C_DIRTY_CHUNK_BANDS];
+	Chunk* m_pLast[C_DIRTY_CHUNK_BANDS];
+	Vec3 m_origin;
+	int m_size;
+};
@@ -8,6 +8,7 @@
 
 #include "DynamicTexture.hpp"
 #include "common/Utils.hpp"
+#include <cstring>
 
 DynamicTexture::DynamicTexture(int a2) : m_textureIndex(a2)
 {
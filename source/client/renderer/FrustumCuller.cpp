@@ -6,7 +6,9 @@
 	SPDX-License-Identifier: BSD-1-Clause
  ********************************************************************/
 
+#include <algorithm>
 #include "FrustumCuller.hpp"
+#include "common/SIMD.hpp"
 
 bool FrustumCuller::cubeFullyInFrustum(float minX, float minY, float minZ, float maxX, float maxY, float maxZ)
 {
@@ -37,6 +39,76 @@ bool FrustumCuller::isVisible(const AABB& aabb)
 	return cubeInFrustum(aabb.min.x, aabb.min.y, aabb.min.z, aabb.max.x, aabb.max.y, aabb.max.z);
 }
 
+// Custom: Same test as FrustumData::cubeInFrustum, which checks whether all eight
+// corners of a box are behind one of the planes. The corner that's the furthest
+// in front of a plane is the one with the larger product on every axis, and
+// since rounding never reverses an order, picking it gives the exact same
+// result as trying all eight.
+bool FrustumCuller::_isBoxVisible(const AABBArray& boxes, int index) const
+{
+	float x1 = boxes.m_minX[index] - m_camPos.x, x2 = boxes.m_maxX[index] - m_camPos.x;
+	float y1 = boxes.m_minY[index] - m_camPos.y, y2 = boxes.m_maxY[index] - m_camPos.y;
+	float z1 = boxes.m_minZ[index] - m_camPos.z, z2 = boxes.m_maxZ[index] - m_camPos.z;
+
+	for (int i = 0; i < 6; i++)
+	{
+		const float* plane = m_frustumData.x.m[i].c;
+		float dist = std::max(plane[0] * x1, plane[0] * x2) + std::max(plane[1] * y1, plane[1] * y2) + std::max(plane[2] * z1, plane[2] * z2) + plane[3];
+		if (dist <= 0.0f)
+			return false;
+	}
+
+	return true;
+}
+
+void FrustumCuller::areVisible(const AABBArray& boxes, uint32_t* visible)
+{
+	int count = boxes.size();
+	for (int i = 0; i < (count + 31) / 32; i++)
+		visible[i] = 0;
+
+	int index = 0;
+
+#ifdef USE_SIMD
+	SimdFloat planes[6][4];
+	for (int i = 0; i < 6; i++)
+	{
+		for (int j = 0; j < 4; j++)
+			planes[i][j] = Simd::set(m_frustumData.x.m[i].c[j]);
+	}
+
+	SimdFloat camX = Simd::set(m_camPos.x), camY = Simd::set(m_camPos.y), camZ = Simd::set(m_camPos.z);
+	SimdFloat zero = Simd::set(0.0f);
+
+	// four boxes at a time, in the lanes
+	for (; index + 4 <= count; index += 4)
+	{
+		SimdFloat x1 = Simd::sub(Simd::load(&boxes.m_minX[index]), camX), x2 = Simd::sub(Simd::load(&boxes.m_maxX[index]), camX);
+		SimdFloat y1 = Simd::sub(Simd::load(&boxes.m_minY[index]), camY), y2 = Simd::sub(Simd::load(&boxes.m_maxY[index]), camY);
+		SimdFloat z1 = Simd::sub(Simd::load(&boxes.m_minZ[index]), camZ), z2 = Simd::sub(Simd::load(&boxes.m_maxZ[index]), camZ);
+
+		SimdInt outside = Simd::set(0);
+		for (int i = 0; i < 6; i++)
+		{
+			SimdFloat dist = Simd::max(Simd::mul(planes[i][0], x1), Simd::mul(planes[i][0], x2));
+			dist = Simd::add(dist, Simd::max(Simd::mul(planes[i][1], y1), Simd::mul(planes[i][1], y2)));
+			dist = Simd::add(dist, Simd::max(Simd::mul(planes[i][2], z1), Simd::mul(planes[i][2], z2)));
+			dist = Simd::add(dist, planes[i][3]);
+			outside = Simd::ori(outside, Simd::cmple(dist, zero));
+		}
+
+		// index is a multiple of 4, so the four bits don't straddle two words
+		visible[index >> 5] |= uint32_t(~Simd::bits(outside) & 0xF) << (index & 31);
+	}
+#endif
+
+	for (; index < count; index++)
+	{
+		if (_isBoxVisible(boxes, index))
+			visible[index >> 5] |= 1U << (index & 31);
+	}
+}
+
 void FrustumCuller::prepare(float x, float y, float z)
 {
 	m_camPos = Vec3(x, y, z);
@@ -18,8 +18,12 @@ public:
 	bool cubeFullyInFrustum(float, float, float, float, float, float);
 	bool cubeInFrustum(float, float, float, float, float, float);
 	bool isVisible(const AABB&);
+	void areVisible(const AABBArray& boxes, uint32_t* visible) override;
 	void prepare(float x, float y, float z);
 
+private:
+	bool _isBoxVisible(const AABBArray& boxes, int index) const;
+
 public:
 	FrustumData m_frustumData;
 	Vec3 m_camPos;
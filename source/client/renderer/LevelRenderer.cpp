@@ -14,6 +14,17 @@
 #include "world/tile/LeafTile.hpp"
 #include "world/tile/GrassTile.hpp"
 
+// time the dirty chunks may take per frame, and how much of it uploading the finished meshes may take
+#define C_CHUNK_UPDATE_BUDGET_MS (4.0)
+#define C_CHUNK_UPLOAD_BUDGET_MS (3.0)
+#define C_MAX_QUEUED_CHUNK_MESHES (32)
+// chunks nearer than this are always queued, whatever the budget says
+#define C_NEAR_CHUNK_DIST (32.0f)
+#define C_NEAR_CHUNK_DIST_SQR (C_NEAR_CHUNK_DIST * C_NEAR_CHUNK_DIST)
+// how far the camera can be from where the dirty chunks were last sorted around: it moves up to
+// 4 blocks before they're sorted again, and they're sorted around the tile it's in
+#define C_DIRTY_ORIGIN_SLACK (6.0f)
+
 bool LevelRenderer::_areCloudsAvailable = false; // false because 0.1 didn't have them
 bool LevelRenderer::_arePlanetsAvailable = false; // false because 0.1 didn't have them
 
@@ -45,12 +56,14 @@ LevelRenderer::LevelRenderer(Minecraft* pMC, Textures* pTexs)
 	field_98 = nullptr;
 	m_chunksLength = 0;
 	m_pTileRenderer = nullptr;
+	m_pChunkBuilder = new ChunkBuilder;
 	field_A4 = 0;
 	field_A8 = 0;
 	field_AC = 0;
 	field_B0 = 0;
 	field_B8 = false;
 	field_BC = -1;
+	m_visitFrame = 0;
 	m_ticksSinceStart = 0;
 	m_nBuffers = 26136;
 
@@ -69,6 +82,11 @@ LevelRenderer::LevelRenderer(Minecraft* pMC, Textures* pTexs)
 	generateSky(); // inlined in the 0.1.0 demo
 }
 
+LevelRenderer::~LevelRenderer()
+{
+	SAFE_DELETE(m_pChunkBuilder);
+}
+
 void LevelRenderer::generateSky()
 {
 	int s = 128;
@@ -171,6 +189,10 @@ void LevelRenderer::generateStars()
 
 void LevelRenderer::deleteChunks()
 {
+	// the workers may still be holding on to them
+	m_pChunkBuilder->clear();
+	m_dirtyChunks.clear();
+
 	for (int i = 0; i < field_AC; i++)
 	{
 		for (int j = 0; j < field_A8; j++)
@@ -194,20 +216,122 @@ void LevelRenderer::deleteChunks()
 
 void LevelRenderer::cull(Culler* pCuller, float f)
 {
+	if (m_chunksLength <= 0)
+		return;
+
+	// Custom: every box is tested in one go, so they're all tested each frame
+	pCuller->areVisible(m_chunkBoxes, &m_chunkVisibility[0]);
+
 	for (int i = 0; i < m_chunksLength; i++)
 	{
 		Chunk* pChunk = m_chunks[i];
 		if (pChunk->isEmpty())
 			continue;
 
-		//@TODO: What does the shift do? (x % 4 == 0)?
-		if (!pChunk->m_bVisible || !((i + field_30) << 28))
-		{
-			pChunk->cull(pCuller);
-		}
+		pChunk->m_bVisible = _isInFrustum(i);
 	}
 
 	field_30++;
+
+#ifdef ENH_CULL_OCCLUDED_CHUNKS
+	Mob* pMob = m_pMinecraft->m_pMobPersp;
+	if (pMob)
+		_cullOccluded(pMob->m_posPrev + (pMob->m_pos - pMob->m_posPrev) * f);
+#endif
+}
+
+void LevelRenderer::_updateChunkBoxes()
+{
+	m_chunkBoxes.resize(m_chunksLength);
+	m_chunkVisibility.resize((m_chunksLength + 31) / 32);
+
+	for (int i = 0; i < m_chunksLength; i++)
+		m_chunkBoxes.set(i, m_chunks[i]->m_aabb);
+}
+
+int LevelRenderer::_getChunkIndex(const TilePos& pos) const
+{
+	int x = Mth::intFloorDiv(pos.x, 16) % field_A4;
+	if (x < 0)
+		x += field_A4;
+
+	int y = Mth::intFloorDiv(pos.y, 16);
+	if (y < 0 || y >= field_A8)
+		return -1;
+
+	int z = Mth::intFloorDiv(pos.z, 16) % field_AC;
+	if (z < 0)
+		z += field_AC;
+
+	// the one in that slot may be on the other side of the view distance
+	int index = x + field_A4 * (y + field_A8 * z);
+	if (m_chunks[index]->m_pos != pos)
+		return -1;
+
+	return index;
+}
+
+void LevelRenderer::_cullOccluded(const Vec3& camPos)
+{
+	// Floods out from the camera's chunk, like Java Edition 1.8 does. A chunk is
+	// only gone into through a face that the chunk it's entered from can see out
+	// of, from the face the flood came in by. The flood never turns back towards
+	// the camera, and doesn't go through chunks outside of the frustum.
+	TilePos tp(camPos);
+	int startIndex = _getChunkIndex(TilePos(tp.x & ~15, tp.y & ~15, tp.z & ~15));
+	Chunk* pStart = startIndex >= 0 ? m_chunks[startIndex] : nullptr;
+
+	for (int i = 0; i < m_chunksLength; i++)
+		m_chunks[i]->m_bOccluded = pStart != nullptr;
+
+	// above or below the chunks there are, nothing's hidden then
+	if (!pStart)
+		return;
+
+	m_visitFrame++;
+	m_chunkVisits.clear();
+
+	ChunkVisit start;
+	start.m_pChunk = pStart;
+	start.m_from = -1;
+	start.m_dirs = 0;
+	pStart->m_visitFrame = m_visitFrame;
+	m_chunkVisits.push_back(start);
+
+	for (size_t i = 0; i < m_chunkVisits.size(); i++)
+	{
+		// a copy, pushing the next ones may move it
+		ChunkVisit visit = m_chunkVisits[i];
+		Chunk* pChunk = visit.m_pChunk;
+		pChunk->m_bOccluded = false;
+
+		for (int face = 0; face < 6; face++)
+		{
+			if (visit.m_dirs & (1 << (face ^ 1)))
+				continue;
+
+			if (visit.m_from >= 0 && !pChunk->linksFaces(visit.m_from, face))
+				continue;
+
+			int nextIndex = _getChunkIndex(pChunk->m_pos.relative(Facing::Name(face), 16));
+			if (nextIndex < 0)
+				continue;
+
+			Chunk* pNext = m_chunks[nextIndex];
+			if (pNext->m_visitFrame == m_visitFrame)
+				continue;
+
+			pNext->m_visitFrame = m_visitFrame;
+			if (!_isInFrustum(nextIndex))
+				continue;
+
+			ChunkVisit next;
+			next.m_pChunk = pNext;
+			next.m_from = face ^ 1;
+			next.m_dirs = visit.m_dirs | (1 << face);
+			m_chunkVisits.push_back(next);
+		}
+	}
 }
 
 void LevelRenderer::allChanged()
@@ -241,8 +365,6 @@ void LevelRenderer::allChanged()
 	m_resortedMinY = 0;
 	m_resortedMinZ = 0;
 
-	field_88.clear();
-
 	m_resortedMaxX = field_A4;
 	m_resortedMaxY = field_AC;
 	m_resortedMaxZ = field_A8;
@@ -276,11 +398,13 @@ void LevelRenderer::allChanged()
 				field_98[index] = pChunk;
 
 				x3 += 3;
-				field_88.push_back(pChunk);
+				m_dirtyChunks.add(pChunk);
 			}
 		}
 	}
 
+	_updateChunkBoxes();
+
 	if (m_pLevel)
 	{
 		Mob* pMob = m_pMinecraft->m_pMobPersp;
@@ -347,10 +471,13 @@ void LevelRenderer::resortChunks(const TilePos& pos)
 				pChunk->setPos(TilePos(x1, y1, z1));
 
 				if (!wasDirty && pChunk->isDirty())
-					field_88.push_back(pChunk);
+					m_dirtyChunks.add(pChunk);
 			}
 		}
 	}
+
+	_updateChunkBoxes();
+	m_dirtyChunks.setOrigin(Vec3(pos));
 }
 
 void LevelRenderer::entityAdded(Entity* pEnt)
@@ -364,11 +491,24 @@ std::string LevelRenderer::gatherStats1()
 {
 	//@NOTE: This data is based on the Java Edition pre-1.8 legend. This may not be accurate, but it's a good guideline.
 	//See https://minecraft.fandom.com/wiki/Debug_screen#Pre-1.8_legend
+	const TileRendererStats& stats = m_pChunkBuilder->getStats();
+	int nUploaded = m_pChunkBuilder->getUploadedCount();
+	int nVerticesPerMesh = nUploaded ? int(m_pChunkBuilder->getUploadedVertexCount() / nUploaded) : 0;
+
 	std::stringstream ss;
 	ss  << "C: " << m_renderedChunks << "/" << m_totalChunks // Number of chunk sections rendered over total number of chunks.
 		<< ". F: " << m_offscreenChunks // Number of chunk sections loaded outside the viewing distance.
 		<< ", O: " << m_occludedChunks // Number of occluded chunk sections.
 		<< ", E: " << m_emptyChunks // Number of empty chunk sections.
+		<< "\n"
+		<< "M: " << m_pChunkBuilder->getQueuedCount() << " queued" // Chunk meshes waiting for a worker.
+		<< ", " << m_pChunkBuilder->getBuildingCount() << " building" // Chunk meshes being built right now.
+		<< ", " << m_pChunkBuilder->getUploadedCount() << " uploaded" // Chunk meshes uploaded so far.
+		<< "\n"
+		<< "S: " << stats.m_solidCubes << " cubes" // Full opaque cubes tesselated through the fast path.
+		<< ", " << stats.m_facesDrawn << " faces" // Faces those drew, fancy grass overlays included.
+		<< ", " << stats.m_facesCulled << " culled" // Faces those skipped because a neighbour hides them.
+		<< ", " << nVerticesPerMesh << " v/mesh" // Average vertices in an uploaded chunk mesh.
 		<< "\n";
 
 	return ss.str();
@@ -453,10 +593,10 @@ int LevelRenderer::renderChunks(int start, int end, int a, float b)
 			}
 			else if (pChunk->m_bVisible)
 			{
-				if (!field_B8 || pChunk->field_4D)
-					m_renderedChunks++;
-				else
+				if (pChunk->m_bOccluded || (field_B8 && !pChunk->field_4D))
 					m_occludedChunks++;
+				else
+					m_renderedChunks++;
 			}
 			else
 			{
@@ -464,7 +604,7 @@ int LevelRenderer::renderChunks(int start, int end, int a, float b)
 			}
 		}
 
-		if (!pChunk->field_1C[a] && pChunk->m_bVisible && pChunk->field_4D && pChunk->getList(a) >= 0)
+		if (!pChunk->field_1C[a] && pChunk->m_bVisible && !pChunk->m_bOccluded && pChunk->field_4D && pChunk->getList(a) >= 0)
 		{
 			result++;
 			field_24.push_back(pChunk);
@@ -501,11 +641,7 @@ void LevelRenderer::render(Mob* pMob, int a, float b)
 		if (!pChunk->m_bDirty)
 			continue;
 
-		std::vector<Chunk*>::iterator iter = std::find(field_88.begin(), field_88.end(), pChunk);
-		if (iter != field_88.end())
-			continue;
-
-		field_88.push_back(pChunk);
+		m_dirtyChunks.add(pChunk);
 	}
 
 	if (m_pMinecraft->getOptions()->m_iViewDistance != field_BC)
@@ -624,6 +760,8 @@ void LevelRenderer::setLevel(Level* level)
 	delete m_pTileRenderer;
 	m_pTileRenderer = new TileRenderer(m_pLevel);
 
+	m_pChunkBuilder->setLevel(m_pLevel);
+
 	if (level)
 	{
 		level->addListener(this);
@@ -662,7 +800,7 @@ void LevelRenderer::setDirty(const TilePos& min, const TilePos& max)
 				if (pChunk->isDirty())
 					continue;
 
-				field_88.push_back(pChunk);
+				m_dirtyChunks.add(pChunk);
 				pChunk->setDirty();
 			}
 		}
@@ -679,117 +817,48 @@ void LevelRenderer::tick()
 	m_ticksSinceStart++;
 }
 
-typedef std::vector<Chunk*> ChunkVector;
-typedef ChunkVector::iterator ChunkVectorIterator;
-
 bool LevelRenderer::updateDirtyChunks(Mob* pMob, bool b)
 {
-	constexpr int C_MAX = 3;
-	DirtyChunkSorter dcs(pMob);
-	Chunk* pChunks[C_MAX] = { nullptr };
-	ChunkVector* pVec = nullptr;
-
-	int nr1 = 0;
-	int sz = int(field_88.size());
-	for (int i = 0; i < sz; i++)
-	{
-		Chunk* pChunk = field_88[i];
-		if (!b)
-		{
-			if (pChunk->distanceToSqr(pMob) > 1024.0f)
-			{
-				int j;
-				// find place to insert this chunk within the pChunks array
-				for (j = 0; j < C_MAX; j++)
-				{
-					if (pChunks[j] && !dcs(pChunks[j], pChunk))
-						break;
-				}
-				// insert it
-				if (--j <= 0)
-					continue;
-				
-				for (int k = j; --k != 0;) {
-					pChunks[k - 1] = pChunks[k];
-				}
-
-				pChunks[j] = pChunk;
-				continue;
-			}
-		}
-		else if (!pChunk->m_bVisible)
-		{
-			continue;
-		}
-
-		if (!pVec)
-			pVec = new ChunkVector;
-
-		nr1++;
-		pVec->push_back(pChunk);
-		field_88[i] = nullptr;
-	}
-
-	if (pVec)
+	// Meshes are built on the chunk builder's workers, so queueing one is
+	// cheap. The far chunks are only held back while the workers have a
+	// backlog, so that the near ones don't end up waiting behind them.
+	double startTime = getTimeS();
+
+	m_pChunkBuilder->uploadFinished(C_CHUNK_UPLOAD_BUDGET_MS);
+	bool bQueueFar = m_pChunkBuilder->getQueuedCount() < C_MAX_QUEUED_CHUNK_MESHES;
+
+	// The nearest first. The queue's bands are around where the camera was when
+	// they were last sorted though, so a near chunk can still come after a far
+	// one that has to wait. Only past the bands the near ones can be in can the
+	// rest wait too.
+	int lastNearBand = m_dirtyChunks.getBand((C_NEAR_CHUNK_DIST + C_DIRTY_ORIGIN_SLACK) * (C_NEAR_CHUNK_DIST + C_DIRTY_ORIGIN_SLACK));
+
+	Chunk* pChunk = m_dirtyChunks.getNearest();
+	for (int n = 0; pChunk; n++)
 	{
-		if (pVec->size() > 1)
-			std::sort(pVec->begin(), pVec->end(), dcs);
+		Chunk* pNext = m_dirtyChunks.getNext(pChunk);
 
-		for (int i = int(pVec->size()) - 1; i >= 0; i--)
+		if (pChunk->distanceToSqr(pMob) > C_NEAR_CHUNK_DIST_SQR &&
+			(!bQueueFar || (n > 0 && (getTimeS() - startTime) * 1000.0 >= C_CHUNK_UPDATE_BUDGET_MS)))
 		{
-			(*pVec)[i]->rebuild();
-			(*pVec)[i]->setClean();
-		}
-
-		SAFE_DELETE(pVec);
-	}
+			if (pChunk->m_dirtyBand > lastNearBand)
+				break;
 
-	int nr2 = 0;
-	for (int m = C_MAX - 1; m >= 0; m--)
-	{
-		if (!pChunks[m])
+			pChunk = pNext;
 			continue;
-
-		if (!pChunks[m]->m_bVisible && m != C_MAX - 1)
-		{
-			pChunks[m] = nullptr;
-			pChunks[0] = nullptr;
-			break;
 		}
 
-		pChunks[m]->rebuild();
-		pChunks[m]->setClean();
-		nr2++;
-	}
-
-	int nr3 = 0;
-	int nr4 = 0;
-	for (; nr4 < int(field_88.size()); nr4++)
-	{
-		Chunk* pChunk = field_88[nr4];
-		if (!pChunk)
-			continue;
-
-		bool flag = false;
-		for (int j = 0; j < C_MAX; j++)
+		if (!b || pChunk->m_bVisible)
 		{
-			if (pChunk == pChunks[j])
-				flag = true;
+			m_dirtyChunks.remove(pChunk);
+			m_pChunkBuilder->queue(pChunk);
+			pChunk->setClean();
 		}
 
-		if (flag)
-			continue;
-
-		if (nr3 != nr4)
-			field_88[nr3] = pChunk;
-
-		nr3++;
+		pChunk = pNext;
 	}
 
-	if (nr4 > nr3)
-		field_88.erase(field_88.begin() + nr3, field_88.end());
-
-	return nr1 + nr2 == sz;
+	return m_dirtyChunks.empty();
 }
 
 void LevelRenderer::renderHit(Player* pPlayer, const HitResult& hr, int i, void* vp, float f)
@@ -1486,7 +1555,7 @@ void LevelRenderer::skyColorChanged()
 		if (pChunk->isDirty())
 			continue;
 
-		field_88.push_back(pChunk);
+		m_dirtyChunks.add(pChunk);
 		pChunk->setDirty();
 	}
 }
@@ -15,6 +15,8 @@
 #include "Textures.hpp"
 #include "RenderList.hpp"
 #include "TileRenderer.hpp"
+#include "ChunkBuilder.hpp"
+#include "DirtyChunkQueue.hpp"
 
 class Minecraft;
 
@@ -40,33 +42,6 @@ public:
 	}
 };
 
-class DirtyChunkSorter
-{
-	Mob* m_pMob;
-
-public:
-	DirtyChunkSorter(Mob* pMob)
-	{
-		m_pMob = pMob;
-	}
-
-	bool operator()(const Chunk* a, const Chunk* b)
-	{
-		if (a->m_bVisible && !b->m_bVisible)
-			return false;
-		if (!a->m_bVisible && b->m_bVisible)
-			return true;
-
-		float d1 = a->distanceToSqr(m_pMob);
-		float d2 = b->distanceToSqr(m_pMob);
-
-		if (d1 < d2) return false;
-		if (d1 > d2) return true;
-
-		return a->field_48 > b->field_48;
-	}
-};
-
 class LevelRenderer : public LevelListener
 {
 private:
@@ -80,6 +55,7 @@ public:
 
 public:
 	LevelRenderer(Minecraft*, Textures*);
+	~LevelRenderer();
 
 	void allChanged() override;
 	void entityAdded(Entity*) override;
@@ -114,6 +90,21 @@ public:
 	void renderHitSelect(Player* pPlayer, const HitResult& hr, int, void*, float);
 	void renderHitOutline(Player* pPlayer, const HitResult& hr, int, void*, float);
 
+private:
+	// Custom
+	struct ChunkVisit
+	{
+		Chunk* m_pChunk;
+		int m_from; // the face it was entered through, or -1 for the camera's own chunk
+		int m_dirs; // a bit for every direction the flood went on its way there
+	};
+
+	void _updateChunkBoxes();
+	bool _isInFrustum(int index) const { return (m_chunkVisibility[index >> 5] >> (index & 31)) & 1; }
+	// The index of the chunk at pos in m_chunks, or -1 if none is there
+	int _getChunkIndex(const TilePos& pos) const;
+	void _cullOccluded(const Vec3& camPos);
+
 public:
 	float field_4;
 	float field_8;
@@ -139,11 +130,12 @@ public:
 	int m_resortedMaxY;
 	int m_resortedMaxZ;
 	Level* m_pLevel;
-	std::vector<Chunk*> field_88;
+	DirtyChunkQueue m_dirtyChunks; // Custom: was field_88, a std::vector<Chunk*>
 	Chunk** m_chunks;
 	Chunk** field_98;
 	int m_chunksLength;
 	TileRenderer* m_pTileRenderer;
+	ChunkBuilder* m_pChunkBuilder;
 	int field_A4;
 	int field_A8;
 	int field_AC;
@@ -163,4 +155,10 @@ public:
 	int     m_darkBufferCount;
 	//...
 	Textures* m_pTextures;
+	// Custom: the boxes of m_chunks, in the same order, and a bit for each that's in the frustum
+	AABBArray m_chunkBoxes;
+	std::vector<uint32_t> m_chunkVisibility;
+	// Custom: reused by _cullOccluded every frame
+	std::vector<ChunkVisit> m_chunkVisits;
+	int m_visitFrame;
 };
@@ -0,0 +1,356 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#include <cstring>
+#include "LightEngine.hpp"
+#include "world/level/Level.hpp"
+
+// Work that's always done per tick, whatever the time budget says
+#define C_MIN_LIGHT_UPDATES (4096)
+#define C_WORLD_SIZE_X (C_MAX_CHUNKS_X * 16)
+#define C_WORLD_SIZE_Z (C_MAX_CHUNKS_Z * 16)
+
+// Queue entries: sky flag, X, Z, Y and a light level, packed into 28 bits.
+static uint32_t _makeEntry(bool bSky, int x, int y, int z, int light)
+{
+	return (uint32_t(bSky) << 31) | (uint32_t(x) << 19) | (uint32_t(z) << 11) | (uint32_t(y) << 4) | uint32_t(light);
+}
+
+static bool _entrySky(uint32_t entry)   { return (entry >> 31) != 0; }
+static int  _entryX(uint32_t entry)     { return (entry >> 19) & 0xFF; }
+static int  _entryZ(uint32_t entry)     { return (entry >> 11) & 0xFF; }
+static int  _entryY(uint32_t entry)     { return (entry >> 4) & 0x7F; }
+static int  _entryLight(uint32_t entry) { return entry & 0xF; }
+
+static bool _isInWorld(int x, int z)
+{
+	return x >= 0 && z >= 0 && x < C_WORLD_SIZE_X && z < C_WORLD_SIZE_Z;
+}
+
+static int _getIndex(int x, int y, int z)
+{
+	return ((x & 15) << 11) | ((z & 15) << 7) | y;
+}
+
+static int _getOpacity(TileID tile)
+{
+	int opacity = Tile::lightBlock[tile];
+	return opacity ? opacity : 1;
+}
+
+static const int g_offsets[6][3] = {
+	{ -1, 0, 0 }, { 1, 0, 0 },
+	{ 0, -1, 0 }, { 0, 1, 0 },
+	{ 0, 0, -1 }, { 0, 0, 1 },
+};
+
+uint32_t LightEngine::Queue::pop()
+{
+	uint32_t entry = m_entries[m_head++];
+
+	if (m_head == m_entries.size())
+	{
+		clear();
+	}
+	else if (m_head >= 4096 && m_head * 2 >= m_entries.size())
+	{
+		// don't let a long flood grow the queue forever
+		m_entries.erase(m_entries.begin(), m_entries.begin() + m_head);
+		m_head = 0;
+	}
+
+	return entry;
+}
+
+LightEngine::LightEngine(Level* pLevel)
+{
+	m_pLevel = pLevel;
+	memset(m_chunks, 0, sizeof m_chunks);
+	memset(m_bChunkKnown, 0, sizeof m_bChunkKnown);
+	memset(m_bSectionDirty, 0, sizeof m_bSectionDirty);
+}
+
+void LightEngine::update(const LightLayer& ll, const TilePos& min, const TilePos& max)
+{
+	TilePos lo(Mth::Max(min.x, 0), Mth::Max(min.y, C_MIN_Y), Mth::Max(min.z, 0));
+	TilePos hi(Mth::Min(max.x, C_WORLD_SIZE_X - 1), Mth::Min(max.y, C_MAX_Y - 1), Mth::Min(max.z, C_WORLD_SIZE_Z - 1));
+
+	// The old box sweeps dropped boxes of more than 32768 tiles. Here, every
+	// tile is queued on its own, and tick() spreads them over as many ticks
+	// as it takes, so a box of any size gets done.
+	bool bSky = &ll == &LightLayer::Sky;
+	for (int x = lo.x; x <= hi.x; x++)
+	{
+		for (int z = lo.z; z <= hi.z; z++)
+		{
+			for (int y = lo.y; y <= hi.y; y++)
+			{
+				m_checkQueue.push(_makeEntry(bSky, x, y, z, 0));
+			}
+		}
+	}
+}
+
+bool LightEngine::isDone() const
+{
+	return m_checkQueue.empty() && m_decreaseQueue.empty() && m_increaseQueue.empty();
+}
+
+void LightEngine::clear()
+{
+	m_checkQueue.clear();
+	m_decreaseQueue.clear();
+	m_increaseQueue.clear();
+	m_dirtySections.clear();
+	memset(m_bSectionDirty, 0, sizeof m_bSectionDirty);
+}
+
+LevelChunk* LightEngine::_getChunk(int x, int z)
+{
+	int cx = x >> 4, cz = z >> 4;
+	if (!m_bChunkKnown[cz][cx])
+	{
+		m_bChunkKnown[cz][cx] = true;
+		m_chunks[cz][cx] = nullptr;
+
+		// never make the chunk source generate anything from here
+		ChunkPos cp(cx, cz);
+		if (m_pLevel->hasChunk(cp))
+		{
+			LevelChunk* pChunk = m_pLevel->getChunk(cp);
+			if (pChunk && !pChunk->isEmpty())
+				m_chunks[cz][cx] = pChunk;
+		}
+	}
+
+	return m_chunks[cz][cx];
+}
+
+int LightEngine::_getLight(bool bSky, int x, int y, int z)
+{
+	// same values as Level::getBrightness gives for these
+	if (y < C_MIN_Y || y >= C_MAX_Y)
+		return bSky ? LightLayer::Sky.m_x : LightLayer::Block.m_x;
+
+	if (!_isInWorld(x, z))
+		return 0;
+
+	LevelChunk* pChunk = _getChunk(x, z);
+	if (!pChunk)
+		return 0;
+
+	DataLayer& layer = bSky ? pChunk->m_lightSky : pChunk->m_lightBlk;
+	int index = _getIndex(x, y, z);
+	uint8_t data = layer.m_data[index >> 1];
+	return (index & 1) ? (data >> 4) : (data & 0xF);
+}
+
+void LightEngine::_setLight(bool bSky, LevelChunk* pChunk, int x, int y, int z, int light)
+{
+	DataLayer& layer = bSky ? pChunk->m_lightSky : pChunk->m_lightBlk;
+	int index = _getIndex(x, y, z);
+	uint8_t& data = layer.m_data[index >> 1];
+	if (index & 1)
+		data = uint8_t((data & 0x0F) | (light << 4));
+	else
+		data = uint8_t((data & 0xF0) | light);
+
+	int section = ((z >> 4) * C_MAX_CHUNKS_X + (x >> 4)) * 8 + (y >> 4);
+	if (!m_bSectionDirty[section])
+	{
+		m_bSectionDirty[section] = true;
+		m_dirtyMin[section] = TilePos(x, y, z);
+		m_dirtyMax[section] = TilePos(x, y, z);
+		m_dirtySections.push_back(section);
+		return;
+	}
+
+	TilePos& min = m_dirtyMin[section];
+	TilePos& max = m_dirtyMax[section];
+	if (min.x > x) min.x = x;
+	if (min.y > y) min.y = y;
+	if (min.z > z) min.z = z;
+	if (max.x < x) max.x = x;
+	if (max.y < y) max.y = y;
+	if (max.z < z) max.z = z;
+}
+
+// The light a tile has no matter what its neighbours have: what it emits
+// itself, and what comes in from above and below the world.
+int LightEngine::_getSourceLight(bool bSky, LevelChunk* pChunk, int x, int y, int z, int opacity)
+{
+	int light;
+	if (bSky)
+		light = pChunk->m_heightMap[(x & 15) | ((z & 15) << 4)] <= y ? 15 : 0;
+	else
+		light = Tile::lightEmission[pChunk->m_pBlockData[_getIndex(x, y, z)]];
+
+	if (y == C_MIN_Y || y == C_MAX_Y - 1)
+	{
+		int outside = (bSky ? LightLayer::Sky.m_x : LightLayer::Block.m_x) - opacity;
+		if (light < outside)
+			light = outside;
+	}
+
+	return light;
+}
+
+void LightEngine::_processCheck(uint32_t entry)
+{
+	bool bSky = _entrySky(entry);
+	int x = _entryX(entry), y = _entryY(entry), z = _entryZ(entry);
+
+	LevelChunk* pChunk = _getChunk(x, z);
+	if (!pChunk)
+		return;
+
+	int opacity = _getOpacity(pChunk->m_pBlockData[_getIndex(x, y, z)]);
+	int source = _getSourceLight(bSky, pChunk, x, y, z, opacity);
+
+	int expected = source;
+	for (int i = 0; i < 6; i++)
+	{
+		int light = _getLight(bSky, x + g_offsets[i][0], y + g_offsets[i][1], z + g_offsets[i][2]) - opacity;
+		if (expected < light)
+			expected = light;
+	}
+
+	int current = _getLight(bSky, x, y, z);
+	if (expected >= current)
+	{
+		// Spread it even if it's right already, the chunk sets the sky
+		// light of whole columns by itself without telling the neighbours.
+		if (expected > current)
+			_setLight(bSky, pChunk, x, y, z, expected);
+		if (expected > 1)
+			m_increaseQueue.push(_makeEntry(bSky, x, y, z, 0));
+	}
+	else
+	{
+		// Take away everything that might have come from here, the
+		// neighbours that still have light fill the hole back in.
+		_setLight(bSky, pChunk, x, y, z, source);
+		m_decreaseQueue.push(_makeEntry(bSky, x, y, z, current));
+		if (source > 0)
+			m_increaseQueue.push(_makeEntry(bSky, x, y, z, 0));
+	}
+}
+
+void LightEngine::_processDecrease(uint32_t entry)
+{
+	bool bSky = _entrySky(entry);
+	int x = _entryX(entry), y = _entryY(entry), z = _entryZ(entry);
+	int oldLight = _entryLight(entry);
+
+	for (int i = 0; i < 6; i++)
+	{
+		int nx = x + g_offsets[i][0], ny = y + g_offsets[i][1], nz = z + g_offsets[i][2];
+		if (ny < C_MIN_Y || ny >= C_MAX_Y || !_isInWorld(nx, nz))
+			continue;
+
+		LevelChunk* pChunk = _getChunk(nx, nz);
+		if (!pChunk)
+			continue;
+
+		int light = _getLight(bSky, nx, ny, nz);
+		if (light == 0)
+			continue;
+
+		if (light >= oldLight)
+		{
+			// lit by something else, so it can light the hole back up
+			m_increaseQueue.push(_makeEntry(bSky, nx, ny, nz, 0));
+			continue;
+		}
+
+		int opacity = _getOpacity(pChunk->m_pBlockData[_getIndex(nx, ny, nz)]);
+		int source = _getSourceLight(bSky, pChunk, nx, ny, nz, opacity);
+		if (source >= light)
+		{
+			// it makes its own light, so it can light the hole back up too
+			m_increaseQueue.push(_makeEntry(bSky, nx, ny, nz, 0));
+			continue;
+		}
+
+		_setLight(bSky, pChunk, nx, ny, nz, source);
+		m_decreaseQueue.push(_makeEntry(bSky, nx, ny, nz, light));
+		if (source > 0)
+			m_increaseQueue.push(_makeEntry(bSky, nx, ny, nz, 0));
+	}
+}
+
+void LightEngine::_processIncrease(uint32_t entry)
+{
+	bool bSky = _entrySky(entry);
+	int x = _entryX(entry), y = _entryY(entry), z = _entryZ(entry);
+
+	// the tile may have changed since it was queued, spread what it has now
+	int light = _getLight(bSky, x, y, z);
+	if (light <= 1)
+		return;
+
+	for (int i = 0; i < 6; i++)
+	{
+		int nx = x + g_offsets[i][0], ny = y + g_offsets[i][1], nz = z + g_offsets[i][2];
+		if (ny < C_MIN_Y || ny >= C_MAX_Y || !_isInWorld(nx, nz))
+			continue;
+
+		LevelChunk* pChunk = _getChunk(nx, nz);
+		if (!pChunk)
+			continue;
+
+		int newLight = light - _getOpacity(pChunk->m_pBlockData[_getIndex(nx, ny, nz)]);
+		if (newLight <= _getLight(bSky, nx, ny, nz))
+			continue;
+
+		_setLight(bSky, pChunk, nx, ny, nz, newLight);
+		m_increaseQueue.push(_makeEntry(bSky, nx, ny, nz, 0));
+	}
+}
+
+void LightEngine::_flushDirtySections()
+{
+	for (size_t i = 0; i < m_dirtySections.size(); i++)
+	{
+		int section = m_dirtySections[i];
+		m_bSectionDirty[section] = false;
+		m_pLevel->setTilesDirty(m_dirtyMin[section], m_dirtyMax[section]);
+	}
+
+	m_dirtySections.clear();
+}
+
+bool LightEngine::tick(int maxTimeMs)
+{
+	if (isDone())
+		return false;
+
+	// chunks may have been created since the last tick
+	memset(m_bChunkKnown, 0, sizeof m_bChunkKnown);
+
+	int startTime = getTimeMs();
+
+	for (int n = 0; !isDone(); n++)
+	{
+		if (n >= C_MIN_LIGHT_UPDATES && (n & 1023) == 0 && getTimeMs() - startTime >= maxTimeMs)
+			break;
+
+		// Removing light has to finish before anything spreads again,
+		// otherwise light could spread from a tile that's about to go dark.
+		if (!m_decreaseQueue.empty())
+			_processDecrease(m_decreaseQueue.pop());
+		else if (!m_checkQueue.empty())
+			_processCheck(m_checkQueue.pop());
+		else
+			_processIncrease(m_increaseQueue.pop());
+	}
+
+	_flushDirtySections();
+
+	return !isDone();
+}
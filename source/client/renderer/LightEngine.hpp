@@ -0,0 +1,78 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+#include "LightLayer.hpp"
+#include "world/level/TilePos.hpp"
+#include "common/Utils.hpp"
+
+class Level;
+class LevelChunk;
+
+// Flood fill light propagation, working on the chunks' light layers directly.
+//
+// Tiles whose light may have become wrong are queued with update(). tick()
+// first takes away light that has lost its source, then spreads light out
+// from every tile that got brighter. A tile's light is the brightest of its
+// own emission and of its neighbours' light minus its opacity (at least 1),
+// and that has a single solution, so the outcome doesn't depend on how the
+// work gets split across ticks.
+class LightEngine
+{
+public:
+	LightEngine(Level* pLevel);
+
+	void update(const LightLayer& ll, const TilePos& min, const TilePos& max);
+	// Returns true if there's still work left once maxTimeMs has passed.
+	// Some work always gets done, so calling this in a loop always finishes.
+	bool tick(int maxTimeMs);
+	bool isDone() const;
+	void clear();
+
+private:
+	class Queue
+	{
+	public:
+		Queue() : m_head(0) {}
+		bool empty() const { return m_head == m_entries.size(); }
+		void push(uint32_t entry) { m_entries.push_back(entry); }
+		uint32_t pop();
+		void clear() { m_entries.clear(); m_head = 0; }
+
+	private:
+		std::vector<uint32_t> m_entries;
+		size_t m_head;
+	};
+
+	LevelChunk* _getChunk(int x, int z);
+	int _getLight(bool bSky, int x, int y, int z);
+	void _setLight(bool bSky, LevelChunk* pChunk, int x, int y, int z, int light);
+	int _getSourceLight(bool bSky, LevelChunk* pChunk, int x, int y, int z, int opacity);
+	void _processCheck(uint32_t entry);
+	void _processDecrease(uint32_t entry);
+	void _processIncrease(uint32_t entry);
+	void _flushDirtySections();
+
+private:
+	Level* m_pLevel;
+	// tiles that need to be checked, then tiles that lost light and tiles that gained it
+	Queue m_checkQueue;
+	Queue m_decreaseQueue;
+	Queue m_increaseQueue;
+	// looked up once per tick, since asking the chunk source is slow
+	LevelChunk* m_chunks[C_MAX_CHUNKS_Z][C_MAX_CHUNKS_X];
+	bool m_bChunkKnown[C_MAX_CHUNKS_Z][C_MAX_CHUNKS_X];
+	// bounds of the changed tiles in each 16x16x16 section, for the renderer
+	std::vector<int> m_dirtySections;
+	TilePos m_dirtyMin[C_MAX_CHUNKS_Z * C_MAX_CHUNKS_X * 8];
+	TilePos m_dirtyMax[C_MAX_CHUNKS_Z * C_MAX_CHUNKS_X * 8];
+	bool m_bSectionDirty[C_MAX_CHUNKS_Z * C_MAX_CHUNKS_X * 8];
+};
@@ -3,7 +3,6 @@
 #include "common/Utils.hpp"
 #include "world/tile/Tile.hpp"
 #include "world/item/Item.hpp"
-#include "thirdparty/GL/GL.hpp"
 
 #define PM_SEPARATOR ('|')
 
@@ -170,52 +169,6 @@ void PatchManager::LoadPatchData(const std::string& patchData)
 	}
 }
 
-void PatchManager::PatchTextures(AppPlatform* pAppPlatform, ePatchType patchType)
-{
-	// Use glTexSubImage2D to patch the terrain.png texture on the fly.
-	for (int i = 0; i < int(m_patchData.size()); i++)
-	{
-		PatchData& pd = m_patchData[i];
-		if (pd.m_type != patchType)
-			continue;
-
-		bool bDisableFancyGrassIfFailed = false;
-
-		// got the magic value, we can determine whether to disable fancy pants grass if the file doesn't exist
-		if (pd.m_destX == 1600 && pd.m_destY == 1600 && pd.m_type == TYPE_TERRAIN)
-		{
-			pd.m_destX = 4 * 16;
-			pd.m_destY = 5 * 16;
-
-			bDisableFancyGrassIfFailed = true;
-		}
-
-		// N.B. Well, in some cases, you do want things to fail nicely.
-		Texture texture = pAppPlatform->loadTexture("patches/" + pd.m_filename, false);
-		if (!texture.m_pixels || !texture.m_width || !texture.m_height)
-		{
-			LOG_W("Image %s was not found?! Skipping", pd.m_filename.c_str());
-			if (bDisableFancyGrassIfFailed)
-				m_bGrassSidesTinted = false;
-			continue;
-		}
-
-		glTexSubImage2D(
-			GL_TEXTURE_2D,
-			0,
-			pd.m_destX,
-			pd.m_destY,
-			texture.m_width,
-			texture.m_height,
-			GL_RGBA,
-			GL_UNSIGNED_BYTE,
-			texture.m_pixels
-		);
-
-		SAFE_DELETE_ARRAY(texture.m_pixels);
-	}
-}
-
 void PatchManager::PatchTiles()
 {
 	for (int i = 0; i < int(m_patchData.size()); i++)
@@ -113,6 +113,14 @@ void RenderList::renderChunks()
 	xglEnableClientState(GL_COLOR_ARRAY);
 	xglEnableClientState(GL_TEXTURE_COORD_ARRAY);
 
+#ifdef ENH_COMPACT_CHUNK_VERTICES
+	// the texture coordinates are stored scaled up, see Tesselator::CompactVertex
+	glMatrixMode(GL_TEXTURE);
+	glPushMatrix();
+	glScalef(1.0f / C_COMPACT_UV_SCALE, 1.0f / C_COMPACT_UV_SCALE, 1.0f);
+	glMatrixMode(GL_MODELVIEW);
+#endif
+
 	if (field_1C > 0)
 	{
 		for (int i = 0; i < field_1C; i++)
@@ -122,15 +130,28 @@ void RenderList::renderChunks()
 
 			glTranslatef(chk.field_C, chk.field_10, chk.field_14);
 			xglBindBuffer(GL_ARRAY_BUFFER, chk.field_0);
+#ifdef ENH_COMPACT_CHUNK_VERTICES
+			glScalef(1.0f / C_COMPACT_POS_SCALE, 1.0f / C_COMPACT_POS_SCALE, 1.0f / C_COMPACT_POS_SCALE);
+			xglVertexPointer  (3, GL_SHORT,         sizeof(Tesselator::CompactVertex), (void*)offsetof(Tesselator::CompactVertex, m_x));
+			xglTexCoordPointer(2, GL_SHORT,         sizeof(Tesselator::CompactVertex), (void*)offsetof(Tesselator::CompactVertex, m_u));
+			xglColorPointer   (4, GL_UNSIGNED_BYTE, sizeof(Tesselator::CompactVertex), (void*)offsetof(Tesselator::CompactVertex, m_color));
+#else
 			xglVertexPointer  (3, GL_FLOAT,         sizeof(Tesselator::Vertex), (void*)offsetof(Tesselator::Vertex, m_x));
 			xglTexCoordPointer(2, GL_FLOAT,         sizeof(Tesselator::Vertex), (void*)offsetof(Tesselator::Vertex, m_u));
 			xglColorPointer   (4, GL_UNSIGNED_BYTE, sizeof(Tesselator::Vertex), (void*)offsetof(Tesselator::Vertex, m_color));
+#endif
 			xglDrawArrays(GL_TRIANGLES, 0, chk.field_4);
 
 			glPopMatrix();
 		}
 	}
 
+#ifdef ENH_COMPACT_CHUNK_VERTICES
+	glMatrixMode(GL_TEXTURE);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+#endif
+
 	xglDisableClientState(GL_VERTEX_ARRAY);
 	xglDisableClientState(GL_COLOR_ARRAY);
 	xglDisableClientState(GL_TEXTURE_COORD_ARRAY);
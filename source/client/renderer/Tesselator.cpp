@@ -10,8 +10,10 @@
 #include "thirdparty/GL/GL.hpp"
 #include "common/Utils.hpp"
 #include "compat/EndianDefinitions.h"
+#include "common/Mth.hpp"
 
 #include <cstddef>
+#include <cstring>
 
 int g_nVertices = 0, g_nTriangles = 0;
 
@@ -230,6 +232,51 @@ void Tesselator::draw()
 }
 
 RenderChunk Tesselator::end(int vboIdx)
+{
+	return _end(vboIdx, sizeof(Vertex));
+}
+
+#ifdef ENH_COMPACT_CHUNK_VERTICES
+static int16_t _toFixed(float value, float scale)
+{
+	int fixed = Mth::floor(value * scale + 0.5f);
+
+	if (fixed < -32768) fixed = -32768;
+	if (fixed >  32767) fixed =  32767;
+
+	return int16_t(fixed);
+}
+
+RenderChunk Tesselator::endCompact(int vboIdx)
+{
+	if (!m_bTesselating || field_28)
+		return RenderChunk(); // empty render chunk
+
+	// A CompactVertex is smaller than a Vertex, so they're packed over the
+	// start of the same buffer. Vertex i is read before anything lands on it.
+	uint8_t* pData = (uint8_t*)m_pVertices;
+	for (int i = 0; i < m_nVertices; i++)
+	{
+		Vertex vtx;
+		memcpy(&vtx, &m_pVertices[i], sizeof vtx);
+
+		CompactVertex cvtx;
+		cvtx.m_x = _toFixed(vtx.m_x, C_COMPACT_POS_SCALE);
+		cvtx.m_y = _toFixed(vtx.m_y, C_COMPACT_POS_SCALE);
+		cvtx.m_z = _toFixed(vtx.m_z, C_COMPACT_POS_SCALE);
+		cvtx.m_pad = 0;
+		cvtx.m_u = _toFixed(vtx.m_u, C_COMPACT_UV_SCALE);
+		cvtx.m_v = _toFixed(vtx.m_v, C_COMPACT_UV_SCALE);
+		cvtx.m_color = vtx.m_color;
+
+		memcpy(pData + i * sizeof(CompactVertex), &cvtx, sizeof cvtx);
+	}
+
+	return _end(vboIdx, sizeof(CompactVertex));
+}
+#endif
+
+RenderChunk Tesselator::_end(int vboIdx, int vertexSize)
 {
 	if (!m_bTesselating || field_28)
 	{
@@ -252,10 +299,10 @@ RenderChunk Tesselator::end(int vboIdx)
 				vboIdx = m_vboIds[m_vboId];
 
 			xglBindBuffer(GL_ARRAY_BUFFER, vboIdx);
-			xglBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * m_nVertices, m_pVertices, m_accessMode == 1 ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+			xglBufferData(GL_ARRAY_BUFFER, vertexSize * m_nVertices, m_pVertices, m_accessMode == 1 ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
 		}
 
-		field_48 += sizeof (Vertex) * m_nVertices;
+		field_48 += vertexSize * m_nVertices;
 	}
 
 	clear();
@@ -267,6 +314,35 @@ RenderChunk Tesselator::end(int vboIdx)
 	return rchk;
 }
 
+void Tesselator::end(std::vector<Vertex>& vertices)
+{
+	vertices.clear();
+
+	if (!m_bTesselating || field_28)
+		return;
+
+	m_bTesselating = false;
+	vertices.assign(m_pVertices, m_pVertices + m_nVertices);
+
+	clear();
+}
+
+void Tesselator::addVertices(const Vertex* pVertices, int count)
+{
+	if (!m_bTesselating || count <= 0)
+		return;
+
+	if (m_nVertices + count > m_maxVertices) {
+		LOG_W("Overwriting the vertex buffer! This chunk/entity won't show up");
+		clear();
+		return;
+	}
+
+	memcpy(&m_pVertices[m_nVertices], pVertices, sizeof(Vertex) * count);
+	m_vertices += count;
+	m_nVertices += count;
+}
+
 int Tesselator::getVboCount()
 {
 	return m_vboCounts;
@@ -325,6 +401,57 @@ void Tesselator::vertexUV(float x, float y, float z, float u, float v)
 	vertex(x, y, z);
 }
 
+void Tesselator::quadUV(const float* xyz, const float* uv)
+{
+	// only whole quads can be written out as triangles up front
+	if (m_drawArraysMode != GL_QUADS || !TRIANGLE_MODE || (m_count % 4) != 0)
+	{
+		for (int i = 0; i < 4; i++)
+			vertexUV(xyz[i * 3 + 0], xyz[i * 3 + 1], xyz[i * 3 + 2], uv[i * 2 + 0], uv[i * 2 + 1]);
+		return;
+	}
+
+	if (m_nVertices + 6 > m_maxVertices) {
+		LOG_W("Overwriting the vertex buffer! This chunk/entity won't show up");
+		clear();
+	}
+
+	// same order vertex() leaves them in: 0 1 2, then 0 2 3
+	static const int C_CORNERS[6] = { 0, 1, 2, 0, 2, 3 };
+
+	Vertex* pVert = &m_pVertices[m_nVertices];
+	for (int i = 0; i < 6; i++, pVert++)
+	{
+		int corner = C_CORNERS[i];
+
+		pVert->m_x = m_offsetX + xyz[corner * 3 + 0];
+		pVert->m_y = m_offsetY + xyz[corner * 3 + 1];
+		pVert->m_z = m_offsetZ + xyz[corner * 3 + 2];
+		pVert->m_u = uv[corner * 2 + 0];
+		pVert->m_v = uv[corner * 2 + 1];
+
+		if (m_bHasColor)
+			pVert->m_color = m_nextVtxColor;
+
+#ifdef USE_GL_NORMAL_LIGHTING
+		if (m_bHasNormal)
+			pVert->m_normal = m_nextVtxNormal;
+#endif
+	}
+
+	m_nextVtxU = uv[6];
+	m_nextVtxV = uv[7];
+	m_bHasTexture = true;
+
+	m_count += 4;
+	m_vertices += 6;
+	m_nVertices += 6;
+
+#ifdef _DEBUG
+	g_nVertices += 2;
+#endif
+}
+
 void Tesselator::vertex(float x, float y, float z)
 {
 	if (m_nVertices >= m_maxVertices) {
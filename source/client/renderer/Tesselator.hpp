@@ -10,7 +10,9 @@
 
 #include <stdint.h>
 #include <map>
+#include <vector>
 #include "thirdparty/GL/GL.hpp"
+#include "GameMods.hpp"
 #include "RenderChunk.hpp"
 #include "world/phys/Vec3.hpp"
 
@@ -19,6 +21,16 @@
 #define GET_BLUE(c)  (uint8_t(((c) >> 16) & 0xFF))
 #define GET_ALPHA(c) (uint8_t(((c) >> 24) & 0xFF))
 
+#ifdef ENH_COMPACT_CHUNK_VERTICES
+// What positions and texture coordinates are multiplied by in a CompactVertex.
+// Positions are relative to the chunk, so they can be from -32 to 32.
+// Texture coordinates go up to 1, which has to fit too, or the right and
+// bottom edges of the atlas would be a step short. A power of two keeps
+// every texel edge of the 256 wide atlas exact as well.
+#define C_COMPACT_POS_SCALE (1024.0f)
+#define C_COMPACT_UV_SCALE  (16384.0f)
+#endif
+
 #define TRIANGLE_MODE true
 // false on Java
 #define USE_VBO true
@@ -46,8 +58,26 @@ public:
 #endif
 	};
 
+#ifdef ENH_COMPACT_CHUNK_VERTICES
+	// Vertex as it's stored in chunk buffers, 16 bytes instead of 24
+	struct CompactVertex
+	{
+		// position * C_COMPACT_POS_SCALE
+		int16_t m_x;
+		int16_t m_y;
+		int16_t m_z;
+		int16_t m_pad;
+		// texture mapping coords * C_COMPACT_UV_SCALE
+		int16_t m_u;
+		int16_t m_v;
+		// RGBA color
+		uint32_t m_color;
+	};
+#endif
+
 private:
 	void _init();
+	RenderChunk _end(int vboIdx, int vertexSize);
 
 public:
 	Tesselator(int size = 0x800000);
@@ -79,9 +109,22 @@ public:
 	void vertex(const Vec3& pos) { vertex(pos.x, pos.y, pos.z); }
 	void vertexUV(float x, float y, float z, float u, float v);
 	void vertexUV(const Vec3& pos, float u, float v) { vertexUV(pos.x, pos.y, pos.z, u, v); }
+	// Adds the 4 corners of a quad in one go, like 4 vertexUV calls would.
+	// Takes x, y, z for each corner and u, v for each corner.
+	void quadUV(const float* xyz, const float* uv);
 	void voidBeginAndEndCalls(bool b);
 
 	RenderChunk end(int);
+#ifdef ENH_COMPACT_CHUNK_VERTICES
+	// Like end(int), but uploads CompactVertex'es. Only for chunks, their
+	// vertices are small enough to fit.
+	RenderChunk endCompact(int);
+#endif
+	// Finishes like end(int), but hands the vertices out instead of uploading
+	// them. No GL calls are made, so this works on any thread.
+	void end(std::vector<Vertex>& vertices);
+	// Appends vertices finished elsewhere. They must be whole quads.
+	void addVertices(const Vertex* pVertices, int count);
 
 private:
 	// Buffer
@@ -19,6 +19,7 @@ bool TileRenderer::m_bBiomeColors = false;
 
 void TileRenderer::_init()
 {
+	m_pTesselator = &Tesselator::instance;
 	m_textureOverride = -1;
 	field_8 = false;
 	m_bDisableCulling = false;
@@ -80,6 +81,13 @@ TileRenderer::TileRenderer(LevelSource* pLevelSource)
 	m_pLevelSource = pLevelSource;
 }
 
+TileRenderer::TileRenderer(LevelSource* pLevelSource, Tesselator* pTesselator)
+{
+	_init();
+	m_pLevelSource = pLevelSource;
+	m_pTesselator = pTesselator;
+}
+
 float TileRenderer::getWaterHeight(const TilePos& pos, const Material* pCheckMtl)
 {
 	int iBias = 0;
@@ -123,6 +131,20 @@ bool TileRenderer::canRender(int renderShape)
 	return renderShape == SHAPE_SOLID || renderShape == SHAPE_STAIRS || renderShape == SHAPE_FENCE || renderShape == SHAPE_CACTUS;
 }
 
+bool TileRenderer::isSolidCube(const Tile* tile)
+{
+	if (tile->getRenderShape() != SHAPE_SOLID || !tile->isSolidRender())
+		return false;
+
+	// these have their own shouldRenderFace
+	if (tile == Tile::stoneSlab || tile == Tile::leaves || tile == Tile::leaves_carried)
+		return false;
+
+	const AABB& aabb = tile->m_aabb;
+	return aabb.min.x == 0.0f && aabb.min.y == 0.0f && aabb.min.z == 0.0f &&
+	       aabb.max.x == 1.0f && aabb.max.y == 1.0f && aabb.max.z == 1.0f;
+}
+
 // @NOTE: This sucks! Very badly! But it's how they did it.
 void TileRenderer::renderEast(Tile* tile, const Vec3& pos, int texture)
 {
@@ -169,7 +191,7 @@ void TileRenderer::renderEast(Tile* tile, const Vec3& pos, int texture)
 		texV_d = C_RATIO * (texY + aabb.max.y * 16.0f - 0.01f);
 	}
 
-	Tesselator& t = Tesselator::instance;
+	Tesselator& t = *m_pTesselator;
 
 	if (m_bAmbientOcclusion)
 	{
@@ -238,7 +260,7 @@ void TileRenderer::renderWest(Tile* tile, const Vec3& pos, int texture)
 		texV_d = C_RATIO * (texY + aabb.max.y * 16.0f - 0.01f);
 	}
 
-	Tesselator& t = Tesselator::instance;
+	Tesselator& t = *m_pTesselator;
 
 	if (m_bAmbientOcclusion)
 	{
@@ -307,7 +329,7 @@ void TileRenderer::renderSouth(Tile* tile, const Vec3& pos, int texture)
 		texV_d = C_RATIO * (texY + aabb.max.y * 16.0f - 0.01f);
 	}
 
-	Tesselator& t = Tesselator::instance;
+	Tesselator& t = *m_pTesselator;
 
 	if (m_bAmbientOcclusion)
 	{
@@ -376,7 +398,7 @@ void TileRenderer::renderNorth(Tile* tile, const Vec3& pos, int texture)
 		texV_d = C_RATIO * (texY + aabb.max.y * 16.0f - 0.01f);
 	}
 
-	Tesselator& t = Tesselator::instance;
+	Tesselator& t = *m_pTesselator;
 
 	if (m_bAmbientOcclusion)
 	{
@@ -439,7 +461,7 @@ void TileRenderer::renderFaceDown(Tile* tile, const Vec3& pos, int texture)
 		texV_2 = C_RATIO * (texY + 15.99f);
 	}
 
-	Tesselator& t = Tesselator::instance;
+	Tesselator& t = *m_pTesselator;
 
 	if (m_bAmbientOcclusion)
 	{
@@ -502,7 +524,7 @@ void TileRenderer::renderFaceUp(Tile* tile, const Vec3& pos, int texture)
 		texV_2 = C_RATIO * (texY + 15.99f);
 	}
 
-	Tesselator& t = Tesselator::instance;
+	Tesselator& t = *m_pTesselator;
 
 	if (m_bAmbientOcclusion)
 	{
@@ -556,7 +578,7 @@ void TileRenderer::tesselateCrossTexture(Tile* tile, TileData data, const Vec3&
 	float x1 = cenX - 0.45f, x2 = cenX + 0.45f;
 	float z1 = cenZ - 0.45f, z2 = cenZ + 0.45f;
 
-	Tesselator& t = Tesselator::instance;
+	Tesselator& t = *m_pTesselator;
 	// face 1
 	t.vertexUV(x1, newY + 1, z1, texU_l, texV_u);
 	t.vertexUV(x1, newY + 0, z1, texU_l, texV_d);
@@ -589,7 +611,7 @@ bool TileRenderer::tesselateBlockInWorld(Tile* tile, const TilePos& pos, float r
 	if (tile == Tile::grass)
 		r = g = b = 1.0f;
 
-	Tesselator& t = Tesselator::instance;
+	Tesselator& t = *m_pTesselator;
 
 	float fLightHere = tile->getBrightness(m_pLevelSource, pos);
 	bool bDrewAnything = false;
@@ -696,6 +718,134 @@ bool TileRenderer::tesselateBlockInWorld(Tile* tile, const TilePos& pos, float r
 	return bDrewAnything;
 }
 
+bool TileRenderer::tesselateSolidCubeInWorld(Tile* tile, const TilePos& pos, float r, float g, float b)
+{
+	static constexpr float C_RATIO = 1.0f / 256.0f;
+
+	// Corner bits: +1 on X, +1 on Y, +1 on Z, right end of the texture, bottom end of the texture
+	enum
+	{
+		X = 1 << 0,
+		Y = 1 << 1,
+		Z = 1 << 2,
+		U = 1 << 3,
+		V = 1 << 4,
+	};
+
+	// The faces in the order tesselateBlockInWorld draws them, with the
+	// corners in the order renderFaceUp, renderFaceDown etc. add them.
+	static const struct
+	{
+		Facing::Name face;
+		int dx, dy, dz;
+		float shade;
+		int corners[4];
+	}
+	faces[6] =
+	{
+		{ Facing::DOWN,   0, -1,  0, 0.5f, { Z|V,   0,     X|U,   X|Z|U|V } },
+		{ Facing::UP,     0,  1,  0, 1.0f, { X|Y|Z|U|V, X|Y|U, Y,     Y|Z|V   } },
+		{ Facing::NORTH,  0,  0, -1, 0.8f, { Y|U,   X|Y,   X|V,   U|V     } },
+		{ Facing::SOUTH,  0,  0,  1, 0.8f, { Y|Z,   Z|V,   X|Z|U|V, X|Y|Z|U } },
+		{ Facing::WEST,  -1,  0,  0, 0.6f, { Y|Z|U, Y,     V,     Z|U|V   } },
+		{ Facing::EAST,   1,  0,  0, 0.6f, { X|Z|V, X|U|V, X|Y|U, X|Y|Z   } },
+	};
+
+	float topR = r, topG = g, topB = b;
+
+	if (tile == Tile::grass)
+		r = g = b = 1.0f;
+
+	Tesselator& t = *m_pTesselator;
+
+	float cornerX[2] = { 0.0f + pos.x, 1.0f + pos.x };
+	float cornerY[2] = { 0.0f + pos.y, 1.0f + pos.y };
+	float cornerZ[2] = { 0.0f + pos.z, 1.0f + pos.z };
+
+	m_stats.m_solidCubes++;
+
+	bool bDrewAnything = false;
+	for (int i = 0; i < 6; i++)
+	{
+		Facing::Name face = faces[i].face;
+		TilePos tp(pos.x + faces[i].dx, pos.y + faces[i].dy, pos.z + faces[i].dz);
+
+		// same as Tile::shouldRenderFace for a full cube
+		bool bOutside = false;
+		switch (face)
+		{
+			case Facing::DOWN:  bOutside = tp.y == -1; break;
+			case Facing::NORTH: bOutside = tp.z == -1; break;
+			case Facing::SOUTH: bOutside = tp.z == C_MAX_CHUNKS_Z * 16; break;
+			case Facing::WEST:  bOutside = tp.x == -1; break;
+			case Facing::EAST:  bOutside = tp.x == C_MAX_CHUNKS_X * 16; break;
+			default: break;
+		}
+
+		if (!bOutside)
+		{
+			Tile* pNeighbor = Tile::tiles[m_pLevelSource->getTile(tp)];
+			if (pNeighbor && ((face == Facing::UP && pNeighbor == Tile::topSnow) || pNeighbor->isSolidRender()))
+				bOutside = true;
+		}
+
+		if (bOutside)
+		{
+			m_stats.m_facesCulled++;
+			continue;
+		}
+
+		bDrewAnything = true;
+
+		float fLight = m_pLevelSource->getBrightness(tp);
+		float shade = faces[i].shade;
+		int texture = tile->getTexture(m_pLevelSource, pos, face);
+
+		float xyz[12];
+		for (int c = 0; c < 4; c++)
+		{
+			int corner = faces[i].corners[c];
+			xyz[c * 3 + 0] = cornerX[(corner & X) != 0];
+			xyz[c * 3 + 1] = cornerY[(corner & Y) != 0];
+			xyz[c * 3 + 2] = cornerZ[(corner & Z) != 0];
+		}
+
+		// the fancy grass overlay goes on the side faces, on top of the same corners
+		int nLayers = 1;
+		if (m_bFancyGrass && texture == TEXTURE_GRASS_SIDE && face != Facing::UP && face != Facing::DOWN)
+			nLayers = 2;
+
+		for (int layer = 0; layer < nLayers; layer++)
+		{
+			if (face == Facing::UP || layer == 1)
+				t.color(topR * shade * fLight, topG * shade * fLight, topB * shade * fLight);
+			else
+				t.color(r * shade * fLight, g * shade * fLight, b * shade * fLight);
+
+			if (layer == 1)
+				texture = TEXTURE_NONE84;
+
+			float texX = float(16 * (texture % 16));
+			float texY = float(16 * (texture / 16));
+			float texU[2] = { C_RATIO * texX, C_RATIO * (texX + 16.0f - 0.01f) };
+			float texV[2] = { C_RATIO * texY, C_RATIO * (texY + 16.0f - 0.01f) };
+
+			float uv[8];
+			for (int c = 0; c < 4; c++)
+			{
+				int corner = faces[i].corners[c];
+				uv[c * 2 + 0] = texU[(corner & U) != 0];
+				uv[c * 2 + 1] = texV[(corner & V) != 0];
+			}
+
+			t.quadUV(xyz, uv);
+			m_stats.m_facesDrawn++;
+		}
+	}
+
+	return bDrewAnything;
+}
+
 bool TileRenderer::tesselateBlockInWorld(Tile* tile, const TilePos& pos)
 {
 	int color = getTileColor(tile, pos);
@@ -713,12 +863,15 @@ bool TileRenderer::tesselateBlockInWorld(Tile* tile, const TilePos& pos)
 #endif
 	}
 
+	if (!m_bDisableCulling && m_textureOverride < 0 && isSolidCube(tile))
+		return tesselateSolidCubeInWorld(tile, pos, r, g, b);
+
 	return tesselateBlockInWorld(tile, pos, r, g, b);
 }
 
 bool TileRenderer::tesselateCrossInWorld(Tile* tile, const TilePos& pos)
 {
-	Tesselator& t = Tesselator::instance;
+	Tesselator& t = *m_pTesselator;
 
 	float bright = tile->getBrightness(m_pLevelSource, pos);
 	int color = getTileColor(tile, pos);
@@ -740,7 +893,7 @@ bool TileRenderer::tesselateWaterInWorld(Tile* tile1, const TilePos& pos)
 	LiquidTile* tile = (LiquidTile*)tile1;
 	bool bRenderFaceDown, bRenderFaceUp, bRenderSides[4];
 
-	Tesselator& t = Tesselator::instance;
+	Tesselator& t = *m_pTesselator;
 
 	bRenderFaceDown = tile->shouldRenderFace(m_pLevelSource, pos.above(), Facing::UP);
 	bRenderFaceUp   = tile->shouldRenderFace(m_pLevelSource, pos.below(), Facing::DOWN);
@@ -1050,7 +1203,7 @@ bool TileRenderer::tesselateFenceInWorld(Tile* tile, const TilePos& pos)
 
 bool TileRenderer::tesselateDoorInWorld(Tile* tile, const TilePos& pos)
 {
-	Tesselator& t = Tesselator::instance;
+	Tesselator& t = *m_pTesselator;
 	float fBrightHere = tile->getBrightness(m_pLevelSource, pos), fBright;
 	int texture;
 
@@ -1131,7 +1284,7 @@ void TileRenderer::tesselateTorch(Tile* tile, const Vec3& pos, float a, float b)
 	float x2 = x1 + (float)(a * C_TOP_SKEW_RATIO);
 	float z2 = z1 + (float)(b * C_TOP_SKEW_RATIO);
 
-	Tesselator& t = Tesselator::instance;
+	Tesselator& t = *m_pTesselator;
 	
 	// Top side (flame)
 	float x_1 = x2 - C_ONE_PIXEL; 
@@ -1204,7 +1357,7 @@ bool TileRenderer::tesselateTorchInWorld(Tile* tile, const TilePos& pos)
 	if (Tile::lightEmission[tile->m_ID] > 0)
 		bright = 1.0f;
 
-	Tesselator& t = Tesselator::instance;
+	Tesselator& t = *m_pTesselator;
 	t.color(bright, bright, bright);
 
 	switch (data)
@@ -1233,7 +1386,7 @@ bool TileRenderer::tesselateLadderInWorld(Tile* tile, const TilePos& pos)
 {
 	constexpr float C_RATIO = 1.0f / 256.0f;
 
-	Tesselator& t = Tesselator::instance;
+	Tesselator& t = *m_pTesselator;
 
 	int texture = tile->getTexture(Facing::DOWN);
 
@@ -1286,7 +1439,7 @@ bool TileRenderer::tesselateFireInWorld(Tile* tile, const TilePos& pos)
 {
 	constexpr float C_RATIO = 1.0f / 256.0f;
 
-	Tesselator& t = Tesselator::instance;
+	Tesselator& t = *m_pTesselator;
 
 	int texture = tile->getTexture(Facing::DOWN);
 	float bright = tile->getBrightness(m_pLevelSource, pos);
@@ -2520,7 +2673,7 @@ LABEL_102:
 
 void TileRenderer::renderTile(Tile* tile, TileData data, float bright, bool preshade)
 {
-	Tesselator& t = Tesselator::instance;
+	Tesselator& t = *m_pTesselator;
 
 #ifndef ENH_SHADE_HELD_TILES
 	bright = 1.0f; // 255
@@ -2753,7 +2906,7 @@ bool TileRenderer::tesselateBlockInWorldWithAmbienceOcclusionV2(Tile* tile, cons
 	if (tile == Tile::grass)
 		r = g = b = 1.0f;
 
-	//Tesselator& t = Tesselator::instance;
+	//Tesselator& t = *m_pTesselator;
 
 	//float fLightHere = tile->getBrightness(m_pLevelSource, pos);
 
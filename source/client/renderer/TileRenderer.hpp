@@ -12,6 +12,28 @@
 #include "client/renderer/Chunk.hpp"
 #include "client/renderer/Tesselator.hpp"
 
+// Counts kept by the full cube path, for the debug overlay
+struct TileRendererStats
+{
+	int m_solidCubes;
+	int m_facesDrawn;
+	int m_facesCulled;
+
+	TileRendererStats()
+	{
+		m_solidCubes = 0;
+		m_facesDrawn = 0;
+		m_facesCulled = 0;
+	}
+
+	void add(const TileRendererStats& other)
+	{
+		m_solidCubes  += other.m_solidCubes;
+		m_facesDrawn  += other.m_facesDrawn;
+		m_facesCulled += other.m_facesCulled;
+	}
+};
+
 class TileRenderer
 {
 private:
@@ -19,6 +41,7 @@ private:
 public:
 	TileRenderer();
 	TileRenderer(LevelSource*);
+	TileRenderer(LevelSource*, Tesselator*);
 	float getWaterHeight(const TilePos& pos, const Material*);
 	void renderTile(Tile*, TileData data, float bright = 1.0f, bool preshade = false);
 
@@ -40,6 +63,8 @@ public:
 	bool tesselateBlockInWorldWithAmbienceOcclusion(Tile*, const TilePos& pos, float r, float g, float b);
 	bool tesselateBlockInWorld(Tile*, const TilePos& pos, float r, float g, float b);
 	bool tesselateBlockInWorld(Tile*, const TilePos& pos);
+	// Faster tesselateBlockInWorld for tiles that isSolidCube accepts
+	bool tesselateSolidCubeInWorld(Tile*, const TilePos& pos, float r, float g, float b);
 	bool tesselateCrossInWorld(Tile*, const TilePos& pos);
 	bool tesselateWaterInWorld(Tile*, const TilePos& pos);
 	bool tesselateStairsInWorld(Tile*, const TilePos& pos);
@@ -58,12 +83,18 @@ public:
 	bool useAmbientOcclusion() const;
 
 	static bool canRender(int renderShape);
+	// Whether the tile is a full opaque cube that draws its faces like Tile does
+	static bool isSolidCube(const Tile*);
+
+	const TileRendererStats& getStats() const { return m_stats; }
 
 	static bool m_bFancyGrass;
 	static bool m_bBiomeColors;
 
 private:
 	LevelSource* m_pLevelSource;
+	Tesselator* m_pTesselator;
+	TileRendererStats m_stats;
 	int m_textureOverride;
 	bool field_8;
 	bool m_bDisableCulling;
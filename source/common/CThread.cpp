@@ -26,6 +26,26 @@ void CThread::sleep(uint32_t ms)
 #endif
 }
 
+int CThread::getProcessorCount()
+{
+	int nProcessors;
+#ifdef USE_CPP11_THREADS
+	nProcessors = int(std::thread::hardware_concurrency());
+#elif defined(_XBOX)
+	// there's no asking the system here, so stick to one
+	nProcessors = 1;
+#elif defined(USE_WIN32_THREADS)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	nProcessors = int(info.dwNumberOfProcessors);
+#else
+	nProcessors = int(sysconf(_SC_NPROCESSORS_ONLN));
+#endif
+
+	// 0 or -1 if it isn't known
+	return nProcessors < 1 ? 1 : nProcessors;
+}
+
 CThread::CThread(CThreadFunction func, void* param)
 {
 	m_func = func;
@@ -62,3 +82,46 @@ CThread::~CThread()
 	pthread_attr_destroy(&m_thrd_attr);
 #endif
 }
+
+CMutex::CMutex()
+{
+#ifdef USE_CPP11_THREADS
+	// std::mutex is ready for use on construction
+#elif defined(USE_WIN32_THREADS)
+	InitializeCriticalSection(&m_mtx);
+#else
+	pthread_mutex_init(&m_mtx, NULL);
+#endif
+}
+
+CMutex::~CMutex()
+{
+#ifdef USE_CPP11_THREADS
+#elif defined(USE_WIN32_THREADS)
+	DeleteCriticalSection(&m_mtx);
+#else
+	pthread_mutex_destroy(&m_mtx);
+#endif
+}
+
+void CMutex::lock()
+{
+#ifdef USE_CPP11_THREADS
+	m_mtx.lock();
+#elif defined(USE_WIN32_THREADS)
+	EnterCriticalSection(&m_mtx);
+#else
+	pthread_mutex_lock(&m_mtx);
+#endif
+}
+
+void CMutex::unlock()
+{
+#ifdef USE_CPP11_THREADS
+	m_mtx.unlock();
+#elif defined(USE_WIN32_THREADS)
+	LeaveCriticalSection(&m_mtx);
+#else
+	pthread_mutex_unlock(&m_mtx);
+#endif
+}
@@ -31,6 +31,7 @@
 #ifdef USE_CPP11_THREADS
 // C++11
 #include <thread>
+#include <mutex>
 
 #elif defined(USE_WIN32_THREADS)
 
@@ -60,6 +61,8 @@ public:
 	~CThread();
 
 	static void sleep(uint32_t ms);
+	// Custom: how many threads can run at once on this machine, at least 1
+	static int getProcessorCount();
 
 private:
 	CThreadFunction m_func;
@@ -74,3 +77,24 @@ private:
 #endif
 };
 
+// CMutex - Object oriented mutex wrapper, backed by the same threading API as CThread
+
+class CMutex
+{
+public:
+	CMutex();
+	~CMutex();
+
+	void lock();
+	void unlock();
+
+private:
+#ifdef USE_CPP11_THREADS
+	std::mutex m_mtx;
+#elif defined (USE_WIN32_THREADS)
+	CRITICAL_SECTION m_mtx;
+#else
+	pthread_mutex_t m_mtx;
+#endif
+};
+
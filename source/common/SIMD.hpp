@@ -0,0 +1,133 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#pragma once
+
+// Minimal 4-wide float/int vectors. Every operation maps to the same IEEE
+// single precision operation as the scalar code, so results are identical
+// to it as long as neither gets contracted into fused multiply-adds. On
+// aarch64 GCC and Clang do that to the NEON mul and add too, so files
+// that need bit for bit results are built with -ffp-contract=off, see
+// source/CMakeLists.txt. The pragmas below cover Clang and MSVC where the
+// flag isn't passed. USE_SIMD is left undefined on targets with neither
+// SSE2 nor NEON, or with NO_SIMD defined, and the callers keep a scalar
+// path for those.
+
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(_MSC_VER)
+#pragma fp_contract(off)
+#endif
+
+#if defined(NO_SIMD)
+// the scalar paths only
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define USE_SIMD
+#define USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define USE_SIMD
+#define USE_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(USE_SSE2)
+
+typedef __m128  SimdFloat;
+typedef __m128i SimdInt;
+
+namespace Simd
+{
+	inline SimdFloat load(const float* p)            { return _mm_loadu_ps(p); }
+	inline SimdInt   load(const int* p)              { return _mm_loadu_si128((const __m128i*)p); }
+	inline void      store(float* p, SimdFloat a)    { _mm_storeu_ps(p, a); }
+	inline void      store(int* p, SimdInt a)        { _mm_storeu_si128((__m128i*)p, a); }
+	inline SimdFloat set(float f)                    { return _mm_set1_ps(f); }
+	inline SimdInt   set(int i)                      { return _mm_set1_epi32(i); }
+
+	inline SimdFloat add(SimdFloat a, SimdFloat b)   { return _mm_add_ps(a, b); }
+	inline SimdFloat sub(SimdFloat a, SimdFloat b)   { return _mm_sub_ps(a, b); }
+	inline SimdFloat mul(SimdFloat a, SimdFloat b)   { return _mm_mul_ps(a, b); }
+	inline SimdFloat min(SimdFloat a, SimdFloat b)   { return _mm_min_ps(a, b); }
+	inline SimdFloat max(SimdFloat a, SimdFloat b)   { return _mm_max_ps(a, b); }
+
+	inline SimdInt   andi(SimdInt a, SimdInt b)      { return _mm_and_si128(a, b); }
+	inline SimdInt   ori(SimdInt a, SimdInt b)       { return _mm_or_si128(a, b); }
+	inline SimdInt   cmplt(SimdInt a, SimdInt b)     { return _mm_cmplt_epi32(a, b); }
+	inline SimdInt   cmpeq(SimdInt a, SimdInt b)     { return _mm_cmpeq_epi32(a, b); }
+	inline SimdInt   cmplt(SimdFloat a, SimdFloat b) { return _mm_castps_si128(_mm_cmplt_ps(a, b)); }
+	inline SimdInt   cmple(SimdFloat a, SimdFloat b) { return _mm_castps_si128(_mm_cmple_ps(a, b)); }
+	inline SimdInt   shl31(SimdInt a)                { return _mm_slli_epi32(a, 31); }
+	inline SimdInt   shl30(SimdInt a)                { return _mm_slli_epi32(a, 30); }
+
+	// mask ? a : b, where every lane of the mask is all ones or all zeroes
+	inline SimdFloat select(SimdInt mask, SimdFloat a, SimdFloat b)
+	{
+		__m128 m = _mm_castsi128_ps(mask);
+		return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+	}
+	// flips the sign of the lanes whose sign bit is set in bits
+	inline SimdFloat flipSign(SimdFloat a, SimdInt bits) { return _mm_xor_ps(a, _mm_castsi128_ps(bits)); }
+	// true if any lane of the mask is set
+	inline bool any(SimdInt mask) { return _mm_movemask_epi8(mask) != 0; }
+	// bit i is set if lane i of the mask is
+	inline int bits(SimdInt mask) { return _mm_movemask_ps(_mm_castsi128_ps(mask)); }
+}
+
+#elif defined(USE_NEON)
+
+typedef float32x4_t SimdFloat;
+typedef int32x4_t   SimdInt;
+
+namespace Simd
+{
+	inline SimdFloat load(const float* p)            { return vld1q_f32(p); }
+	inline SimdInt   load(const int* p)              { return vld1q_s32(p); }
+	inline void      store(float* p, SimdFloat a)    { vst1q_f32(p, a); }
+	inline void      store(int* p, SimdInt a)        { vst1q_s32(p, a); }
+	inline SimdFloat set(float f)                    { return vdupq_n_f32(f); }
+	inline SimdInt   set(int i)                      { return vdupq_n_s32(i); }
+
+	inline SimdFloat add(SimdFloat a, SimdFloat b)   { return vaddq_f32(a, b); }
+	inline SimdFloat sub(SimdFloat a, SimdFloat b)   { return vsubq_f32(a, b); }
+	inline SimdFloat mul(SimdFloat a, SimdFloat b)   { return vmulq_f32(a, b); }
+	inline SimdFloat min(SimdFloat a, SimdFloat b)   { return vminq_f32(a, b); }
+	inline SimdFloat max(SimdFloat a, SimdFloat b)   { return vmaxq_f32(a, b); }
+
+	inline SimdInt   andi(SimdInt a, SimdInt b)      { return vandq_s32(a, b); }
+	inline SimdInt   ori(SimdInt a, SimdInt b)       { return vorrq_s32(a, b); }
+	inline SimdInt   cmplt(SimdInt a, SimdInt b)     { return vreinterpretq_s32_u32(vcltq_s32(a, b)); }
+	inline SimdInt   cmpeq(SimdInt a, SimdInt b)     { return vreinterpretq_s32_u32(vceqq_s32(a, b)); }
+	inline SimdInt   cmplt(SimdFloat a, SimdFloat b) { return vreinterpretq_s32_u32(vcltq_f32(a, b)); }
+	inline SimdInt   cmple(SimdFloat a, SimdFloat b) { return vreinterpretq_s32_u32(vcleq_f32(a, b)); }
+	inline SimdInt   shl31(SimdInt a)                { return vshlq_n_s32(a, 31); }
+	inline SimdInt   shl30(SimdInt a)                { return vshlq_n_s32(a, 30); }
+
+	inline SimdFloat select(SimdInt mask, SimdFloat a, SimdFloat b)
+	{
+		return vbslq_f32(vreinterpretq_u32_s32(mask), a, b);
+	}
+	inline SimdFloat flipSign(SimdFloat a, SimdInt bits)
+	{
+		return vreinterpretq_f32_s32(veorq_s32(vreinterpretq_s32_f32(a), bits));
+	}
+	inline bool any(SimdInt mask)
+	{
+		uint32x2_t m = vorr_u32(vget_low_u32(vreinterpretq_u32_s32(mask)), vget_high_u32(vreinterpretq_u32_s32(mask)));
+		return (vget_lane_u32(m, 0) | vget_lane_u32(m, 1)) != 0;
+	}
+	inline int bits(SimdInt mask)
+	{
+		static const uint32_t laneBits[4] = { 1, 2, 4, 8 };
+		uint32x4_t b = vandq_u32(vreinterpretq_u32_s32(mask), vld1q_u32(laneBits));
+		uint32x2_t m = vorr_u32(vget_low_u32(b), vget_high_u32(b));
+		return int(vget_lane_u32(m, 0) | vget_lane_u32(m, 1));
+	}
+}
+
+#endif
@@ -8,6 +8,7 @@
 
 // note: not an official file name
 
+#include <cstring>
 #include "common/Utils.hpp"
 #include "compat/PlatformDefinitions.h"
 
@@ -37,7 +38,8 @@
 
 int g_TimeSecondsOnInit = 0;
 
-#if (!defined(USE_SDL) || defined(_WIN32)) && !defined(ANDROID) && !MC_PLATFORM_MAC
+// the same condition Utils.hpp declares these under
+#if defined(_WIN32)
 
 DIR* opendir(const char* name)
 {
@@ -0,0 +1,240 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+	
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#include <algorithm>
+#include "ChunkStreamer.hpp"
+#include "Packet.hpp"
+#include "RakPeerInterface.h"
+#include "common/Utils.hpp"
+#include "world/level/Level.hpp"
+
+// how many chunks of one stream can be queued, encoded or waiting to be sent
+#define C_STREAM_MAX_IN_FLIGHT (8)
+// the same level the LevelDataPacket uses
+#define C_STREAM_COMPRESSION_LEVEL (4)
+#define C_STREAM_IDLE_SLEEP_MS (2)
+// Block updates and movement use channel 0. The chunks go on a channel of
+// their own, so those don't wait for a whole chunk to get through first.
+#define C_STREAM_ORDERING_CHANNEL (1)
+
+struct ChunkDistanceCompare
+{
+	ChunkPos m_center;
+
+	ChunkDistanceCompare(const ChunkPos& center) : m_center(center) {}
+
+	int distSqr(const ChunkPos& pos) const
+	{
+		int dx = pos.x - m_center.x, dz = pos.z - m_center.z;
+		return dx * dx + dz * dz;
+	}
+
+	bool operator()(const ChunkPos& a, const ChunkPos& b) const
+	{
+		return distSqr(a) < distSqr(b);
+	}
+};
+
+ChunkStreamer::ChunkStreamer(RakNet::RakPeerInterface* pPeer)
+{
+	m_pPeer = pPeer;
+	m_nSent = 0;
+	m_nSentBytes = 0;
+	m_nUncompressedBytes = 0;
+	m_nextStreamId = 0;
+	m_bStop = false;
+
+	m_pThread = new CThread(&ChunkStreamer::_threadRoutine, this);
+}
+
+ChunkStreamer::~ChunkStreamer()
+{
+	m_bStop = true;
+	SAFE_DELETE(m_pThread);
+
+	for (size_t i = 0; i < m_queued.size(); i++)
+		delete m_queued[i];
+	for (size_t i = 0; i < m_finished.size(); i++)
+		delete m_finished[i];
+}
+
+void* ChunkStreamer::_threadRoutine(void* ptr)
+{
+	ChunkStreamer* pThis = (ChunkStreamer*)ptr;
+
+	while (!pThis->m_bStop)
+	{
+		pThis->m_lock.lock();
+
+		if (pThis->m_queued.empty())
+		{
+			pThis->m_lock.unlock();
+			CThread::sleep(C_STREAM_IDLE_SLEEP_MS);
+			continue;
+		}
+
+		Job* pJob = pThis->m_queued.front();
+		pThis->m_queued.pop_front();
+
+		pThis->m_lock.unlock();
+
+		pThis->_encode(pJob);
+
+		pThis->m_lock.lock();
+		pThis->m_finished.push_back(pJob);
+		pThis->m_lock.unlock();
+	}
+
+	return nullptr;
+}
+
+void ChunkStreamer::_encode(Job* pJob)
+{
+	CompressedChunkDataPacket packet;
+
+	size_t uncompSize = pJob->m_data.GetNumberOfBytesUsed();
+	size_t compSize = 0;
+	uint8_t* pCompData = ZlibDeflateToMemoryLvl(pJob->m_data.GetData(), uncompSize, &compSize, C_STREAM_COMPRESSION_LEVEL);
+
+	if (pCompData && compSize < uncompSize)
+	{
+		packet.m_uncompSize = int(uncompSize);
+		packet.m_data.Write((const char*)pCompData, compSize);
+	}
+	else
+	{
+		// not worth it, send it as it is
+		packet.m_data.Write((const char*)pJob->m_data.GetData(), uncompSize);
+	}
+
+	SAFE_DELETE_ARRAY(pCompData);
+
+	pJob->m_uncompSize = int(uncompSize);
+	pJob->m_data.Reset();
+	packet.write(&pJob->m_data);
+}
+
+void ChunkStreamer::arrangeChunkOrder(std::vector<ChunkPos>& order, const ChunkPos& center)
+{
+	// stable, so chunks at the same distance keep their order
+	std::stable_sort(order.begin(), order.end(), ChunkDistanceCompare(center));
+}
+
+void ChunkStreamer::start(const RakNet::RakNetGUID& guid, Level* pLevel, const ChunkPos& center)
+{
+	// a client that asks again starts over
+	stop(guid);
+
+	Stream& stream = m_streams[guid];
+	stream.m_id = m_nextStreamId++;
+	stream.m_pLevel = pLevel;
+	stream.m_next = 0;
+	stream.m_nInFlight = 0;
+
+	for (int z = 0; z < C_MAX_CHUNKS_Z; z++)
+	{
+		for (int x = 0; x < C_MAX_CHUNKS_X; x++)
+			stream.m_order.push_back(ChunkPos(x, z));
+	}
+
+	arrangeChunkOrder(stream.m_order, center);
+}
+
+void ChunkStreamer::stop(const RakNet::RakNetGUID& guid)
+{
+	StreamMap::iterator it = m_streams.find(guid);
+	if (it == m_streams.end())
+		return;
+
+	m_streams.erase(it);
+
+	// the jobs that are being encoded are dropped once they're finished
+	m_lock.lock();
+	for (std::deque<Job*>::iterator jt = m_queued.begin(); jt != m_queued.end(); )
+	{
+		if ((*jt)->m_guid != guid)
+		{
+			++jt;
+			continue;
+		}
+
+		delete *jt;
+		jt = m_queued.erase(jt);
+	}
+	m_lock.unlock();
+}
+
+void ChunkStreamer::_queueChunks(const RakNet::RakNetGUID& guid, Stream& stream)
+{
+	while (stream.m_nInFlight < C_STREAM_MAX_IN_FLIGHT && stream.m_next < stream.m_order.size())
+	{
+		const ChunkPos& pos = stream.m_order[stream.m_next++];
+
+		LevelChunk* pChunk = stream.m_pLevel->getChunk(pos);
+		if (!pChunk)
+		{
+			LOG_E("No chunk at %d, %d", pos.x, pos.z);
+			continue;
+		}
+
+		// The chunk is copied here, on the game thread. The encoder only ever
+		// sees the copy.
+		Job* pJob = new Job;
+		pJob->m_guid = guid;
+		pJob->m_streamId = stream.m_id;
+		pJob->m_uncompSize = 0;
+
+		ChunkDataPacket cdp(pos, pChunk);
+		cdp.write(&pJob->m_data);
+
+		stream.m_nInFlight++;
+
+		m_lock.lock();
+		m_queued.push_back(pJob);
+		m_lock.unlock();
+	}
+}
+
+void ChunkStreamer::_sendFinished()
+{
+	m_lock.lock();
+	std::vector<Job*> jobs;
+	jobs.swap(m_finished);
+	m_lock.unlock();
+
+	for (size_t i = 0; i < jobs.size(); i++)
+	{
+		Job* pJob = jobs[i];
+
+		StreamMap::iterator it = m_streams.find(pJob->m_guid);
+		// the stream may have been stopped, or started over, in the meantime
+		if (it != m_streams.end() && it->second.m_id == pJob->m_streamId)
+		{
+			m_pPeer->Send(&pJob->m_data, MEDIUM_PRIORITY, RELIABLE_ORDERED, C_STREAM_ORDERING_CHANNEL, pJob->m_guid, false);
+
+			m_nSent++;
+			m_nSentBytes += pJob->m_data.GetNumberOfBytesUsed();
+			m_nUncompressedBytes += pJob->m_uncompSize;
+
+			Stream& stream = it->second;
+			stream.m_nInFlight--;
+			if (stream.m_nInFlight == 0 && stream.m_next >= stream.m_order.size())
+				m_streams.erase(it);
+		}
+
+		delete pJob;
+	}
+}
+
+void ChunkStreamer::tick()
+{
+	_sendFinished();
+
+	for (StreamMap::iterator it = m_streams.begin(); it != m_streams.end(); ++it)
+		_queueChunks(it->first, it->second);
+}
@@ -0,0 +1,90 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+	
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#pragma once
+
+#include <deque>
+#include <map>
+#include <vector>
+#include <stdint.h>
+#include "common/CThread.hpp"
+#include "world/level/levelgen/chunk/ChunkPos.hpp"
+#include "RakNetTypes.h"
+#include "BitStream.h"
+
+class Level;
+namespace RakNet { class RakPeerInterface; }
+
+// ChunkStreamer - Streams the level to joining clients, one compressed chunk at a time.
+//
+// Every tick, a few chunks of each stream are written into ChunkDataPackets
+// on the game thread, nearest to the client's spawn first. An encoder thread
+// deflates them, and the game thread sends the results out in the next ticks.
+// This replaces the one LevelDataPacket that had to be written and
+// compressed as a whole before a client could see anything.
+
+class ChunkStreamer
+{
+public:
+	ChunkStreamer(RakNet::RakPeerInterface* pPeer);
+	~ChunkStreamer();
+
+	// Starts sending every chunk of the level to the client, nearest to center first
+	void start(const RakNet::RakNetGUID& guid, Level* pLevel, const ChunkPos& center);
+	// Stops sending to the client. What's being encoded for it is dropped.
+	void stop(const RakNet::RakNetGUID& guid);
+	// Queues the next chunks of every stream, and sends what was encoded
+	void tick();
+
+	int getStreamCount() const { return int(m_streams.size()); }
+	int getSentCount() const { return m_nSent; }
+	int64_t getSentBytes() const { return m_nSentBytes; }
+	int64_t getUncompressedBytes() const { return m_nUncompressedBytes; }
+
+	// Sorts the chunks by their distance to center, nearest first
+	static void arrangeChunkOrder(std::vector<ChunkPos>& order, const ChunkPos& center);
+
+private:
+	struct Stream
+	{
+		int m_id;
+		Level* m_pLevel;
+		std::vector<ChunkPos> m_order;
+		size_t m_next;
+		int m_nInFlight;
+	};
+
+	struct Job
+	{
+		RakNet::RakNetGUID m_guid;
+		int m_streamId;
+		RakNet::BitStream m_data;
+		int m_uncompSize;
+	};
+
+	typedef std::map<RakNet::RakNetGUID, Stream> StreamMap;
+
+	static void* _threadRoutine(void* ptr);
+	void _encode(Job* pJob);
+	void _queueChunks(const RakNet::RakNetGUID& guid, Stream& stream);
+	void _sendFinished();
+
+private:
+	RakNet::RakPeerInterface* m_pPeer;
+	CThread* m_pThread;
+	// Guards m_queued and m_finished
+	CMutex m_lock;
+	std::deque<Job*> m_queued;
+	std::vector<Job*> m_finished;
+	StreamMap m_streams;
+	int m_nSent;
+	int64_t m_nSentBytes;
+	int64_t m_nUncompressedBytes;
+	int m_nextStreamId;
+	volatile bool m_bStop;
+};
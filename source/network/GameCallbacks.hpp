@@ -0,0 +1,36 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#pragma once
+
+#include <string>
+#include "world/level/TilePos.hpp"
+
+class Player;
+class CraftingGrid;
+
+// Custom: What the ServerSideNetworkHandler needs from the game it serves.
+// Minecraft implements it when a world is hosted from the client. The
+// dedicated server has no local player, screen or particles.
+class GameCallbacks
+{
+public:
+	virtual ~GameCallbacks() {}
+
+	// The player of whoever hosts the game, nullptr if nobody plays on the server itself
+	virtual Player* getHostPlayer() = 0;
+	// The name the server is announced with
+	virtual std::string getServerName() = 0;
+	// Whether the server is announced as soon as the level is ready
+	virtual bool isServerVisibleByDefault() = 0;
+	// Shows a chat message to whoever hosts the game
+	virtual void displayMessage(const std::string& msg) = 0;
+	// A client broke the tile at pos. Called before it's removed.
+	virtual void showDestroyEffect(const TilePos& pos) = 0;
+	virtual bool handleCrafting(Player* pPlayer, CraftingGrid& grid) = 0;
+};
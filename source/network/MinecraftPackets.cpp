@@ -42,6 +42,12 @@ Packet* MinecraftPackets::createPacket(int type)
 			return new ChunkDataPacket;
 		case PACKET_PLAYER_EQUIPMENT:
 			return new PlayerEquipmentPacket;
+		case PACKET_COMPRESSED_CHUNK_DATA:
+			return new CompressedChunkDataPacket;
+		case PACKET_UPDATE_BLOCKS:
+			return new UpdateBlocksPacket;
+		case PACKET_MOVE_ENTITIES:
+			return new MoveEntitiesPacket;
 
 		case PACKET_LEVEL_DATA:
 			return new LevelDataPacket;
@@ -49,3 +55,66 @@ Packet* MinecraftPackets::createPacket(int type)
 
 	return nullptr;
 }
+
+bool MinecraftPackets::isReusable(int type)
+{
+	switch (type)
+	{
+		case PACKET_MESSAGE:
+		case PACKET_SET_TIME:
+		case PACKET_REMOVE_ENTITY:
+		case PACKET_MOVE_PLAYER:
+		case PACKET_PLACE_BLOCK:
+		case PACKET_REMOVE_BLOCK:
+		case PACKET_UPDATE_BLOCK:
+		case PACKET_REQUEST_CHUNK:
+		case PACKET_PLAYER_EQUIPMENT:
+		case PACKET_UPDATE_BLOCKS:
+		case PACKET_MOVE_ENTITIES:
+			return true;
+	}
+
+	// The rest either skip fields that older versions don't send, or are rare enough
+	// that there's no point in keeping them around.
+	return false;
+}
+
+void MinecraftPackets::resetPacket(int type, Packet* pPacket)
+{
+	switch (type)
+	{
+		case PACKET_MESSAGE:
+			*(MessagePacket*)pPacket = MessagePacket();
+			break;
+		case PACKET_SET_TIME:
+			*(SetTimePacket*)pPacket = SetTimePacket();
+			break;
+		case PACKET_REMOVE_ENTITY:
+			*(RemoveEntityPacket*)pPacket = RemoveEntityPacket();
+			break;
+		case PACKET_MOVE_PLAYER:
+			*(MovePlayerPacket*)pPacket = MovePlayerPacket();
+			break;
+		case PACKET_PLACE_BLOCK:
+			*(PlaceBlockPacket*)pPacket = PlaceBlockPacket();
+			break;
+		case PACKET_REMOVE_BLOCK:
+			*(RemoveBlockPacket*)pPacket = RemoveBlockPacket();
+			break;
+		case PACKET_UPDATE_BLOCK:
+			*(UpdateBlockPacket*)pPacket = UpdateBlockPacket();
+			break;
+		case PACKET_REQUEST_CHUNK:
+			*(RequestChunkPacket*)pPacket = RequestChunkPacket();
+			break;
+		case PACKET_PLAYER_EQUIPMENT:
+			*(PlayerEquipmentPacket*)pPacket = PlayerEquipmentPacket();
+			break;
+
+		// These clear what they hold and check every read themselves, and
+		// keeping their buffers is the point of reusing them.
+		case PACKET_UPDATE_BLOCKS:
+		case PACKET_MOVE_ENTITIES:
+			break;
+	}
+}
@@ -14,5 +14,10 @@ class MinecraftPackets
 {
 public:
 	static Packet* createPacket(int type);
+	// Custom: whether a packet of this type can be read into again. It has to be reset
+	// first, a truncated packet leaves the fields it doesn't have as they were.
+	static bool isReusable(int type);
+	// Custom: puts a reusable packet back the way createPacket makes it
+	static void resetPacket(int type, Packet* pPacket);
 };
 
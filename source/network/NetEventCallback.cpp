@@ -28,6 +28,10 @@ void NetEventCallback::onDisconnect(const RakNet::RakNetGUID& guid)
 {
 }
 
+void NetEventCallback::tick()
+{
+}
+
 void NetEventCallback::handle(const RakNet::RakNetGUID& guid, LoginPacket* packet)
 {
 }
@@ -85,6 +89,18 @@ void NetEventCallback::handle(const RakNet::RakNetGUID& guid, ChunkDataPacket* p
 	
 }
 
+void NetEventCallback::handle(const RakNet::RakNetGUID& guid, CompressedChunkDataPacket* packet)
+{
+}
+
+void NetEventCallback::handle(const RakNet::RakNetGUID& guid, UpdateBlocksPacket* packet)
+{
+}
+
+void NetEventCallback::handle(const RakNet::RakNetGUID& guid, MoveEntitiesPacket* packet)
+{
+}
+
 void NetEventCallback::handle(const RakNet::RakNetGUID& guid, PlayerEquipmentPacket* packet)
 {
 }
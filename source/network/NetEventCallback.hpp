@@ -25,6 +25,9 @@ class RemoveBlockPacket;
 class UpdateBlockPacket;
 class RequestChunkPacket;
 class ChunkDataPacket;
+class CompressedChunkDataPacket;
+class UpdateBlocksPacket;
+class MoveEntitiesPacket;
 class PlayerEquipmentPacket;
 class LevelDataPacket;
 class CraftingPacket;
@@ -41,6 +44,8 @@ public:
 	virtual void onUnableToConnect();
 	virtual void onNewClient(const RakNet::RakNetGUID&);
 	virtual void onDisconnect(const RakNet::RakNetGUID&);
+	// Called every frame, after the received packets were handled
+	virtual void tick();
 	// TODO: macro this with a global PacketType list or something
 	virtual void handle(const RakNet::RakNetGUID&, LoginPacket*);
 	virtual void handle(const RakNet::RakNetGUID&, LoginStatusPacket*);
@@ -56,6 +61,9 @@ public:
 	virtual void handle(const RakNet::RakNetGUID&, UpdateBlockPacket*);
 	virtual void handle(const RakNet::RakNetGUID&, RequestChunkPacket*);
 	virtual void handle(const RakNet::RakNetGUID&, ChunkDataPacket*);
+	virtual void handle(const RakNet::RakNetGUID&, CompressedChunkDataPacket*);
+	virtual void handle(const RakNet::RakNetGUID&, UpdateBlocksPacket*);
+	virtual void handle(const RakNet::RakNetGUID&, MoveEntitiesPacket*);
 	virtual void handle(const RakNet::RakNetGUID&, PlayerEquipmentPacket*);
 	virtual void handle(const RakNet::RakNetGUID&, LevelDataPacket*);
 	virtual void handle(const RakNet::RakNetGUID&, CraftingPacket*);
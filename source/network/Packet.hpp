@@ -46,6 +46,9 @@ enum ePacketType
 	PACKET_CHUNK_DATA,
 	PACKET_PLAYER_EQUIPMENT,
 	PACKET_CRAFTING,
+	PACKET_COMPRESSED_CHUNK_DATA,
+	PACKET_UPDATE_BLOCKS,
+	PACKET_MOVE_ENTITIES,
 
 	PACKET_LEVEL_DATA = 200,
 
@@ -99,6 +102,9 @@ enum ePacketType
 	PACKET_SET_HEALTH,
 	PACKET_ANIMATE,
 	PACKET_RESPAWN,
+	PACKET_COMPRESSED_CHUNK_DATA,
+	PACKET_UPDATE_BLOCKS,
+	PACKET_MOVE_ENTITIES,
 
 	PACKET_LEVEL_DATA = 200,
 #endif
@@ -120,12 +126,16 @@ public:
 	{
 		m_clientNetworkVersion = 0;
 		m_clientNetworkVersion2 = 0;
+		m_bTakesTileBatches = false;
+		m_bTakesPackedMoves = false;
 	}
 	LoginPacket(const std::string& uname)
 	{
 		m_str = RakNet::RakString(uname.c_str());
 		m_clientNetworkVersion = NETWORK_PROTOCOL_VERSION;
 		m_clientNetworkVersion2 = NETWORK_PROTOCOL_VERSION;
+		m_bTakesTileBatches = false;
+		m_bTakesPackedMoves = false;
 	}
 
 	void handle(const RakNet::RakNetGUID&, NetEventCallback* pCallback) override;
@@ -135,6 +145,10 @@ public:
 	RakNet::RakString m_str;
 	int m_clientNetworkVersion;
 	int m_clientNetworkVersion2;
+	// Custom: the client understands UpdateBlocksPackets, and ChunkDataPackets with a few sections
+	bool m_bTakesTileBatches;
+	// Custom: the client understands MoveEntitiesPackets
+	bool m_bTakesPackedMoves;
 };
 
 class LoginStatusPacket : public Packet
@@ -217,6 +231,7 @@ public:
 		m_entityId = 0;
 		m_serverVersion = 0;
 		m_time = 0;
+		m_bStreamsLevel = false;
 	}
 	void handle(const RakNet::RakNetGUID&, NetEventCallback* pCallback) override;
 	void write(RakNet::BitStream*) override;
@@ -229,6 +244,8 @@ public:
 	Vec3 m_pos;
 	int m_serverVersion;
 	int m_time;
+	// Custom: the server can stream the level with CompressedChunkDataPackets
+	bool m_bStreamsLevel;
 };
 
 class AddPlayerPacket : public Packet
@@ -286,6 +303,43 @@ public:
 	Vec2 m_rot;
 };
 
+// Custom: the movement of several entities, packed. Positions are in 1/32 of a
+// tile, angles in 1/256 of a turn. A move can be relative to the previous one
+// that was sent to the same client for the same entity.
+#define C_MAX_PACKED_MOVES (255)
+
+class MoveEntitiesPacket : public Packet
+{
+public:
+	enum
+	{
+		MOVE_POS = 1 << 0,
+		MOVE_POS_DELTA = 1 << 1, // m_pos is relative, and each fits in a byte
+		MOVE_ROT = 1 << 2,
+		MOVE_WIDE_ID = 1 << 3, // the ID doesn't fit in 16 bits
+	};
+
+	struct Move
+	{
+		int m_id;
+		uint8_t m_flags;
+		int16_t m_pos[3];
+		uint8_t m_rot[2];
+	};
+
+public:
+	void handle(const RakNet::RakNetGUID&, NetEventCallback* pCallback) override;
+	void write(RakNet::BitStream*) override;
+	void read(RakNet::BitStream*) override;
+
+	static int16_t packCoord(float f);
+	static float unpackCoord(int i);
+	static uint8_t packAngle(float f);
+	static float unpackAngle(uint8_t i);
+public:
+	std::vector<Move> m_moves;
+};
+
 class PlaceBlockPacket : public Packet
 {
 public:
@@ -336,6 +390,12 @@ public:
 class UpdateBlockPacket : public Packet
 {
 public:
+	UpdateBlockPacket()
+	{
+		m_tileTypeId = TILE_AIR;
+		m_data = 0;
+	}
+
 	void handle(const RakNet::RakNetGUID&, NetEventCallback* pCallback) override;
 	void write(RakNet::BitStream*) override;
 	void read(RakNet::BitStream*) override;
@@ -345,6 +405,35 @@ public:
 	TileData m_data;
 };
 
+// Custom: the tiles of one chunk that changed during a tick
+class UpdateBlocksPacket : public Packet
+{
+public:
+	struct Change
+	{
+		uint16_t m_pos; // x | z << 4 | y << 8, in the chunk
+		TileID m_tile;
+		TileData m_data;
+	};
+
+public:
+	UpdateBlocksPacket() {}
+	UpdateBlocksPacket(const ChunkPos& pos) : m_chunkPos(pos) {}
+	void handle(const RakNet::RakNetGUID&, NetEventCallback* pCallback) override;
+	void write(RakNet::BitStream*) override;
+	void read(RakNet::BitStream*) override;
+
+	void addChange(const TilePos& pos, TileID tile, TileData data);
+	TilePos getChangePos(const Change& change) const;
+public:
+	ChunkPos m_chunkPos;
+	std::vector<Change> m_changes;
+};
+
+// What a RequestChunkPacket can ask for instead of a single chunk
+#define C_REQUEST_LEVEL_DATA   (-9999) // the whole level in one LevelDataPacket
+#define C_REQUEST_LEVEL_STREAM (-9998) // the whole level as CompressedChunkDataPackets, nearest chunks first
+
 class RequestChunkPacket : public Packet
 {
 public:
@@ -363,8 +452,11 @@ public:
 	ChunkDataPacket()
 	{
 		m_pChunk = nullptr;
+		m_pUpdateMap = nullptr;
 	}
-	ChunkDataPacket(const ChunkPos& pos, LevelChunk* c) :m_chunkPos(pos), m_pChunk(c) {}
+	ChunkDataPacket(const ChunkPos& pos, LevelChunk* c) :m_chunkPos(pos), m_pChunk(c), m_pUpdateMap(nullptr) {}
+	// Custom: only writes the sections set in updateMap, instead of the chunk's own
+	ChunkDataPacket(const ChunkPos& pos, LevelChunk* c, const uint8_t* updateMap) :m_chunkPos(pos), m_pChunk(c), m_pUpdateMap(updateMap) {}
 	void handle(const RakNet::RakNetGUID&, NetEventCallback* pCallback) override;
 	void write(RakNet::BitStream*) override;
 	void read(RakNet::BitStream*) override;
@@ -372,6 +464,7 @@ public:
 	ChunkPos m_chunkPos;
 	RakNet::BitStream m_data;
 	LevelChunk* m_pChunk;
+	const uint8_t* m_pUpdateMap;
 };
 
 class LevelDataPacket : public Packet
@@ -390,6 +483,23 @@ public:
 	Level* m_pLevel;
 };
 
+// Custom: a ChunkDataPacket deflated on its own, used to stream the level
+class CompressedChunkDataPacket : public Packet
+{
+public:
+	CompressedChunkDataPacket()
+	{
+		m_uncompSize = 0;
+	}
+	void handle(const RakNet::RakNetGUID&, NetEventCallback* pCallback) override;
+	void write(RakNet::BitStream*) override;
+	void read(RakNet::BitStream*) override;
+public:
+	// 0 if m_data isn't compressed
+	int m_uncompSize;
+	RakNet::BitStream m_data;
+};
+
 class PlayerEquipmentPacket : public Packet
 {
 public:
@@ -23,6 +23,9 @@ RakNetInstance::RakNetInstance()
 	m_bIsHost = false;
 	m_pRakPeerInterface = RakNet::RakPeerInterface::GetInstance();
 	m_pRakPeerInterface->SetOccasionalPing(true);
+
+	for (int i = 0; i < 256; i++)
+		m_pReusablePackets[i] = nullptr;
 }
 
 RakNetInstance::~RakNetInstance()
@@ -33,6 +36,9 @@ RakNetInstance::~RakNetInstance()
 		RakNet::RakPeerInterface::DestroyInstance(m_pRakPeerInterface);
 		m_pRakPeerInterface = nullptr;
 	}
+
+	for (int i = 0; i < 256; i++)
+		SAFE_DELETE(m_pReusablePackets[i]);
 }
 
 void RakNetInstance::announceServer(const std::string& name)
@@ -139,20 +145,22 @@ void RakNetInstance::runEvents(NetEventCallback* callback)
 			
 		uint8_t packetType = *(pPacket->data);
 
-		RakNet::BitStream* pBitStream = new RakNet::BitStream(pPacket->data + 1, pPacket->length - 1, 0);
+		// reads straight out of RakNet's packet, without copying it
+		RakNet::BitStream bitStream(pPacket->data + 1, pPacket->length - 1, false);
+		RakNet::BitStream* pBitStream = &bitStream;
         
-        LOG_PACKET("Recieved packet from %s (id: %d bitStream: 0x%x length: %u)", pPacket->systemAddress.ToString(), packetType, pBitStream, pPacket->length);
+        LOG_PACKET("Recieved packet from %s (id: %d length: %u)", pPacket->systemAddress.ToString(), packetType, pPacket->length);
 
 		// @NOTE: why -1?
 		if (packetType >= PACKET_LOGIN - 1)
 		{
-			Packet* pUserPacket = MinecraftPackets::createPacket(packetType);
+			Packet* pUserPacket = _acquirePacket(packetType);
 			if (pUserPacket)
 			{
 				pUserPacket->read(pBitStream);
 				//LOG_PACKET("Packet: %d", packetType);
 				pUserPacket->handle(pPacket->guid, callback);
-				delete pUserPacket;
+				_releasePacket(packetType, pUserPacket);
 			}
 			else
 			{
@@ -231,8 +239,6 @@ void RakNetInstance::runEvents(NetEventCallback* callback)
 		}
 
 		m_pRakPeerInterface->DeallocatePacket(pPacket);
-		if (pBitStream)
-			delete pBitStream;
 	}
 
 	if (m_bPingingForHosts)
@@ -256,11 +262,54 @@ void RakNetInstance::runEvents(NetEventCallback* callback)
 	}
 }
 
+Packet* RakNetInstance::_acquirePacket(int type)
+{
+	// Taken out while it's being handled, in case handling it runs the events again
+	Packet* packet = m_pReusablePackets[type];
+	if (packet)
+	{
+		m_pReusablePackets[type] = nullptr;
+		MinecraftPackets::resetPacket(type, packet);
+		return packet;
+	}
+
+	return MinecraftPackets::createPacket(type);
+}
+
+void RakNetInstance::_releasePacket(int type, Packet* packet)
+{
+	if (!m_pReusablePackets[type] && MinecraftPackets::isReusable(type))
+	{
+		m_pReusablePackets[type] = packet;
+		return;
+	}
+
+	delete packet;
+}
+
 // this broadcasts a packet to all other connected peers
 void RakNetInstance::send(Packet* packet)
 {
-	RakNet::BitStream bs;
-	packet->write(&bs);
+	send(*packet);
+
+	delete packet;
+	// return 1300; --- ida tells me this returns 1300. Huh
+}
+
+// this sends a specific peer a message
+void RakNetInstance::send(const RakNet::RakNetGUID& guid, Packet* packet)
+{
+	send(guid, *packet);
+
+	delete packet;
+	// return 1300; --- ida tells me this returns 1300. Huh
+}
+
+void RakNetInstance::send(Packet& packet)
+{
+	RakNet::BitStream& bs = m_sendStream;
+	bs.Reset();
+	packet.write(&bs);
 
     uint32_t result;
 	if (m_bIsHost)
@@ -285,21 +334,14 @@ void RakNetInstance::send(Packet* packet)
     {
         LOG_E("Failed to send packet!");
     }
-
-	delete packet;
-	// return 1300; --- ida tells me this returns 1300. Huh
 }
 
-// this sends a specific peer a message
-void RakNetInstance::send(const RakNet::RakNetGUID& guid, Packet* packet)
+void RakNetInstance::send(const RakNet::RakNetGUID& guid, Packet& packet)
 {
-	RakNet::BitStream bs;
-	packet->write(&bs);
-
-	m_pRakPeerInterface->Send(&bs, HIGH_PRIORITY, RELIABLE, 0, guid, false);
+	m_sendStream.Reset();
+	packet.write(&m_sendStream);
 
-	delete packet;
-	// return 1300; --- ida tells me this returns 1300. Huh
+	m_pRakPeerInterface->Send(&m_sendStream, HIGH_PRIORITY, RELIABLE, 0, guid, false);
 }
 
 void RakNetInstance::stopPingForHosts()
@@ -34,8 +34,15 @@ public:
 	void runEvents(NetEventCallback*);
 	void send(Packet* packet);
 	void send(const RakNet::RakNetGUID& guid, Packet* packet);
+	// Custom: the same, except that the packet stays with the caller, so it can live on the stack
+	void send(Packet& packet);
+	void send(const RakNet::RakNetGUID& guid, Packet& packet);
 	void stopPingForHosts();
 
+private:
+	Packet* _acquirePacket(int type);
+	void _releasePacket(int type, Packet* packet);
+
 public:
 	RakNet::RakPeerInterface* m_pRakPeerInterface;
 	bool m_bIsHost;
@@ -46,5 +53,11 @@ public:
 	bool m_bPingingForHosts;
 	int m_hostPingPort;
 	int m_startedPingingAt;
+
+private:
+	// Custom: received packets are read into these instead of new ones, see MinecraftPackets::isReusable
+	Packet* m_pReusablePackets[256];
+	// Custom: outgoing packets are written into this, it keeps its buffer between sends
+	RakNet::BitStream m_sendStream;
 };
 
@@ -12,6 +12,7 @@
 #include "world/crafting/CraftingManager.hpp"
 #include "world/crafting/CraftingGrid.hpp"
 #include "network/packets/CraftingPacket.hpp"
+#include <algorithm>
 
 // This lets you make the server shut up and not log events in the debug console.
 //#define VERBOSE_SERVER
@@ -24,14 +25,46 @@
 #define printf_ignorable(str, ...)
 #endif
 
-ServerSideNetworkHandler::ServerSideNetworkHandler(Minecraft* minecraft, RakNetInstance* rakNetInstance)
+// Movement is sent every tick up to this far away. The interval doubles with the distance.
+#define C_MOVE_NEAR_DISTANCE (16.0f)
+#define C_MOVE_MAX_INTERVAL (8)
+// Entities behind a client that are further than this are sent half as often
+#define C_MOVE_BEHIND_DISTANCE (8.0f)
+// How many bytes of movement a client gets per second, and how much of it can pile up
+#define C_MOVE_BUDGET_PER_SECOND (8192)
+#define C_MOVE_BUDGET_BURST (C_MOVE_BUDGET_PER_SECOND / 4)
+#define C_TICKS_PER_SECOND (20)
+
+struct PendingMove
 {
-	m_pMinecraft = minecraft;
+	OnlinePlayer* m_pAbout;
+	float m_overdue; // how many intervals it waited
+	float m_distSqr;
+
+	PendingMove(OnlinePlayer* pAbout, float overdue, float distSqr) : m_pAbout(pAbout), m_overdue(overdue), m_distSqr(distSqr) {}
+
+	// the most overdue first, then the nearest
+	bool operator<(const PendingMove& other) const
+	{
+		if (m_overdue != other.m_overdue)
+			return m_overdue > other.m_overdue;
+		return m_distSqr < other.m_distSqr;
+	}
+};
+
+ServerSideNetworkHandler::ServerSideNetworkHandler(GameCallbacks* gameCallbacks, RakNetInstance* rakNetInstance)
+{
+	m_pGameCallbacks = gameCallbacks;
 	m_pLevel = nullptr;
 	m_pRakNetInstance = rakNetInstance;
 	allowIncomingConnections(false);
 	m_pRakNetPeer = m_pRakNetInstance->getPeer();
 	m_bAllowIncoming = false;
+	m_pChunkStreamer = new ChunkStreamer(m_pRakNetPeer);
+	m_nTileChangesSent = 0;
+	m_nTileChangePackets = 0;
+	m_nTileChangeBytes = 0;
+	m_nTicks = 0;
 
 	setupCommands();
 }
@@ -45,22 +78,26 @@ ServerSideNetworkHandler::~ServerSideNetworkHandler()
 		delete it->second;
 
 	m_onlinePlayers.clear();
+
+	SAFE_DELETE(m_pChunkStreamer);
 }
 
 void ServerSideNetworkHandler::levelGenerated(Level* level)
 {
 	m_pLevel = level;
 
-	if (m_pMinecraft->m_pLocalPlayer)
+	Player* pHostPlayer = m_pGameCallbacks->getHostPlayer();
+	if (pHostPlayer)
 	{
-		m_pMinecraft->m_pLocalPlayer->m_guid = m_pRakNetPeer->GetMyGUID();
+		pHostPlayer->m_guid = m_pRakNetPeer->GetMyGUID();
 	}
 
 	level->addListener(this);
 
-	allowIncomingConnections(m_pMinecraft->getOptions()->m_bServerVisibleDefault);
+	allowIncomingConnections(m_pGameCallbacks->isServerVisibleByDefault());
 
-	m_onlinePlayers[m_pMinecraft->m_pLocalPlayer->m_guid] = new OnlinePlayer(m_pMinecraft->m_pLocalPlayer, m_pMinecraft->m_pLocalPlayer->m_guid);
+	if (pHostPlayer)
+		m_onlinePlayers[pHostPlayer->m_guid] = new OnlinePlayer(pHostPlayer, pHostPlayer->m_guid);
 }
 
 void ServerSideNetworkHandler::onNewClient(const RakNet::RakNetGUID& guid)
@@ -79,6 +116,11 @@ void ServerSideNetworkHandler::onDisconnect(const RakNet::RakNetGUID& guid)
 
 	Player* pPlayer = pOnlinePlayer->m_pPlayer;
 
+	m_pChunkStreamer->stop(guid);
+
+	for (OnlinePlayerMap::iterator it = m_onlinePlayers.begin(); it != m_onlinePlayers.end(); ++it)
+		it->second->m_sentMoves.erase(pPlayer->m_EntityID);
+
 	// erase it from the map
 	m_onlinePlayers.erase(m_onlinePlayers.find(guid)); // it better be in our map
 
@@ -93,6 +135,11 @@ void ServerSideNetworkHandler::onDisconnect(const RakNet::RakNetGUID& guid)
 	delete pOnlinePlayer;
 }
 
+void ServerSideNetworkHandler::tick()
+{
+	m_pChunkStreamer->tick();
+}
+
 void ServerSideNetworkHandler::handle(const RakNet::RakNetGUID& guid, LoginPacket* packet)
 {
 	if (!m_bAllowIncoming)
@@ -134,7 +181,11 @@ void ServerSideNetworkHandler::handle(const RakNet::RakNetGUID& guid, LoginPacke
 	pPlayer->m_guid = guid;
 	pPlayer->m_name = std::string(packet->m_str.C_String());
 
-	m_onlinePlayers[guid] = new OnlinePlayer(pPlayer, guid);
+	OnlinePlayer* pOnlinePlayer = new OnlinePlayer(pPlayer, guid);
+	pOnlinePlayer->m_bTakesTileBatches = packet->m_bTakesTileBatches;
+	pOnlinePlayer->m_bTakesPackedMoves = packet->m_bTakesPackedMoves;
+	pOnlinePlayer->m_moveBudget = C_MOVE_BUDGET_BURST;
+	m_onlinePlayers[guid] = pOnlinePlayer;
 
 	StartGamePacket sgp;
 	sgp.m_seed = m_pLevel->getSeed();
@@ -145,6 +196,10 @@ void ServerSideNetworkHandler::handle(const RakNet::RakNetGUID& guid, LoginPacke
 	sgp.m_pos.y -= pPlayer->m_heightOffset;
 	sgp.m_serverVersion = NETWORK_PROTOCOL_VERSION;
 	sgp.m_time = m_pLevel->getTime();
+	sgp.m_bStreamsLevel = true;
+
+	pOnlinePlayer->m_movePos = sgp.m_pos;
+	pOnlinePlayer->m_moveRot = pPlayer->m_rot;
 	
 	RakNet::BitStream sgpbs;
 	sgp.write(&sgpbs);
@@ -164,12 +219,12 @@ void ServerSideNetworkHandler::handle(const RakNet::RakNetGUID& guid, LoginPacke
 
 	m_pLevel->addEntity(pPlayer);
 
-	if (m_pMinecraft->m_pGameMode->isCreativeType())
+	if (pPlayer->getPlayerGameType() == GAME_TYPE_CREATIVE)
 		pPlayer->m_pInventory->prepareCreativeInventory();
 	else
 		pPlayer->m_pInventory->prepareSurvivalInventory();
 
-	m_pMinecraft->m_gui.addMessage(pPlayer->m_name + " joined the game");
+	m_pGameCallbacks->displayMessage(pPlayer->m_name + " joined the game");
 
 	AddPlayerPacket app(pPlayer);
 	RakNet::BitStream appbs;
@@ -238,7 +293,13 @@ void ServerSideNetworkHandler::handle(const RakNet::RakNetGUID& guid, MovePlayer
 
 	pEntity->lerpTo(packet->m_pos, packet->m_rot, 3);
 
-	redistributePacket(packet, guid);
+	// Custom: it's sent on from levelTicked(), as often as each client needs it
+	OnlinePlayer* pOnlinePlayer = getPlayerByGUID(guid);
+	if (!pOnlinePlayer || pOnlinePlayer->m_pPlayer != pEntity)
+		return;
+
+	pOnlinePlayer->m_movePos = packet->m_pos;
+	pOnlinePlayer->m_moveRot = packet->m_rot;
 }
 
 void ServerSideNetworkHandler::handle(const RakNet::RakNetGUID& guid, PlaceBlockPacket* packet)
@@ -291,7 +352,7 @@ void ServerSideNetworkHandler::handle(const RakNet::RakNetGUID& guid, RemoveBloc
 	Tile* pTile = Tile::tiles[m_pLevel->getTile(pos)];
 	int auxValue = m_pLevel->getData(pos);
 
-	m_pMinecraft->m_pParticleEngine->destroyEffect(pos);
+	m_pGameCallbacks->showDestroyEffect(pos);
 
 	bool setTileResult = m_pLevel->setTile(pos, TILE_AIR);
 	if (pTile && setTileResult)
@@ -342,12 +403,22 @@ void ServerSideNetworkHandler::handle(const RakNet::RakNetGUID& guid, RequestChu
 {
 	puts_ignorable("RequestChunkPacket");
 
-	if (packet->m_chunkPos.x == -9999)
+	if (packet->m_chunkPos.x == C_REQUEST_LEVEL_DATA)
 	{
 		m_pRakNetInstance->send(guid, new LevelDataPacket(m_pLevel));
 		return;
 	}
 
+	if (packet->m_chunkPos.x == C_REQUEST_LEVEL_STREAM)
+	{
+		OnlinePlayer* pOnlinePlayer = getPlayerByGUID(guid);
+		if (!pOnlinePlayer)
+			return;
+
+		m_pChunkStreamer->start(guid, m_pLevel, ChunkPos(pOnlinePlayer->m_pPlayer->m_pos));
+		return;
+	}
+
 	LevelChunk* pChunk = m_pLevel->getChunk(packet->m_chunkPos);
 	if (!pChunk)
 	{
@@ -370,27 +441,315 @@ void ServerSideNetworkHandler::tileBrightnessChanged(const TilePos& pos)
 
 void ServerSideNetworkHandler::tileChanged(const TilePos& pos)
 {
-	UpdateBlockPacket ubp;
-	ubp.m_pos = pos;
-	ubp.m_tileTypeId = m_pLevel->getTile(pos);
-	ubp.m_data = m_pLevel->getData(pos);
+	// An explosion or a flowing liquid changes hundreds of tiles in a tick, so
+	// they're gathered per chunk and sent together at the end of the tick.
+	m_changedTiles[ChunkPos(pos)].insert(pos);
+}
 
-	RakNet::BitStream bs;
-	ubp.write(&bs);
+void ServerSideNetworkHandler::levelTicked()
+{
+	_flushChangedTiles();
+	_sendMoves();
 
-	m_pRakNetPeer->Send(&bs, HIGH_PRIORITY, RELIABLE_ORDERED, 0, RakNet::AddressOrGUID(), true);
+	m_nTicks++;
+}
+
+void ServerSideNetworkHandler::_writeChangedTiles(RakNet::BitStream* bs, const ChunkPos& pos, const std::set<TilePos>& tiles)
+{
+	uint8_t updateMap[256];
+	memset(updateMap, 0, sizeof updateMap);
+
+	int nSections = 0;
+	for (std::set<TilePos>::const_iterator it = tiles.begin(); it != tiles.end(); ++it)
+	{
+		uint8_t& column = updateMap[(it->x & 0xF) | ((it->z & 0xF) << 4)];
+		uint8_t bit = uint8_t(1 << (it->y >> 4));
+		if (column & bit)
+			continue;
+
+		column |= bit;
+		nSections++;
+	}
+
+	// A change costs 4 bytes in an UpdateBlocksPacket. A ChunkDataPacket costs
+	// 256 bytes for the column masks, and 24 more for every 16 tile section.
+	if (256 + 24 * nSections < 4 * int(tiles.size()))
+	{
+		ChunkDataPacket cdp(pos, m_pLevel->getChunk(pos), updateMap);
+		cdp.write(bs);
+		return;
+	}
+
+	UpdateBlocksPacket ubp(pos);
+	for (std::set<TilePos>::const_iterator it = tiles.begin(); it != tiles.end(); ++it)
+		ubp.addChange(*it, m_pLevel->getTile(*it), m_pLevel->getData(*it));
+
+	ubp.write(bs);
+}
+
+int ServerSideNetworkHandler::_getMoveInterval(const OnlinePlayer* pTo, const Vec3& pos)
+{
+	Vec3 delta = pos - pTo->m_movePos;
+	float distSqr = delta.x * delta.x + delta.y * delta.y + delta.z * delta.z;
+
+	int interval = 1;
+	float range = C_MOVE_NEAR_DISTANCE;
+	while (distSqr > range * range && interval < C_MOVE_MAX_INTERVAL)
+	{
+		interval *= 2;
+		range *= 2.0f;
+	}
+
+	if (distSqr > C_MOVE_BEHIND_DISTANCE * C_MOVE_BEHIND_DISTANCE)
+	{
+		// the same way Entity::moveRelative turns the yaw into a direction
+		float yaw = pTo->m_moveRot.x * float(M_PI) / 180.0f;
+		float dot = -Mth::sin(yaw) * delta.x + Mth::cos(yaw) * delta.z;
+		if (dot < 0.0f)
+			interval *= 2;
+	}
+
+	return interval;
+}
+
+void ServerSideNetworkHandler::_sendMovesTo(OnlinePlayer* pTo)
+{
+	pTo->m_moveBudget += C_MOVE_BUDGET_PER_SECOND / C_TICKS_PER_SECOND;
+	if (pTo->m_moveBudget > C_MOVE_BUDGET_BURST)
+		pTo->m_moveBudget = C_MOVE_BUDGET_BURST;
+
+	std::vector<PendingMove> pending;
+	for (OnlinePlayerMap::iterator it = m_onlinePlayers.begin(); it != m_onlinePlayers.end(); ++it)
+	{
+		OnlinePlayer* pAbout = it->second;
+		if (pAbout == pTo)
+			continue;
+
+		int interval = _getMoveInterval(pTo, pAbout->m_movePos);
+		int waited = interval;
+
+		SentMoveMap::iterator sent = pTo->m_sentMoves.find(pAbout->m_pPlayer->m_EntityID);
+		if (sent != pTo->m_sentMoves.end())
+		{
+			const SentMove& move = sent->second;
+			if (move.m_pos[0] == MoveEntitiesPacket::packCoord(pAbout->m_movePos.x) &&
+				move.m_pos[1] == MoveEntitiesPacket::packCoord(pAbout->m_movePos.y) &&
+				move.m_pos[2] == MoveEntitiesPacket::packCoord(pAbout->m_movePos.z) &&
+				move.m_rot[0] == MoveEntitiesPacket::packAngle(pAbout->m_moveRot.x) &&
+				move.m_rot[1] == MoveEntitiesPacket::packAngle(pAbout->m_moveRot.y))
+				continue;
+
+			waited = m_nTicks - move.m_tick;
+		}
+
+		if (waited < interval)
+		{
+			pTo->m_nMovesFiltered++;
+			continue;
+		}
+
+		Vec3 delta = pAbout->m_movePos - pTo->m_movePos;
+		pending.push_back(PendingMove(pAbout, float(waited) / float(interval), delta.x * delta.x + delta.y * delta.y + delta.z * delta.z));
+	}
+
+	if (pending.empty())
+		return;
+
+	std::sort(pending.begin(), pending.end());
+
+	MoveEntitiesPacket mep;
+	int budget = pTo->m_moveBudget;
+
+	for (size_t i = 0; i < pending.size(); i++)
+	{
+		OnlinePlayer* pAbout = pending[i].m_pAbout;
+		int id = pAbout->m_pPlayer->m_EntityID;
+
+		if (!pTo->m_bTakesPackedMoves)
+		{
+			// older clients still get a MovePlayerPacket per player
+			MovePlayerPacket mpp(id, pAbout->m_movePos, pAbout->m_moveRot);
+			RakNet::BitStream bs;
+			mpp.write(&bs);
+
+			int size = int(bs.GetNumberOfBytesUsed());
+			if (size > budget)
+			{
+				pTo->m_nMovesDeferred += int(pending.size() - i);
+				break;
+			}
+
+			m_pRakNetPeer->Send(&bs, HIGH_PRIORITY, RELIABLE_ORDERED, 0, pTo->m_guid, false);
+			budget -= size;
+			pTo->m_nMoveBytes += size;
+		}
+		else
+		{
+			MoveEntitiesPacket::Move move;
+			move.m_id = id;
+			move.m_flags = MoveEntitiesPacket::MOVE_POS | MoveEntitiesPacket::MOVE_ROT;
+			move.m_pos[0] = MoveEntitiesPacket::packCoord(pAbout->m_movePos.x);
+			move.m_pos[1] = MoveEntitiesPacket::packCoord(pAbout->m_movePos.y);
+			move.m_pos[2] = MoveEntitiesPacket::packCoord(pAbout->m_movePos.z);
+			move.m_rot[0] = MoveEntitiesPacket::packAngle(pAbout->m_moveRot.x);
+			move.m_rot[1] = MoveEntitiesPacket::packAngle(pAbout->m_moveRot.y);
+
+			// the flags and the ID take 3 bytes
+			int size = 3 + 6 + 2;
+
+			SentMoveMap::iterator sent = pTo->m_sentMoves.find(id);
+			if (sent != pTo->m_sentMoves.end())
+			{
+				const SentMove& last = sent->second;
+				int delta[3];
+				bool bFits = true;
+				for (int j = 0; j < 3; j++)
+				{
+					delta[j] = move.m_pos[j] - last.m_pos[j];
+					if (delta[j] < -128 || delta[j] > 127)
+						bFits = false;
+				}
+
+				if (bFits)
+				{
+					bool bMoved = delta[0] || delta[1] || delta[2];
+					bool bTurned = move.m_rot[0] != last.m_rot[0] || move.m_rot[1] != last.m_rot[1];
+
+					move.m_flags = (bMoved ? MoveEntitiesPacket::MOVE_POS_DELTA : 0) | (bTurned ? MoveEntitiesPacket::MOVE_ROT : 0);
+					size = 3 + (bMoved ? 3 : 0) + (bTurned ? 2 : 0);
+				}
+
+				for (int j = 0; j < 3 && bFits; j++)
+					move.m_pos[j] = int16_t(delta[j]);
+			}
+
+			if (size > budget || mep.m_moves.size() >= C_MAX_PACKED_MOVES)
+			{
+				pTo->m_nMovesDeferred += int(pending.size() - i);
+				break;
+			}
+
+			mep.m_moves.push_back(move);
+			budget -= size;
+		}
+
+		SentMove& sent = pTo->m_sentMoves[id];
+		sent.m_pos[0] = MoveEntitiesPacket::packCoord(pAbout->m_movePos.x);
+		sent.m_pos[1] = MoveEntitiesPacket::packCoord(pAbout->m_movePos.y);
+		sent.m_pos[2] = MoveEntitiesPacket::packCoord(pAbout->m_movePos.z);
+		sent.m_rot[0] = MoveEntitiesPacket::packAngle(pAbout->m_moveRot.x);
+		sent.m_rot[1] = MoveEntitiesPacket::packAngle(pAbout->m_moveRot.y);
+		sent.m_tick = m_nTicks;
+
+		pTo->m_nMovesSent++;
+	}
+
+	if (!mep.m_moves.empty())
+	{
+		RakNet::BitStream bs;
+		mep.write(&bs);
+		m_pRakNetPeer->Send(&bs, HIGH_PRIORITY, RELIABLE_ORDERED, 0, pTo->m_guid, false);
+
+		// charge what was actually written
+		budget = pTo->m_moveBudget - int(bs.GetNumberOfBytesUsed());
+		pTo->m_nMoveBytes += bs.GetNumberOfBytesUsed();
+	}
+
+	pTo->m_moveBudget = budget;
+}
+
+void ServerSideNetworkHandler::_sendMoves()
+{
+	// the host's player doesn't send MovePlayerPackets
+	Player* pLocalPlayer = m_pGameCallbacks->getHostPlayer();
+	OnlinePlayer* pLocal = pLocalPlayer ? getPlayerByGUID(pLocalPlayer->m_guid) : nullptr;
+	if (pLocal)
+	{
+		pLocal->m_movePos = pLocalPlayer->m_pos;
+		pLocal->m_movePos.y -= pLocalPlayer->m_heightOffset;
+		pLocal->m_moveRot = pLocalPlayer->m_rot;
+	}
+
+	for (OnlinePlayerMap::iterator it = m_onlinePlayers.begin(); it != m_onlinePlayers.end(); ++it)
+	{
+		if (it->second != pLocal)
+			_sendMovesTo(it->second);
+	}
+}
+
+void ServerSideNetworkHandler::_flushChangedTiles()
+{
+	if (m_changedTiles.empty())
+		return;
+
+	RakNet::RakNetGUID localGuid = m_pRakNetPeer->GetMyGUID();
+
+	std::vector<RakNet::RakNetGUID> batchGuids, singleGuids;
+	for (OnlinePlayerMap::iterator it = m_onlinePlayers.begin(); it != m_onlinePlayers.end(); ++it)
+	{
+		if (it->first == localGuid)
+			continue;
+
+		if (it->second->m_bTakesTileBatches)
+			batchGuids.push_back(it->first);
+		else
+			singleGuids.push_back(it->first);
+	}
+
+	for (ChangedTileMap::iterator it = m_changedTiles.begin(); it != m_changedTiles.end(); ++it)
+	{
+		const std::set<TilePos>& tiles = it->second;
+
+		if (!batchGuids.empty() && m_pLevel->getChunk(it->first))
+		{
+			RakNet::BitStream bs;
+			_writeChangedTiles(&bs, it->first, tiles);
+
+			for (size_t i = 0; i < batchGuids.size(); i++)
+				m_pRakNetPeer->Send(&bs, HIGH_PRIORITY, RELIABLE_ORDERED, 0, batchGuids[i], false);
+
+			m_nTileChangesSent += int(tiles.size() * batchGuids.size());
+			m_nTileChangePackets += int(batchGuids.size());
+			m_nTileChangeBytes += int64_t(bs.GetNumberOfBytesUsed() * batchGuids.size());
+		}
+
+		if (singleGuids.empty())
+			continue;
+
+		// older clients still get one packet per tile
+		for (std::set<TilePos>::const_iterator jt = tiles.begin(); jt != tiles.end(); ++jt)
+		{
+			UpdateBlockPacket ubp;
+			ubp.m_pos = *jt;
+			ubp.m_tileTypeId = m_pLevel->getTile(*jt);
+			ubp.m_data = m_pLevel->getData(*jt);
+
+			RakNet::BitStream bs;
+			ubp.write(&bs);
+
+			for (size_t i = 0; i < singleGuids.size(); i++)
+				m_pRakNetPeer->Send(&bs, HIGH_PRIORITY, RELIABLE_ORDERED, 0, singleGuids[i], false);
+
+			m_nTileChangesSent += int(singleGuids.size());
+			m_nTileChangePackets += int(singleGuids.size());
+			m_nTileChangeBytes += int64_t(bs.GetNumberOfBytesUsed() * singleGuids.size());
+		}
+	}
+
+	m_changedTiles.clear();
 }
 
 void ServerSideNetworkHandler::timeChanged(uint32_t time)
 {
-	m_pRakNetInstance->send(new SetTimePacket(time));
+	SetTimePacket packet(time);
+	m_pRakNetInstance->send(packet);
 }
 
 void ServerSideNetworkHandler::allowIncomingConnections(bool b)
 {
 	if (b)
 	{
-		m_pRakNetInstance->announceServer(m_pMinecraft->getOptions()->m_playerName);
+		m_pRakNetInstance->announceServer(m_pGameCallbacks->getServerName());
 	}
 	else
 	{
@@ -402,7 +761,7 @@ void ServerSideNetworkHandler::allowIncomingConnections(bool b)
 
 void ServerSideNetworkHandler::displayGameMessage(const std::string& msg)
 {
-	m_pMinecraft->m_gui.addMessage(msg);
+	m_pGameCallbacks->displayMessage(msg);
 	m_pRakNetInstance->send(new MessagePacket(msg));
 }
 
@@ -410,7 +769,7 @@ void ServerSideNetworkHandler::sendMessage(const RakNet::RakNetGUID& guid, const
 {
 	if (m_pRakNetPeer->GetMyGUID() == guid)
 	{
-		m_pMinecraft->m_gui.addMessage(msg);
+		m_pGameCallbacks->displayMessage(msg);
 		return;
 	}
 
@@ -458,7 +817,7 @@ void ServerSideNetworkHandler::setupCommands()
 
 bool ServerSideNetworkHandler::_checkPermissions(OnlinePlayer* player)
 {
-	if (player->m_pPlayer != m_pMinecraft->m_pLocalPlayer)
+	if (player->m_pPlayer != m_pGameCallbacks->getHostPlayer())
 	{
 		sendMessage(player, "Sorry, only the host can use this command at the moment");
 		return false;
@@ -503,7 +862,7 @@ void ServerSideNetworkHandler::commandStats(OnlinePlayer* player, const std::vec
 
 	std::stringstream ss;
 	ss << "Server uptime: " << getTimeS() << " seconds.\n";
-	ss << "Host's name: " << m_pMinecraft->m_pUser->field_0 << "\n";
+	ss << "Host's name: " << m_pGameCallbacks->getServerName() << "\n";
 
 	int nPlayers = int(m_onlinePlayers.size());
 	if (nPlayers == 1)
@@ -511,6 +870,24 @@ void ServerSideNetworkHandler::commandStats(OnlinePlayer* player, const std::vec
 	else
 		ss << "There are " << nPlayers << " players online.";
 
+	ss << "\nStreamed " << m_pChunkStreamer->getSentCount() << " chunks, "
+	   << m_pChunkStreamer->getSentBytes() / 1024 << " KB (" << m_pChunkStreamer->getUncompressedBytes() / 1024 << " KB uncompressed). "
+	   << m_pChunkStreamer->getStreamCount() << " streams running.";
+
+	ss << "\nSent " << m_nTileChangesSent << " tile changes in " << m_nTileChangePackets << " packets, "
+	   << m_nTileChangeBytes / 1024 << " KB.";
+
+	for (OnlinePlayerMap::iterator it = m_onlinePlayers.begin(); it != m_onlinePlayers.end(); ++it)
+	{
+		OnlinePlayer* pOP = it->second;
+		if (pOP->m_pPlayer == m_pGameCallbacks->getHostPlayer())
+			continue;
+
+		ss << "\n" << pOP->m_pPlayer->m_name << ": " << pOP->m_nMovesSent << " moves, " << pOP->m_nMoveBytes / 1024 << " KB, "
+		   << pOP->m_nMovesDeferred << " deferred, " << pOP->m_nMovesFiltered << " filtered. Budget: "
+		   << pOP->m_moveBudget << "/" << C_MOVE_BUDGET_BURST << " bytes, " << C_MOVE_BUDGET_PER_SECOND << " per second.";
+	}
+
 	sendMessage(player, ss.str());
 }
 
@@ -830,7 +1207,7 @@ void ServerSideNetworkHandler::handle(const RakNet::RakNetGUID& guid, CraftingPa
 	}
 
 	// Perform the crafting
-	if (m_pMinecraft->m_pGameMode->handleCrafting(pOP->m_pPlayer, grid)) {
+	if (m_pGameCallbacks->handleCrafting(pOP->m_pPlayer, grid)) {
 		sendMessage(pOP, "Crafting successful");
 		// Redistribute crafting packet to other clients for inventory sync
 		redistributePacket(packet, guid);
@@ -888,7 +1265,7 @@ void ServerSideNetworkHandler::commandCraft(OnlinePlayer* player, const std::vec
 	}
 
 	// Test the crafting
-	if (m_pMinecraft->m_pGameMode->handleCrafting(pPlayer, grid)) {
+	if (m_pGameCallbacks->handleCrafting(pPlayer, grid)) {
 		sendMessage(player, "Crafting successful! Check your inventory.");
 	} else {
 		sendMessage(player, "Crafting failed. Check recipe or inventory space.");
@@ -9,25 +9,59 @@
 #pragma once
 
 #include <map>
+#include <set>
 #include "NetEventCallback.hpp"
-#include "client/app/Minecraft.hpp"
+#include "GameCallbacks.hpp"
 #include "RakNetInstance.hpp"
+#include "ChunkStreamer.hpp"
+#include "world/level/Level.hpp"
 #include "world/level/LevelListener.hpp"
 
-class Minecraft;
 class ServerSideNetworkHandler;
 
+// Custom: the movement a client was last sent about an entity, as packed in a MoveEntitiesPacket
+struct SentMove
+{
+	int16_t m_pos[3];
+	uint8_t m_rot[2];
+	int m_tick;
+};
+
+typedef std::map<int, SentMove> SentMoveMap;
+
 struct OnlinePlayer
 {
 	Player* m_pPlayer; // The player avatar this online player controls
 	RakNet::RakNetGUID m_guid;
 
-	OnlinePlayer(Player* p, const RakNet::RakNetGUID& guid) : m_pPlayer(p), m_guid(guid) {}
+	// Custom
+	bool m_bTakesTileBatches;
+	bool m_bTakesPackedMoves;
+	Vec3 m_movePos; // Where the client last said its player is, at its feet
+	Vec2 m_moveRot;
+	SentMoveMap m_sentMoves; // By entity ID
+	int m_moveBudget; // How many bytes of movement the client can be sent right now
+	int m_nMovesSent;
+	int m_nMovesDeferred; // Were due, but went over the budget
+	int m_nMovesFiltered; // Weren't due yet, because the entity is far away or out of view
+	int64_t m_nMoveBytes;
+
+	OnlinePlayer(Player* p, const RakNet::RakNetGUID& guid) : m_pPlayer(p), m_guid(guid)
+	{
+		m_bTakesTileBatches = false;
+		m_bTakesPackedMoves = false;
+		m_moveBudget = 0;
+		m_nMovesSent = 0;
+		m_nMovesDeferred = 0;
+		m_nMovesFiltered = 0;
+		m_nMoveBytes = 0;
+	}
 };
 
 typedef void(ServerSideNetworkHandler::* CommandFunction)(OnlinePlayer* player, const std::vector<std::string>& parms);
 typedef std::map<std::string, CommandFunction> CommandMap;
 typedef std::map<RakNet::RakNetGUID, OnlinePlayer*> OnlinePlayerMap;
+typedef std::map<ChunkPos, std::set<TilePos> > ChangedTileMap;
 
 // @TODO: Rename to ServerNetworkHandler?
 class ServerSideNetworkHandler : public NetEventCallback, public LevelListener
@@ -35,18 +69,22 @@ class ServerSideNetworkHandler : public NetEventCallback, public LevelListener
 private:
 	bool _checkPermissions(OnlinePlayer* player);
 	bool _validateNum(OnlinePlayer* player, int value, int min, int max);
+	void _flushChangedTiles();
+	void _writeChangedTiles(RakNet::BitStream* bs, const ChunkPos& pos, const std::set<TilePos>& tiles);
+	void _sendMoves();
+	void _sendMovesTo(OnlinePlayer* pTo);
+	int _getMoveInterval(const OnlinePlayer* pTo, const Vec3& pos);
 
 public:
 
-	// @TODO: We can do the following to finally split Network code from Client code
-	// ServerSideNetworkHandler(GameCallbacks *gameCallbacks, Level* level, GameMode* gameMode, RakNetInstance* rakNetInstance, PacketSender* packetSender, Player* localPlayer);
-	ServerSideNetworkHandler(Minecraft* minecraft, RakNetInstance* rakNetInstance);
+	ServerSideNetworkHandler(GameCallbacks* gameCallbacks, RakNetInstance* rakNetInstance);
 	~ServerSideNetworkHandler();
 
 	// Overridden from NetEventCallback
 	void levelGenerated(Level*) override;
 	void onNewClient(const RakNet::RakNetGUID&) override;
 	void onDisconnect(const RakNet::RakNetGUID&) override;
+	void tick() override;
 	void handle(const RakNet::RakNetGUID&, LoginPacket*) override;
 	void handle(const RakNet::RakNetGUID&, MessagePacket*) override;
 	void handle(const RakNet::RakNetGUID&, MovePlayerPacket*) override;
@@ -60,6 +98,7 @@ public:
 	void tileBrightnessChanged(const TilePos& pos) override;
 	void tileChanged(const TilePos& pos) override;
 	void timeChanged(uint32_t time) override;
+	void levelTicked() override;
 
 	void allowIncomingConnections(bool b);
 	void displayGameMessage(const std::string&);
@@ -84,13 +123,21 @@ public:
 	void commandCraft    (OnlinePlayer*, const std::vector<std::string>&);
 
 public:
-	Minecraft* m_pMinecraft;
+	GameCallbacks* m_pGameCallbacks;
 	Level* m_pLevel;
 	RakNetInstance* m_pRakNetInstance;
 	RakNet::RakPeerInterface* m_pRakNetPeer;
 	bool m_bAllowIncoming;
+	ChunkStreamer* m_pChunkStreamer;
 
 	OnlinePlayerMap m_onlinePlayers;
 	CommandMap m_commands;
+
+	// Custom: the tiles that changed this tick, sent out by levelTicked()
+	ChangedTileMap m_changedTiles;
+	int m_nTileChangesSent;
+	int m_nTileChangePackets;
+	int64_t m_nTileChangeBytes;
+	int m_nTicks;
 };
 
@@ -23,17 +23,19 @@ void ChunkDataPacket::write(RakNet::BitStream* bs)
 	// Well, we first have to prepare the data.
 	m_data.Reset();
 
+	const uint8_t* updateMap = m_pUpdateMap ? m_pUpdateMap : m_pChunk->m_updateMap;
+
 	for (int i = 0; i < 256; i++)
 	{
-		m_data.Write(m_pChunk->m_updateMap[i]);
+		m_data.Write(updateMap[i]);
 
 		// if nothing was updated:
-		if (!m_pChunk->m_updateMap[i])
+		if (!updateMap[i])
 			continue;
 
 		for (int y = 0; y < 8; y++)
 		{
-			if ((m_pChunk->m_updateMap[i] >> y) & 1)
+			if ((updateMap[i] >> y) & 1)
 			{
 				int idx = ((i & 0xF) << 11) | ((i >> 4) << 7) + (y * 16);
 				//write the tile data
@@ -0,0 +1,48 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+	
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#include "../Packet.hpp"
+
+// a ChunkDataPacket with every section filled in is about 50 KB
+#define C_MAX_CHUNK_DATA_SIZE (64 * 1024)
+
+void CompressedChunkDataPacket::handle(const RakNet::RakNetGUID& guid, NetEventCallback* pCallback)
+{
+	pCallback->handle(guid, this);
+}
+
+void CompressedChunkDataPacket::write(RakNet::BitStream* bs)
+{
+	bs->Write((unsigned char)PACKET_COMPRESSED_CHUNK_DATA);
+	bs->Write(m_uncompSize);
+
+	int size = int(m_data.GetNumberOfBytesUsed());
+	bs->Write(size);
+	bs->Write((const char*)m_data.GetData(), size);
+}
+
+void CompressedChunkDataPacket::read(RakNet::BitStream* bs)
+{
+	m_data.Reset();
+
+	int size = 0;
+	if (!bs->Read(m_uncompSize) || !bs->Read(size))
+		return;
+
+	if (m_uncompSize < 0 || m_uncompSize > C_MAX_CHUNK_DATA_SIZE || size <= 0 || size > C_MAX_CHUNK_DATA_SIZE)
+	{
+		LOG_W("Dropping a compressed chunk with bad sizes (%d, %d)", m_uncompSize, size);
+		m_uncompSize = 0;
+		return;
+	}
+
+	if (bs->GetNumberOfUnreadBits() < RakNet::BitSize_t(size) * 8)
+		return;
+
+	m_data.Write(*bs, RakNet::BitSize_t(size) * 8);
+}
@@ -19,6 +19,9 @@ void LoginPacket::write(RakNet::BitStream* bs)
 	bs->Write(m_str);
 	bs->Write(m_clientNetworkVersion);
 	bs->Write(m_clientNetworkVersion2);
+	// older servers stop reading before this
+	bs->Write<uint8_t>(m_bTakesTileBatches);
+	bs->Write<uint8_t>(m_bTakesPackedMoves);
 }
 
 void LoginPacket::read(RakNet::BitStream* bs)
@@ -28,4 +31,13 @@ void LoginPacket::read(RakNet::BitStream* bs)
 	if (!bs->Read(m_clientNetworkVersion))
 		return;
 	bs->Read(m_clientNetworkVersion2);
+
+	// older clients don't send this
+	uint8_t takesTileBatches = 0;
+	if (bs->Read(takesTileBatches))
+		m_bTakesTileBatches = takesTileBatches != 0;
+
+	uint8_t takesPackedMoves = 0;
+	if (bs->Read(takesPackedMoves))
+		m_bTakesPackedMoves = takesPackedMoves != 0;
 }
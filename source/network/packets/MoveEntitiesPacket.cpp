@@ -0,0 +1,138 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+	
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#include "../Packet.hpp"
+#include "common/Mth.hpp"
+
+#define C_COORD_SCALE (32.0f)
+#define C_ANGLE_SCALE (256.0f / 360.0f)
+
+void MoveEntitiesPacket::handle(const RakNet::RakNetGUID& guid, NetEventCallback* pCallback)
+{
+	pCallback->handle(guid, this);
+}
+
+int16_t MoveEntitiesPacket::packCoord(float f)
+{
+	int i = Mth::floor(f * C_COORD_SCALE + 0.5f);
+	if (i < -32768) i = -32768;
+	if (i > 32767) i = 32767;
+	return int16_t(i);
+}
+
+float MoveEntitiesPacket::unpackCoord(int i)
+{
+	return float(i) / C_COORD_SCALE;
+}
+
+uint8_t MoveEntitiesPacket::packAngle(float f)
+{
+	return uint8_t(Mth::floor(f * C_ANGLE_SCALE + 0.5f) & 0xFF);
+}
+
+float MoveEntitiesPacket::unpackAngle(uint8_t i)
+{
+	// -180 to 180 degrees, so the pitch comes out right
+	return float(int8_t(i)) / C_ANGLE_SCALE;
+}
+
+void MoveEntitiesPacket::write(RakNet::BitStream* bs)
+{
+	bs->Write((unsigned char)PACKET_MOVE_ENTITIES);
+	bs->Write<uint8_t>(uint8_t(m_moves.size()));
+
+	for (size_t i = 0; i < m_moves.size(); i++)
+	{
+		const Move& move = m_moves[i];
+		uint8_t flags = move.m_flags & ~MOVE_WIDE_ID;
+		if (move.m_id < 0 || move.m_id > 0xFFFF)
+			flags |= MOVE_WIDE_ID;
+
+		bs->Write(flags);
+		if (flags & MOVE_WIDE_ID)
+			bs->Write(move.m_id);
+		else
+			bs->Write<uint16_t>(uint16_t(move.m_id));
+
+		if (move.m_flags & MOVE_POS_DELTA)
+		{
+			for (int j = 0; j < 3; j++)
+				bs->Write<int8_t>(int8_t(move.m_pos[j]));
+		}
+		else if (move.m_flags & MOVE_POS)
+		{
+			for (int j = 0; j < 3; j++)
+				bs->Write(move.m_pos[j]);
+		}
+
+		if (move.m_flags & MOVE_ROT)
+		{
+			bs->Write(move.m_rot[0]);
+			bs->Write(move.m_rot[1]);
+		}
+	}
+}
+
+void MoveEntitiesPacket::read(RakNet::BitStream* bs)
+{
+	m_moves.clear();
+
+	uint8_t count = 0;
+	if (!bs->Read(count))
+		return;
+
+	for (int i = 0; i < int(count); i++)
+	{
+		Move move;
+		move.m_pos[0] = move.m_pos[1] = move.m_pos[2] = 0;
+		move.m_rot[0] = move.m_rot[1] = 0;
+
+		if (!bs->Read(move.m_flags))
+			return;
+
+		if (move.m_flags & MOVE_WIDE_ID)
+		{
+			if (!bs->Read(move.m_id))
+				return;
+		}
+		else
+		{
+			uint16_t id = 0;
+			if (!bs->Read(id))
+				return;
+			move.m_id = id;
+		}
+
+		if (move.m_flags & MOVE_POS_DELTA)
+		{
+			for (int j = 0; j < 3; j++)
+			{
+				int8_t delta = 0;
+				if (!bs->Read(delta))
+					return;
+				move.m_pos[j] = delta;
+			}
+		}
+		else if (move.m_flags & MOVE_POS)
+		{
+			for (int j = 0; j < 3; j++)
+			{
+				if (!bs->Read(move.m_pos[j]))
+					return;
+			}
+		}
+
+		if (move.m_flags & MOVE_ROT)
+		{
+			if (!bs->Read(move.m_rot[0]) || !bs->Read(move.m_rot[1]))
+				return;
+		}
+
+		m_moves.push_back(move);
+	}
+}
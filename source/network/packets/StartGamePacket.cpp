@@ -30,6 +30,8 @@ void StartGamePacket::write(RakNet::BitStream* bs)
 	if (m_serverVersion >= 1)
 	{
 		bs->Write(m_time);
+		// older clients stop reading before this
+		bs->Write<uint8_t>(m_bStreamsLevel);
 	}
 }
 
@@ -54,4 +56,9 @@ void StartGamePacket::read(RakNet::BitStream* bs)
 		return;
 	
 	bs->Read(m_time);
+
+	// older servers don't send this
+	uint8_t streamsLevel = 0;
+	if (bs->Read(streamsLevel))
+		m_bStreamsLevel = streamsLevel != 0;
 }
\ No newline at end of file
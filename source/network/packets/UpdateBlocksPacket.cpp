@@ -0,0 +1,69 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+	
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#include "../Packet.hpp"
+
+// every tile of a chunk
+#define C_MAX_CHANGES (16 * 16 * 128)
+
+void UpdateBlocksPacket::handle(const RakNet::RakNetGUID& guid, NetEventCallback* pCallback)
+{
+	pCallback->handle(guid, this);
+}
+
+void UpdateBlocksPacket::addChange(const TilePos& pos, TileID tile, TileData data)
+{
+	Change change;
+	change.m_pos = uint16_t((pos.x & 0xF) | ((pos.z & 0xF) << 4) | ((pos.y & 0x7F) << 8));
+	change.m_tile = tile;
+	change.m_data = data;
+	m_changes.push_back(change);
+}
+
+TilePos UpdateBlocksPacket::getChangePos(const Change& change) const
+{
+	return TilePos(m_chunkPos.x * 16 + (change.m_pos & 0xF), change.m_pos >> 8, m_chunkPos.z * 16 + ((change.m_pos >> 4) & 0xF));
+}
+
+void UpdateBlocksPacket::write(RakNet::BitStream* bs)
+{
+	bs->Write((unsigned char)PACKET_UPDATE_BLOCKS);
+	bs->Write(m_chunkPos.x);
+	bs->Write(m_chunkPos.z);
+	bs->Write<uint16_t>(uint16_t(m_changes.size()));
+
+	for (size_t i = 0; i < m_changes.size(); i++)
+	{
+		bs->Write(m_changes[i].m_pos);
+		bs->Write(m_changes[i].m_tile);
+		bs->Write(m_changes[i].m_data);
+	}
+}
+
+void UpdateBlocksPacket::read(RakNet::BitStream* bs)
+{
+	m_changes.clear();
+
+	uint16_t count = 0;
+	if (!bs->Read(m_chunkPos.x) || !bs->Read(m_chunkPos.z) || !bs->Read(count))
+		return;
+
+	if (count > C_MAX_CHANGES)
+		return;
+
+	m_changes.resize(count);
+	for (int i = 0; i < int(count); i++)
+	{
+		Change& change = m_changes[i];
+		if (!bs->Read(change.m_pos) || !bs->Read(change.m_tile) || !bs->Read(change.m_data))
+		{
+			m_changes.resize(i);
+			return;
+		}
+	}
+}
@@ -20,6 +20,7 @@ void Entity::_init()
 {
 	m_bInAChunk = false;
 	m_chunkPos = ChunkPos(0, 0);
+	m_entityGridCell = -1;
 	field_20 = 0;
 	field_24 = 0;
 	field_28 = 0;
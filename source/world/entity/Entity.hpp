@@ -188,6 +188,7 @@ public:
 	bool m_bInAChunk;
 	ChunkPos m_chunkPos;
 	int m_chunkPosY;
+	int m_entityGridCell; // Custom: where the Level's EntityGrid has it filed, -1 if it doesn't
 	int field_20; // unused Vec3?
 	int field_24;
 	int field_28;
@@ -8,6 +8,7 @@
 
 #include "LocalPlayer.hpp"
 #include "client/app/Minecraft.hpp"
+#include "client/gui/screens/FurnaceScreen.hpp"
 #include "nbt/CompoundTag.hpp"
 
 int dword_250ADC, dword_250AE0;
@@ -94,6 +95,15 @@ void LocalPlayer::setPlayerGameType(GameType gameType)
 	Player::setPlayerGameType(gameType);
 }
 
+bool LocalPlayer::openFurnace(const TilePos& pos)
+{
+	if (!m_pMinecraft)
+		return false;
+
+	m_pMinecraft->setScreen(new FurnaceScreen(this, pos));
+	return true;
+}
+
 void LocalPlayer::animateRespawn()
 {
 
@@ -248,7 +258,12 @@ void LocalPlayer::tick()
 			fabsf(field_C30.y - m_rot.y) > 1.0f ||
 			fabsf(field_C30.x - m_rot.x) > 1.0f)
 		{
-			m_pMinecraft->m_pRakNetInstance->send(new MovePlayerPacket(m_EntityID, Vec3(m_pos.x, m_pos.y - m_heightOffset, m_pos.z), m_rot));
+			// Custom: the server sends the host's movement on along with everyone else's
+			if (!m_pMinecraft->m_pRakNetInstance->m_bIsHost)
+			{
+				MovePlayerPacket packet(m_EntityID, Vec3(m_pos.x, m_pos.y - m_heightOffset, m_pos.z), m_rot);
+				m_pMinecraft->m_pRakNetInstance->send(packet);
+			}
 			field_C24 = m_pos;
 			field_C30 = m_rot;
 		}
@@ -256,7 +271,8 @@ void LocalPlayer::tick()
 		if (field_C38 != m_pInventory->getSelectedItemId())
 		{
 			field_C38 = m_pInventory->getSelectedItemId();
-			m_pMinecraft->m_pRakNetInstance->send(new PlayerEquipmentPacket(m_EntityID, field_C38));
+			PlayerEquipmentPacket packet(m_EntityID, field_C38);
+			m_pMinecraft->m_pRakNetInstance->send(packet);
 		}
 	}
 }
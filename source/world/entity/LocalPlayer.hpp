@@ -32,6 +32,7 @@ public:
 	virtual void drop(const ItemInstance& item, bool randomly = false) override;
 	virtual bool isImmobile() const override;
 	virtual void setPlayerGameType(GameType gameType) override;
+	virtual bool openFurnace(const TilePos& pos) override;
 
 	void calculateFlight(const Vec3& pos);
 	void closeContainer(); //@HUH: oddly enough not a virtual/override
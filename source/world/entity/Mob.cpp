@@ -680,7 +680,8 @@ void Mob::aiStep()
 	AABB aabb = m_hitbox;
 	aabb.grow(0.2f, 0.2f, 0.2f);
 
-	EntityVector ents = m_pLevel->getEntities(this, aabb);
+	EntityVector& ents = m_nearbyEntities;
+	m_pLevel->getEntities(this, aabb, ents);
 	for (EntityVector::iterator it = ents.begin(); it != ents.end(); it++)
 	{
 		Entity* pEnt = *it;
@@ -143,4 +143,7 @@ public:
 
 	bool m_bSwinging;
 	int m_swingTime;
+
+	// Custom: what Level::getEntities found around it, kept so that it doesn't have to reallocate every tick
+	std::vector<Entity*> m_nearbyEntities;
 };
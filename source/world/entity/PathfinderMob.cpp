@@ -15,6 +15,16 @@ PathfinderMob::PathfinderMob(Level* pLevel) : Mob(pLevel)
 	m_pAttackTarget = nullptr;
 	m_bHoldGround = false;
 	field_BA4 = 0;
+	m_bPathRequested = false;
+	m_pathRequestDist = 0.0f;
+	m_pathRequestRange = 0;
+}
+
+PathfinderMob::~PathfinderMob()
+{
+	// Custom: the level only keeps a pointer to us while we wait for a path
+	if (m_bPathRequested && m_pLevel)
+		m_pLevel->cancelPathRequest(this);
 }
 
 Entity* PathfinderMob::getAttackTarget()
@@ -77,7 +87,7 @@ void PathfinderMob::findRandomStrollLocation()
 
 	if (foundLocation)
 	{
-		m_pLevel->findPath(&m_path, this, pos, 10.0f);
+		requestPath(pos, 10.0f);
 	}
 }
 
@@ -126,12 +136,12 @@ void PathfinderMob::updateAi()
 	{
 		m_pAttackTarget = findAttackTarget();
 		if (m_pAttackTarget)
-			m_pLevel->findPath(&m_path, this, m_pAttackTarget, 16.0f);
+			requestPath(m_pAttackTarget, 16.0f);
 	}
 
 	if (!m_bHoldGround && m_pAttackTarget && (m_path.empty() || m_random.nextInt(20) != 0))
 	{
-		m_pLevel->findPath(&m_path, this, m_pAttackTarget, 16.0f);
+		requestPath(m_pAttackTarget, 16.0f);
 	}
 	else if (!m_bHoldGround && ((m_path.empty() && m_random.nextInt(180) == 0) || field_BA4 > 0 || m_random.nextInt(120) == 0))
 	{
@@ -230,3 +240,35 @@ bool PathfinderMob::isPathFinding()
 {
 	return !m_path.empty();
 }
+
+void PathfinderMob::requestPath(const Entity* pTarget, float maxDist)
+{
+	if (!m_bPathRequested)
+		m_pLevel->requestPath(this);
+
+	// aimed at, and looked for around the mob, the way Level::findPath does
+	m_bPathRequested = true;
+	m_pathRequestPos = Vec3(pTarget->m_pos.x, pTarget->m_hitbox.min.y, pTarget->m_pos.z);
+	m_pathRequestDist = maxDist;
+	m_pathRequestRange = int(maxDist + 16);
+}
+
+void PathfinderMob::requestPath(const TilePos& pos, float maxDist)
+{
+	if (!m_bPathRequested)
+		m_pLevel->requestPath(this);
+
+	m_bPathRequested = true;
+	m_pathRequestPos = Vec3(pos);
+	m_pathRequestPos.x += 0.5f;
+	m_pathRequestPos.y += 0.01f;
+	m_pathRequestPos.z += 0.5f;
+	m_pathRequestDist = maxDist;
+	m_pathRequestRange = int(maxDist + 8);
+}
+
+void PathfinderMob::findRequestedPath(PathFinder& pathFinder, Region& region)
+{
+	m_bPathRequested = false;
+	m_pLevel->findPath(pathFinder, region, &m_path, this, m_pathRequestPos, m_pathRequestDist);
+}
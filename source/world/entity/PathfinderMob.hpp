@@ -10,10 +10,14 @@
 #include "Mob.hpp"
 #include "world/level/path/Path.hpp"
 
+class PathFinder;
+class Region;
+
 class PathfinderMob : public Mob
 {
 public:
 	PathfinderMob(Level* pLevel);
+	virtual ~PathfinderMob();
 
 	virtual Entity* getAttackTarget();
 	virtual void setAttackTarget(Entity*);
@@ -31,10 +35,23 @@ public:
 	void setPath(Path& path);
 	bool isPathFinding();
 
+	// Custom: the paths asked for during a tick are found before the next one, together with the
+	// other mobs' (see Level::tickEntities). Only the last one asked for in a tick is looked for.
+	void requestPath(const Entity* pTarget, float maxDist);
+	void requestPath(const TilePos& pos, float maxDist);
+	void findRequestedPath(PathFinder& pathFinder, Region& region);
+	void cancelPathRequest() { m_bPathRequested = false; }
+	// how far around the mob the path is looked for, the chunks there have to be loaded
+	int getPathRequestRange() const { return m_pathRequestRange; }
+
 protected:
 	friend class Animal;
 	Entity* m_pAttackTarget;
 	bool m_bHoldGround;
 	int field_BA4;
 	Path m_path;
+	bool m_bPathRequested;
+	Vec3 m_pathRequestPos;
+	float m_pathRequestDist;
+	int m_pathRequestRange;
 };
@@ -185,7 +185,8 @@ void Player::aiStep()
 	AABB scanAABB = m_hitbox;
 	scanAABB.grow(1, 1, 1);
 
-	EntityVector ents = m_pLevel->getEntities(this, scanAABB);
+	EntityVector& ents = m_nearbyEntities;
+	m_pLevel->getEntities(this, scanAABB, ents);
 
 	for (EntityVector::iterator it = ents.begin(); it != ents.end(); it++)
 	{
@@ -391,6 +392,11 @@ void Player::startCrafting(const TilePos& pos)
 
 }
 
+bool Player::openFurnace(const TilePos& pos)
+{
+	return false;
+}
+
 void Player::startStonecutting(const TilePos& pos)
 {
 
@@ -47,6 +47,8 @@ public:
 	virtual void drop(const ItemInstance& item, bool randomly = false);
 	virtual void startCrafting(const TilePos& pos);
 	virtual void startStonecutting(const TilePos& pos);
+	// Custom: returns whether a furnace screen was opened
+	virtual bool openFurnace(const TilePos& pos);
 	virtual void startDestroying();
 	virtual void stopDestroying();
 	virtual bool isLocalPlayer() const { return false; }
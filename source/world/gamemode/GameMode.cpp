@@ -53,7 +53,8 @@ bool GameMode::destroyBlock(Player* player, const TilePos& pos, Facing::Name fac
 
 	if (m_pMinecraft->isOnline())
 	{
-		m_pMinecraft->m_pRakNetInstance->send(new RemoveBlockPacket(player->m_EntityID, pos));
+		RemoveBlockPacket packet(player->m_EntityID, pos);
+		m_pMinecraft->m_pRakNetInstance->send(packet);
 	}
 
 	return true;
@@ -89,7 +89,8 @@ bool SurvivalMode::destroyBlock(Player* player, const TilePos& pos, Facing::Name
 
 		if (m_pMinecraft->isOnline())
 		{
-			m_pMinecraft->m_pRakNetInstance->send(new RemoveBlockPacket(m_pMinecraft->m_pLocalPlayer->m_EntityID, pos));
+			RemoveBlockPacket packet(m_pMinecraft->m_pLocalPlayer->m_EntityID, pos);
+			m_pMinecraft->m_pRakNetInstance->send(packet);
 		}
 	}
 
@@ -0,0 +1,92 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+	
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#include "EntityGrid.hpp"
+#include "common/Mth.hpp"
+#include "world/entity/Entity.hpp"
+
+int EntityGrid::_getCell(int cellX, int cellZ)
+{
+	return cellZ * C_ENTITY_GRID_SIZE_X + cellX;
+}
+
+// anything past the edges goes in the cells along them
+int EntityGrid::_getCellX(float x)
+{
+	int cellX = Mth::floor(x) >> C_ENTITY_GRID_CELL_SHIFT;
+	if (cellX < 0) return 0;
+	if (cellX >= C_ENTITY_GRID_SIZE_X) return C_ENTITY_GRID_SIZE_X - 1;
+	return cellX;
+}
+
+int EntityGrid::_getCellZ(float z)
+{
+	int cellZ = Mth::floor(z) >> C_ENTITY_GRID_CELL_SHIFT;
+	if (cellZ < 0) return 0;
+	if (cellZ >= C_ENTITY_GRID_SIZE_Z) return C_ENTITY_GRID_SIZE_Z - 1;
+	return cellZ;
+}
+
+void EntityGrid::update(Entity* pEnt)
+{
+	int cell = _getCell(_getCellX(pEnt->m_pos.x), _getCellZ(pEnt->m_pos.z));
+	if (cell == pEnt->m_entityGridCell)
+		return;
+
+	remove(pEnt);
+
+	m_cells[cell].push_back(pEnt);
+	pEnt->m_entityGridCell = cell;
+}
+
+void EntityGrid::remove(Entity* pEnt)
+{
+	if (pEnt->m_entityGridCell < 0)
+		return;
+
+	std::vector<Entity*>& entities = m_cells[pEnt->m_entityGridCell];
+	for (size_t i = 0; i < entities.size(); i++)
+	{
+		if (entities[i] != pEnt)
+			continue;
+
+		// the order in a cell doesn't matter
+		entities[i] = entities.back();
+		entities.pop_back();
+		break;
+	}
+
+	pEnt->m_entityGridCell = -1;
+}
+
+void EntityGrid::getEntities(const Entity* pExclude, const AABB& aabb, std::vector<Entity*>& out) const
+{
+	int minX = _getCellX(aabb.min.x - C_ENTITY_GRID_MARGIN);
+	int minZ = _getCellZ(aabb.min.z - C_ENTITY_GRID_MARGIN);
+	int maxX = _getCellX(aabb.max.x + C_ENTITY_GRID_MARGIN);
+	int maxZ = _getCellZ(aabb.max.z + C_ENTITY_GRID_MARGIN);
+
+	for (int z = minZ; z <= maxZ; z++)
+	{
+		for (int x = minX; x <= maxX; x++)
+		{
+			const std::vector<Entity*>& entities = m_cells[_getCell(x, z)];
+			for (size_t i = 0; i < entities.size(); i++)
+			{
+				Entity* pEnt = entities[i];
+				if (pEnt == pExclude)
+					continue;
+
+				if (!aabb.intersect(pEnt->m_hitbox))
+					continue;
+
+				out.push_back(pEnt);
+			}
+		}
+	}
+}
@@ -0,0 +1,43 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+	
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#pragma once
+
+#include <vector>
+#include "common/Utils.hpp"
+#include "world/phys/AABB.hpp"
+
+class Entity;
+
+// Custom: A uniform grid over the columns of the level, for finding the
+// entities around a box without going through every entity in the chunks
+// it touches. Entities are filed by their position, so the box is widened
+// by C_ENTITY_GRID_MARGIN to find hitboxes that hang over from the cells
+// around it, the same as LevelChunk::getEntities does.
+#define C_ENTITY_GRID_CELL_SHIFT (2) // 4x4 tiles per cell
+#define C_ENTITY_GRID_SIZE_X (C_MAX_CHUNKS_X * 16 >> C_ENTITY_GRID_CELL_SHIFT)
+#define C_ENTITY_GRID_SIZE_Z (C_MAX_CHUNKS_Z * 16 >> C_ENTITY_GRID_CELL_SHIFT)
+#define C_ENTITY_GRID_MARGIN (2.0f)
+
+class EntityGrid
+{
+public:
+	// Files the entity in the cell at its position, or moves it there if it's filed elsewhere
+	void update(Entity* pEnt);
+	void remove(Entity* pEnt);
+	// Appends the entities other than pExclude whose hitbox intersects aabb to out
+	void getEntities(const Entity* pExclude, const AABB& aabb, std::vector<Entity*>& out) const;
+
+private:
+	static int _getCell(int cellX, int cellZ);
+	static int _getCellX(float x);
+	static int _getCellZ(float z);
+
+private:
+	std::vector<Entity*> m_cells[C_ENTITY_GRID_SIZE_X * C_ENTITY_GRID_SIZE_Z];
+};
@@ -11,9 +11,40 @@
 #include <algorithm>
 #include "common/Util.hpp"
 #include "world/level/levelgen/chunk/ChunkCache.hpp"
+#include "common/CThread.hpp"
+#include "world/entity/PathfinderMob.hpp"
 #include "Explosion.hpp"
 #include "Region.hpp"
 
+// time lighting may take per tick before the rest waits for the next one
+#define C_LIGHT_UPDATE_BUDGET_MS (4)
+// how many threads look for the paths the mobs asked for, this one included
+#define C_PATH_THREADS (4)
+// how many of the paths the mobs asked for are looked for per tick, the rest wait for the next one
+#define C_PATHS_PER_TICK (64)
+// smaller batches are done on this thread alone, waking the workers would cost more than they save
+#define C_MIN_SHARED_PATHS (8)
+// how long an idle path worker sleeps before it looks for a batch again
+#define C_PATH_WORKER_IDLE_SLEEP_MS (1)
+
+struct PathJobs
+{
+	std::vector<PathfinderMob*> m_mobs;
+	std::vector<Region*> m_regions; // one for each mob, made on the main thread
+	std::vector<size_t> m_jobStarts; // a job is all of the mobs in one chunk
+	CMutex m_lock;
+	int m_nextJob;
+	int m_nWorkers; // how many workers are taking jobs from here, guarded by the level's m_pathJobsLock
+};
+
+struct PathWorker
+{
+	Level* m_pLevel;
+	PathFinder* m_pPathFinder;
+	CThread* m_pThread;
+	int m_lastBatch;
+};
+
 Level::Level(LevelStorage* pStor, const std::string& name, int32_t seed, int storageVersion, Dimension *pDimension)
 {
 	m_bInstantTicking = false;
@@ -29,7 +60,6 @@ Level::Level(LevelStorage* pStor, const std::string& name, int32_t seed, int sto
 	m_randValue = 42184323;
 	m_addend = 1013904223;
 	m_bUpdateLights = true;
-	field_B08 = 0;
 	field_B0C = 0;
 
 	m_random.setSeed(1); // initialize with a seed of 1
@@ -52,6 +82,11 @@ Level::Level(LevelStorage* pStor, const std::string& name, int32_t seed, int sto
 	m_pDimension->init(this);
 
 	m_pPathFinder = new PathFinder();
+	m_bPathWorkersStarted = false;
+	m_bStopPathWorkers = false;
+	m_pPathJobs = nullptr;
+	m_pathBatch = 0;
+	m_pLightEngine = new LightEngine(this);
 
 	m_pChunkSource = createChunkSource();
 	updateSkyBrightness();
@@ -59,14 +94,27 @@ Level::Level(LevelStorage* pStor, const std::string& name, int32_t seed, int sto
 
 Level::~Level()
 {
+	// joins the path workers, which are between batches now
+	m_bStopPathWorkers = true;
+	for (size_t i = 0; i < m_pathWorkers.size(); i++)
+	{
+		SAFE_DELETE(m_pathWorkers[i]->m_pThread);
+		SAFE_DELETE(m_pathWorkers[i]->m_pPathFinder);
+		SAFE_DELETE(m_pathWorkers[i]);
+	}
+
 	SAFE_DELETE(m_pChunkSource);
 	SAFE_DELETE(m_pDimension);
 	SAFE_DELETE(m_pPathFinder);
+	SAFE_DELETE(m_pLightEngine);
 
 	const size_t size = m_entities.size();
 	for (int i = 0; i < size; i++)
 	{
 		Entity* pEnt = m_entities.at(i);
+
+		// Custom: players outlive the level, and may join another one
+		m_entityGrid.remove(pEnt);
 		
 		//you better HOPE this is freed by Minecraft! (or a NetworkHandler)
 		//Really should have used shared pointers and stuff.
@@ -297,24 +345,16 @@ bool Level::hasChunk(const ChunkPos& pos) const
 EntityVector Level::getEntities(Entity* pEntExclude, const AABB& aabb) const
 {
 	EntityVector entities = EntityVector();
+	getEntities(pEntExclude, aabb, entities);
+	return entities;
+}
 
-	long lowerXBound = floor((aabb.min.x - 2.0f) / 16);
-	long lowerZBound = floor((aabb.min.z - 2.0f) / 16);
-	long upperXBound = floor((aabb.max.x + 2.0f) / 16);
-	long upperZBound = floor((aabb.max.z + 2.0f) / 16);
-
-	for (long z = lowerZBound; z <= upperZBound; z++)
-	{
-		for (long x = lowerXBound; x <= upperXBound; x++)
-		{
-			if (!hasChunk(ChunkPos(x, z))) continue;
-
-			LevelChunk* pChunk = getChunk(ChunkPos(x, z));
-			pChunk->getEntities(pEntExclude, aabb, entities);
-		}
-	}
+void Level::getEntities(const Entity* pEntExclude, const AABB& aabb, EntityVector& out) const
+{
+	out.clear();
 
-	return entities;
+	// Custom: the grid's cells are a lot smaller than a chunk, so a lot less is looked at
+	m_entityGrid.getEntities(pEntExclude, aabb, out);
 }
 
 void Level::setUpdateLights(bool b)
@@ -324,34 +364,7 @@ void Level::setUpdateLights(bool b)
 
 bool Level::updateLights()
 {
-	// if more than 49 concurrent updateLights() calls?
-	if (field_B08 > 49)
-		return false;
-
-	field_B08++;
-
-	if (m_lightUpdates.empty())
-	{
-		field_B08--;
-		return false;
-	}
-
-	for (int i = 499; i; i--)
-	{
-		LightUpdate lu = *(m_lightUpdates.end() - 1);
-		m_lightUpdates.pop_back();
-
-		lu.update(this);
-
-		if (m_lightUpdates.empty())
-		{
-			field_B08--;
-			return false;
-		}
-	}
-
-	field_B08--;
-	return true;
+	return m_pLightEngine->tick(C_LIGHT_UPDATE_BUDGET_MS);
 }
 
 bool Level::hasChunksAt(const TilePos& min, const TilePos& max) const
@@ -458,51 +471,15 @@ LevelChunk* Level::getChunkAt(const TilePos& pos) const
 
 void Level::updateLight(const LightLayer& ll, const TilePos& tilePos1, const TilePos& tilePos2, bool unimportant)
 {
-	static int nUpdateLevels;
-
 	if ((m_pDimension->field_E && &ll == &LightLayer::Sky) || !m_bUpdateLights)
 		return;
 
-	nUpdateLevels++;
-	if (nUpdateLevels == 50)
-	{
-		nUpdateLevels--;
-		return;
-	}
-
 	TilePos idkbro((tilePos2.x + tilePos1.x) / 2, (tilePos2.y + tilePos1.y) / 2, (tilePos2.z + tilePos1.z) / 2);
 
 	if (!hasChunkAt(idkbro) || getChunkAt(idkbro)->isEmpty())
-	{
-		nUpdateLevels--;
 		return;
-	}
-
-	size_t size = m_lightUpdates.size();
-	if (unimportant)
-	{
-		size_t count = 5;
-		if (count > size)
-			count = size;
-
-		for (size_t i = 0; i < count; i++)
-		{
-			LightUpdate& update = m_lightUpdates[size - i - 1];
-			if (update.m_lightLayer == &ll && update.expandToContain(tilePos1, tilePos2))
-			{
-				nUpdateLevels--;
-				return;
-			}
-		}
-	}
 
-	m_lightUpdates.push_back(LightUpdate(ll, tilePos1, tilePos2));
-
-	// huh??
-	if (m_lightUpdates.size() > 1000000)
-		m_lightUpdates.clear();
-
-	nUpdateLevels--;
+	m_pLightEngine->update(ll, tilePos1, tilePos2);
 }
 
 void Level::updateLight(const LightLayer& ll, const TilePos& tilePos1, const TilePos& tilePos2)
@@ -756,6 +733,17 @@ void Level::entityRemoved(Entity* pEnt)
 }
 
 AABBVector* Level::getCubes(const Entity* pEntUnused, const AABB& aabb)
+{
+	_addCubes(aabb, false);
+	return &m_aabbs;
+}
+
+AABBVector* Level::getOnlyCubes(const AABB& aabb)
+{
+	return _addCubes(aabb, true) ? &m_aabbs : nullptr;
+}
+
+bool Level::_addCubes(const AABB& aabb, bool bOnlyCubes)
 {
 	m_aabbs.clear();
 
@@ -766,31 +754,62 @@ AABBVector* Level::getCubes(const Entity* pEntUnused, const AABB& aabb)
 	long lowerZ = floor(aabb.min.z);
 	long upperZ = floor(aabb.max.z + 1);
 
+	// - 1 fixes tiles like the fence
+	long minY = lowerY - 1 < C_MIN_Y ? C_MIN_Y : lowerY - 1;
+	long maxY = upperY >= C_MAX_Y ? C_MAX_Y - 1 : upperY;
+	if (minY > maxY)
+		return true;
+
+	// Custom: the full cubes that touch aabb are taken from the collision masks, only the other tiles are
+	// asked for their AABBs. Each cube keeps its own box, the top of a cube an entity is stuck in still counts.
+	long minCubeY = lowerY < minY ? minY : lowerY;
+	long maxCubeY = long(ceil(aabb.max.y)) - 1;
+	if (maxCubeY > maxY)
+		maxCubeY = maxY;
+
 	for (long x = lowerX; x <= upperX; x++)
 	{
 		for (long z = lowerZ; z <= upperZ; z++)
 		{
-			if (!hasChunkAt(TilePos(x, 64, z))) continue;
+			// Obviously this is problematic, but using longs in our for loops rather than
+			// ints helps prevents crashes at extreme distances from 0,0
+			TilePos tp((int)x, 64, (int)z);
+			if (!hasChunkAt(tp)) continue;
+
+			// getTile returns air out here
+			if (tp.x < C_MIN_X || tp.z < C_MIN_Z || tp.x >= C_MAX_X || tp.z >= C_MAX_Z) continue;
+
+			LevelChunk* pChunk = getChunk(tp);
+			const uint64_t* pCubes = pChunk->getCollisionColumn(ChunkTilePos(tp));
+			const uint64_t* pCustom = pCubes + C_COLLISION_MASK_WORDS;
+			const uint64_t* pTiles = pCubes + 3 * C_COLLISION_MASK_WORDS;
+
+			for (tp.y = int(minY); tp.y <= maxY; tp.y++)
+			{
+				if (bOnlyCubes)
+				{
+					if (LevelChunk::hasCollisionBit(pTiles, tp.y) && !LevelChunk::hasCollisionBit(pCubes, tp.y))
+						return false;
+				}
+				else if (LevelChunk::hasCollisionBit(pCustom, tp.y))
+				{
+					Tile::tiles[pChunk->getTile(ChunkTilePos(tp))]->addAABBs(this, tp, &aabb, m_aabbs);
+				}
+			}
 
-			// - 1 fixes tiles like the fence
-			for (long y = lowerY - 1; y <= upperY; y++)
+			float fx = float(tp.x), fz = float(tp.z);
+			if (fx + 1.0f <= aabb.min.x || fx >= aabb.max.x || fz + 1.0f <= aabb.min.z || fz >= aabb.max.z)
+				continue;
+
+			for (long y = minCubeY; y <= maxCubeY; y++)
 			{
-				// Obviously this is problematic, but using longs in our for loops rather than
-				// ints helps prevents crashes at extreme distances from 0,0
-				TilePos tp((int)x, (int)y, (int)z);
-				Tile* pTile = Tile::tiles[getTile(tp)];
-				if (pTile)
-					pTile->addAABBs(this, tp, &aabb, m_aabbs);
+				if (LevelChunk::hasCollisionBit(pCubes, int(y)))
+					m_aabbs.push_back(AABB(fx, float(y), fz, fx + 1.0f, float(y + 1), fz + 1.0f));
 			}
 		}
 	}
 
-	return &m_aabbs;
-}
-
-std::vector<LightUpdate>* Level::getLightsToUpdate()
-{
-	return &m_lightUpdates;
+	return true;
 }
 
 Player* Level::_getNearestPlayer(const Vec3& source, float maxDist, bool onlyFindAttackable) const
@@ -1116,6 +1135,7 @@ void Level::removeAllPendingEntityRemovals()
 
 		LevelChunk* chunk = getChunk(ent->m_chunkPos);
 		if (chunk) chunk->removeEntity(ent);
+		m_entityGrid.remove(ent);
 
 		entityRemoved(ent);
 
@@ -1410,23 +1430,25 @@ void Level::addListener(LevelListener* listener)
 void Level::tickPendingTicks(bool b)
 {
 	int size = 10000; // note: 65,536 in Minecraft Java
-	if (size > int(m_pendingTicks.size()))
-		size = int(m_pendingTicks.size());
+	if (size > m_pendingTicks.size())
+		size = m_pendingTicks.size();
 
 	for (int i = 0; i < size; i++)
 	{
-		const TickNextTickData& t = *m_pendingTicks.begin();
-		if (!b && t.m_delay > m_pLevelData->getTime())
+		const TickNextTickData* pTick = m_pendingTicks.peek();
+		if (!b && pTick->m_delay > m_pLevelData->getTime())
 			break;
 
+		// Custom: taken out before the tile ticks, so it can ask for its next tick there again
+		TickNextTickData t = *pTick;
+		m_pendingTicks.pop();
+
 		if (hasChunksAt(t.field_4 - 8, t.field_4 + 8))
 		{
 			TileID tile = getTile(t.field_4);
 			if (tile == t.field_10 && tile > 0)
 				Tile::tiles[tile]->tick(this, t.field_4, &m_random);
 		}
-
-		m_pendingTicks.erase(m_pendingTicks.begin());
 	}
 }
 
@@ -1517,6 +1539,11 @@ void Level::tick(Entity* pEnt, bool b)
 		}
 	}
 
+	// Custom: the grid's cells are smaller than the chunks, so it's kept up to date every tick
+	if (pEnt->m_bInAChunk)
+		m_entityGrid.update(pEnt);
+	else
+		m_entityGrid.remove(pEnt);
 }
 
 void Level::tick(Entity* pEnt)
@@ -1550,6 +1577,218 @@ void Level::tick()
 
 	tickPendingTicks(false);
 	tickTiles();
+
+	for (std::vector<LevelListener*>::iterator it = m_levelListeners.begin(); it != m_levelListeners.end(); it++)
+	{
+		LevelListener* pListener = *it;
+		pListener->levelTicked();
+	}
+}
+
+static bool ComparePathRequests(const PathfinderMob* a, const PathfinderMob* b)
+{
+	if (a->m_chunkPos.x != b->m_chunkPos.x)
+		return a->m_chunkPos.x < b->m_chunkPos.x;
+	if (a->m_chunkPos.z != b->m_chunkPos.z)
+		return a->m_chunkPos.z < b->m_chunkPos.z;
+
+	return a->m_EntityID < b->m_EntityID;
+}
+
+static void FindPaths(PathJobs* pJobs, PathFinder& pathFinder)
+{
+	while (true)
+	{
+		pJobs->m_lock.lock();
+		int job = pJobs->m_nextJob++;
+		pJobs->m_lock.unlock();
+
+		if (job >= int(pJobs->m_jobStarts.size()))
+			break;
+
+		size_t end = job + 1 < int(pJobs->m_jobStarts.size()) ? pJobs->m_jobStarts[job + 1] : pJobs->m_mobs.size();
+		for (size_t i = pJobs->m_jobStarts[job]; i < end; i++)
+			pJobs->m_mobs[i]->findRequestedPath(pathFinder, *pJobs->m_regions[i]);
+	}
+}
+
+void* Level::_findPathsRoutine(void* ptr)
+{
+	PathWorker* pWorker = (PathWorker*)ptr;
+	Level* pThis = pWorker->m_pLevel;
+
+	while (!pThis->m_bStopPathWorkers)
+	{
+		pThis->m_pathJobsLock.lock();
+
+		PathJobs* pJobs = pThis->m_pPathJobs;
+		if (!pJobs || pWorker->m_lastBatch == pThis->m_pathBatch)
+		{
+			pThis->m_pathJobsLock.unlock();
+			CThread::sleep(C_PATH_WORKER_IDLE_SLEEP_MS);
+			continue;
+		}
+
+		pWorker->m_lastBatch = pThis->m_pathBatch;
+		pJobs->m_nWorkers++;
+
+		pThis->m_pathJobsLock.unlock();
+
+		FindPaths(pJobs, *pWorker->m_pPathFinder);
+
+		pThis->m_pathJobsLock.lock();
+		pJobs->m_nWorkers--;
+		pThis->m_pathJobsLock.unlock();
+	}
+
+	return nullptr;
+}
+
+void Level::_startPathWorkers()
+{
+	if (m_bPathWorkersStarted)
+		return;
+
+	m_bPathWorkersStarted = true;
+
+	// this thread is one of them. With a single core there's nobody to share with
+	int nThreads = CThread::getProcessorCount();
+	if (nThreads > C_PATH_THREADS)
+		nThreads = C_PATH_THREADS;
+
+	for (int i = 1; i < nThreads; i++)
+	{
+		PathWorker* pWorker = new PathWorker;
+		pWorker->m_pLevel = this;
+		pWorker->m_pPathFinder = new PathFinder;
+		pWorker->m_lastBatch = m_pathBatch;
+		pWorker->m_pThread = new CThread(&Level::_findPathsRoutine, pWorker);
+		m_pathWorkers.push_back(pWorker);
+	}
+}
+
+void Level::_findRequestedPaths()
+{
+	if (m_pathRequests.empty())
+		return;
+
+	// Nothing changes the level while the paths are looked for, and each mob only writes its own path,
+	// so which thread finds which doesn't matter. The workers never ask the level for a chunk, since
+	// even a lookup moves the chunk cache's last-chunk shortcut. They only read the chunks their mob's
+	// Region was given here, on this thread.
+	PathJobs jobs;
+	jobs.m_nextJob = 0;
+	jobs.m_nWorkers = 0;
+
+	// first asked, first served. A mob that asks again while it waits keeps its place, with the new target.
+	size_t nRequests = m_pathRequests.size();
+	if (nRequests > C_PATHS_PER_TICK)
+		nRequests = C_PATHS_PER_TICK;
+
+	for (size_t i = 0; i < nRequests; i++)
+	{
+		PathfinderMob* pMob = m_pathRequests[i];
+		TilePos pos(pMob->m_pos);
+		if (pMob->m_bRemoved || !hasChunksAt(pos, pMob->getPathRequestRange()))
+		{
+			pMob->cancelPathRequest();
+			continue;
+		}
+
+		_buildPathMasks(pos, pMob->getPathRequestRange());
+		jobs.m_mobs.push_back(pMob);
+	}
+
+	m_pathRequests.erase(m_pathRequests.begin(), m_pathRequests.begin() + nRequests);
+
+	if (jobs.m_mobs.empty())
+		return;
+
+	std::sort(jobs.m_mobs.begin(), jobs.m_mobs.end(), ComparePathRequests);
+	for (size_t i = 0; i < jobs.m_mobs.size(); i++)
+	{
+		if (i == 0 || jobs.m_mobs[i]->m_chunkPos != jobs.m_mobs[i - 1]->m_chunkPos)
+			jobs.m_jobStarts.push_back(i);
+
+		TilePos pos(jobs.m_mobs[i]->m_pos);
+		int range = jobs.m_mobs[i]->getPathRequestRange();
+		jobs.m_regions.push_back(new Region(this, pos - range, pos + range));
+	}
+
+	// without storage, the chunk source makes chunks past the edges of the world when they're asked for
+	bool bShared = false;
+	if (jobs.m_mobs.size() >= C_MIN_SHARED_PATHS && m_pLevelStorage)
+	{
+		_startPathWorkers();
+		bShared = !m_pathWorkers.empty();
+	}
+
+	if (bShared)
+	{
+		m_pathJobsLock.lock();
+		m_pPathJobs = &jobs;
+		m_pathBatch++;
+		m_pathJobsLock.unlock();
+	}
+
+	FindPaths(&jobs, *m_pPathFinder);
+
+	if (bShared)
+	{
+		m_pathJobsLock.lock();
+		m_pPathJobs = nullptr;
+		m_pathJobsLock.unlock();
+
+		// nobody new picks the batch up, so this only waits for the jobs still in flight
+		while (true)
+		{
+			m_pathJobsLock.lock();
+			int nWorkers = jobs.m_nWorkers;
+			m_pathJobsLock.unlock();
+
+			if (!nWorkers)
+				break;
+
+			CThread::sleep(0);
+		}
+	}
+
+	for (size_t i = 0; i < jobs.m_regions.size(); i++)
+		delete jobs.m_regions[i];
+}
+
+void Level::_buildPathMasks(const TilePos& pos, int range) const
+{
+	ChunkPos cpMin(pos - range), cpMax(pos + range);
+	ChunkPos cp;
+
+	for (cp.x = cpMin.x; cp.x <= cpMax.x; cp.x++)
+	{
+		for (cp.z = cpMin.z; cp.z <= cpMax.z; cp.z++)
+		{
+			LevelChunk* pChunk = getChunk(cp);
+			if (pChunk)
+				pChunk->buildCollisionMasks();
+		}
+	}
+}
+
+void Level::cancelPathRequest(PathfinderMob* pMob)
+{
+	for (size_t i = 0; i < m_pathRequests.size(); i++)
+	{
+		if (m_pathRequests[i] != pMob)
+			continue;
+
+		pMob->cancelPathRequest();
+		m_pathRequests.erase(m_pathRequests.begin() + i);
+		return;
+	}
+}
+
+void Level::requestPath(PathfinderMob* pMob)
+{
+	m_pathRequests.push_back(pMob);
 }
 
 void Level::tickEntities()
@@ -1557,6 +1796,13 @@ void Level::tickEntities()
 	// inlined in the original
 	removeAllPendingEntityRemovals();
 
+	// Custom: phase one, the paths the mobs asked for during the last tick are found on more than one thread
+	_findRequestedPaths();
+
+	// Phase two ticks the entities one after another. The ones added while ticking are ticked too.
+	// Custom: the removed ones stay where they are until the end, and then they're all taken out in
+	// one pass, instead of erasing them one at a time. The order the rest are ticked in stays the same.
+	std::vector<int> removed;
 	for (int i = 0; i<int(m_entities.size()); i++)
 	{
 		Entity* pEnt = m_entities[i];
@@ -1569,17 +1815,38 @@ void Level::tickEntities()
 		{
 			if (pEnt->m_bInAChunk && hasChunk(pEnt->m_chunkPos))
 				getChunk(pEnt->m_chunkPos)->removeEntity(pEnt);
+			m_entityGrid.remove(pEnt);
 
-			m_entities.erase(m_entities.begin() + i);
-			i--;
+			removed.push_back(i);
 
 			entityRemoved(pEnt);
+		}
+	}
+
+	if (removed.empty())
+		return;
+
+	EntityVector toDelete;
+	size_t nKept = 0, nextRemoved = 0;
+	for (size_t i = 0; i < m_entities.size(); i++)
+	{
+		if (nextRemoved < removed.size() && removed[nextRemoved] == int(i))
+		{
+			nextRemoved++;
 
 			// If the entity isn't a player (managed by Minecraft* or through OnlinePlayer), then delete it.
-			if (!pEnt->isPlayer())
-				delete pEnt;
+			if (!m_entities[i]->isPlayer())
+				toDelete.push_back(m_entities[i]);
+			continue;
 		}
+
+		m_entities[nKept++] = m_entities[i];
 	}
+
+	m_entities.resize(nKept);
+
+	for (size_t i = 0; i < toDelete.size(); i++)
+		delete toDelete[i];
 }
 
 HitResult Level::clip(Vec3 v1, Vec3 v2, bool flag) const
@@ -1705,7 +1972,7 @@ void Level::addToTickNextTick(const TilePos& tilePos, int d, int delay)
 		if (d > 0)
 			tntd.setDelay(delay + getTime());
 
-		m_pendingTicks.insert(tntd);
+		m_pendingTicks.add(tntd);
 	}
 }
 
@@ -1848,6 +2115,7 @@ int Level::findPath(Path* path, Entity* ent, Entity* target, float f) const
 {
 	TilePos tp(ent->m_pos);
 	Region reg(this, tp - int(f + 16), tp + int(f + 16));
+	_buildPathMasks(tp, int(f + 16));
 
 	m_pPathFinder->setLevel(&reg);
 	return m_pPathFinder->findPath(*path, ent, target, f);
@@ -1860,6 +2128,7 @@ int Level::findPath(Path* path, Entity* ent, const TilePos& pos, float f) const
 {
 	TilePos tp(ent->m_pos);
 	Region reg(this, tp - int(f + 8), tp + int(f + 8));
+	_buildPathMasks(tp, int(f + 8));
 	
 	m_pPathFinder->setLevel(&reg);
 	return m_pPathFinder->findPath(*path, ent, pos, f);
@@ -1868,6 +2137,12 @@ int Level::findPath(Path* path, Entity* ent, const TilePos& pos, float f) const
 	// return 1;
 }
 
+int Level::findPath(PathFinder& pathFinder, Region& region, Path* path, Entity* ent, const Vec3& pos, float f) const
+{
+	pathFinder.setLevel(&region);
+	return pathFinder.findPath(*path, ent, pos, f);
+}
+
 int Level::getLightDepth(const TilePos& pos) const
 {
 	return getChunk(pos)->getHeightmap(pos);
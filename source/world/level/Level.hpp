@@ -24,14 +24,19 @@
 #include "world/level/storage/LevelSource.hpp"
 #include "world/level/storage/LevelData.hpp"
 #include "world/level/path/PathFinder.hpp"
+#include "EntityGrid.hpp"
 #include "Dimension.hpp"
 #include "LevelListener.hpp"
-#include "TickNextTickData.hpp"
-#include "client/renderer/LightUpdate.hpp"
+#include "TickNextTickWheel.hpp"
+#include "client/renderer/LightEngine.hpp"
+#include "common/CThread.hpp"
 
 class Dimension;
 class Level;
 class LevelListener;
+class PathfinderMob;
+struct PathJobs;
+struct PathWorker;
 
 typedef std::vector<Entity*> EntityVector;
 typedef std::vector<AABB> AABBVector;
@@ -42,6 +47,15 @@ private:
 	// @NOTE: LevelListeners do NOT get updated here
 	void _setTime(int32_t time) { m_pLevelData->setTime(time); }
 	Player* _getNearestPlayer(const Vec3&, float, bool) const;
+	// Custom: phase one of tickEntities
+	void _findRequestedPaths();
+	// Custom: the path finder reads the chunks' column masks, which have to be there before any thread looks
+	void _buildPathMasks(const TilePos& pos, int range) const;
+	// Custom: fills m_aabbs for getCubes and getOnlyCubes
+	bool _addCubes(const AABB& aabb, bool bOnlyCubes);
+	// Custom: starts the path workers the first time a batch is big enough for them
+	void _startPathWorkers();
+	static void* _findPathsRoutine(void*);
 
 public:
 	Level(LevelStorage* pStor, const std::string& name, int32_t seed, int storageVersion, Dimension* pDimension = nullptr);
@@ -150,6 +164,11 @@ public:
 	bool extinguishFire(Player* player, const TilePos& pos, Facing::Name face);
 	int findPath(Path* path, Entity* ent1, Entity* ent2, float f) const;
 	int findPath(Path* path, Entity* ent, const TilePos& pos, float f) const;
+	// Custom: with a PathFinder and a Region of the caller's, so that more than one thread can look for paths
+	int findPath(PathFinder& pathFinder, Region& region, Path* path, Entity* ent, const Vec3& pos, float f) const;
+	void requestPath(PathfinderMob* pMob);
+	// Custom: only for a mob that's about to be deleted. Removed mobs are skipped when the paths are looked for.
+	void cancelPathRequest(PathfinderMob* pMob);
 	int getLightDepth(const TilePos& pos) const;
 	float getStarBrightness(float f) const;
 	float getSunAngle(float f) const;
@@ -160,11 +179,15 @@ public:
 	Entity* getEntity(int id) const;
 	const EntityVector* getAllEntities() const;
 	EntityVector getEntities(Entity* pAvoid, const AABB&) const;
+	// Custom: the same, but into a vector the caller keeps around, so its storage can be reused
+	void getEntities(const Entity* pAvoid, const AABB&, EntityVector& out) const;
 	BiomeSource* getBiomeSource() const override;
 	LevelStorage* getLevelStorage() const { return m_pLevelStorage; }
 	const LevelData* getLevelData() const { return m_pLevelData; }
 	AABBVector* getCubes(const Entity* pEnt, const AABB& aabb);
-	std::vector<LightUpdate>* getLightsToUpdate();
+	// Custom: getCubes, if all the tiles it looks at are air or full cubes, null if there is any other
+	// tile among them. Something moving through there can't be inside of any tile.
+	AABBVector* getOnlyCubes(const AABB& aabb);
 	Player* getNearestPlayer(const Entity&, float) const;
 	Player* getNearestPlayer(const Vec3& pos, float, bool) const;
 	Player* getNearestAttackablePlayer(const Entity&, float) const;
@@ -204,13 +227,20 @@ public:
 	ChunkSource* m_pChunkSource;
 	LevelStorage* m_pLevelStorage;
 	EntityVector m_pendingEntityRemovals;
-	std::set<TickNextTickData> m_pendingTicks;
+	EntityGrid m_entityGrid; // Custom: has the same entities as the chunks, for getEntities
+	TickNextTickWheel m_pendingTicks; // Custom: was a std::set<TickNextTickData>
 	std::set<ChunkPos> m_chunksToUpdate;
-	std::vector<LightUpdate> m_lightUpdates;
+	LightEngine* m_pLightEngine;
 	bool m_bUpdateLights;
-	int field_B08;
 	uint8_t field_B0C;
 	int field_B10;
 	PathFinder* m_pPathFinder;
+	std::vector<PathfinderMob*> m_pathRequests; // Custom
+	std::vector<PathWorker*> m_pathWorkers; // Custom: kept from the first big batch on, for every thread but this one
+	bool m_bPathWorkersStarted; // Custom
+	volatile bool m_bStopPathWorkers; // Custom
+	CMutex m_pathJobsLock; // Custom: guards the three below
+	PathJobs* m_pPathJobs; // Custom: the batch the workers take jobs from, while there is one
+	int m_pathBatch; // Custom: counts the batches, so a worker doesn't look at one it's done with again
 };
 
@@ -72,3 +72,8 @@ void LevelListener::playStreamingMusic(const std::string& a, int b, int c, int d
 {
 
 }
+
+void LevelListener::levelTicked()
+{
+
+}
@@ -28,5 +28,7 @@ public:
 	virtual void skyColorChanged();
 	virtual void timeChanged(uint32_t time);
 	virtual void playStreamingMusic(const std::string&, int, int, int);
+	// Custom: called at the end of Level::tick
+	virtual void levelTicked();
 };
 
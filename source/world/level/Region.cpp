@@ -13,6 +13,9 @@ TileID Region::getTile(const TilePos& pos) const
 	if (pos.y < C_MIN_Y || pos.y >= C_MAX_Y)
 		return TILE_AIR;
 
+	if (m_pSnapshot)
+		return _isInBox(pos) ? m_pSnapshot[_getBoxIndex(pos)] : TILE_AIR;
+
 	LevelChunk* pChunk = getChunkAt(pos);
 
 	if (pChunk == nullptr)
@@ -54,16 +57,30 @@ int Region::getRawBrightness(const TilePos& pos, bool b) const
 	}
 	if (pos.y >= C_MAX_Y)
 	{
-		int bright = 15 - m_pLevel->m_skyDarken;
+		int bright = 15 - m_skyDarken;
 		if (bright < 0)
 			bright = 0;
 		return bright;
 	}
 
+	if (m_pSnapshot)
+	{
+		if (!_isInBox(pos))
+			return 0;
+
+		int light = m_pSnapshotLight[_getBoxIndex(pos)];
+		int sky = light >> 4, blk = light & 0xF;
+		if (sky > 0)
+			m_bTouchedSky = true;
+
+		sky -= m_skyDarken;
+		return sky < blk ? blk : sky;
+	}
+
 	//@BUG: Unsanitized input
 	ChunkPos d(pos);
 	d -= field_4;
-	return field_C[d.z * field_14.x + d.x]->getRawBrightness(pos, m_pLevel->m_skyDarken);
+	return field_C[d.z * field_14.x + d.x]->getRawBrightness(pos, m_skyDarken);
 }
 
 int Region::getRawBrightness(const TilePos& pos) const
@@ -81,6 +98,9 @@ TileData Region::getData(const TilePos& pos) const
 	if (pos.y < C_MIN_Y || pos.y >= C_MAX_Y)
 		return 0;
 
+	if (m_pSnapshot)
+		return _isInBox(pos) ? m_pSnapshotData[_getBoxIndex(pos)] : 0;
+
 	ChunkPos d(pos);
 	d -= field_4;
 	return field_C[d.z * field_14.x + d.x]->getData(pos);
@@ -108,16 +128,103 @@ bool Region::isSolidTile(const TilePos& pos) const
 
 BiomeSource* Region::getBiomeSource() const
 {
+	if (m_pBiomeSource)
+		return m_pBiomeSource;
+
 	return m_pLevel->getBiomeSource();
 }
 
 Region::~Region()
 {
+	delete[] m_pSnapshot;
 	delete[] field_C;
 }
 
 Region::Region(const Level* level, const TilePos& min, const TilePos& max)
 {
+	_init(level, min, max);
+}
+
+Region::Region(const Level* level, const TilePos& min, const TilePos& max, bool bSnapshot)
+{
+	_init(level, min, max);
+
+	if (!bSnapshot || !field_C)
+		return;
+
+	m_boxMin = min;
+	m_boxSize = max - min + 1;
+
+	int size = m_boxSize.x * m_boxSize.y * m_boxSize.z;
+	m_pSnapshot = new uint8_t[3 * size];
+	m_pSnapshotData = m_pSnapshot + size;
+	m_pSnapshotLight = m_pSnapshot + 2 * size;
+
+	TilePos pos(min);
+	for (pos.x = min.x; pos.x <= max.x; pos.x++)
+	{
+		for (pos.z = min.z; pos.z <= max.z; pos.z++)
+			_copyColumn(pos, getChunkAt(pos));
+	}
+
+	// nothing may come from the level's chunks anymore
+	delete[] field_C;
+	field_C = nullptr;
+}
+
+void Region::_copyColumn(const TilePos& pos, LevelChunk* pChunk)
+{
+	int index = _getBoxIndex(pos);
+	uint8_t* pTiles = m_pSnapshot + index;
+	uint8_t* pData = m_pSnapshotData + index;
+	uint8_t* pLight = m_pSnapshotLight + index;
+
+	// what the chunkless and out of world parts read as
+	memset(pTiles, TILE_AIR, m_boxSize.y);
+	memset(pData, 0, m_boxSize.y);
+	memset(pLight, 0, m_boxSize.y);
+
+	int minY = Mth::Max(pos.y, C_MIN_Y);
+	int maxY = Mth::Min(pos.y + m_boxSize.y, C_MAX_Y);
+	if (!pChunk || minY >= maxY)
+		return;
+
+	int offset = minY - pos.y, height = maxY - minY;
+
+	if (pChunk->isEmpty())
+	{
+		// same as what the empty chunk gives out
+		memset(pTiles + offset, Tile::invisible_bedrock->m_ID, height);
+		memset(pLight + offset, 7, height);
+		return;
+	}
+
+	// chunk arrays are indexed (x << 11) | (z << 7) | y, so the column is one run
+	int src = ((pos.x & 15) << 11) | ((pos.z & 15) << 7) | minY;
+	memcpy(pTiles + offset, pChunk->m_pBlockData + src, height);
+
+	for (int i = 0; i < height; i++)
+	{
+		// like LevelChunk::getTile, ids without a tile read as air
+		if (!Tile::tiles[pTiles[offset + i]])
+			pTiles[offset + i] = TILE_AIR;
+
+		int shift = ((src + i) & 1) << 2;
+		int nibble = (src + i) >> 1;
+		pData[offset + i] = (pChunk->m_tileData.m_data[nibble] >> shift) & 0xF;
+		pLight[offset + i] = uint8_t((((pChunk->m_lightSky.m_data[nibble] >> shift) & 0xF) << 4) | ((pChunk->m_lightBlk.m_data[nibble] >> shift) & 0xF));
+	}
+}
+
+void Region::_init(const Level* level, const TilePos& min, const TilePos& max)
+{
+	m_pSnapshot = nullptr;
+	m_pSnapshotData = nullptr;
+	m_pSnapshotLight = nullptr;
+	m_skyDarken = level->m_skyDarken;
+	m_pBiomeSource = nullptr;
+	m_bTouchedSky = false;
+
 	m_pLevel = level;
 	field_4 = min;
 	ChunkPos cpMin(min), cpMax(max);
@@ -24,6 +24,14 @@ public:
 
 	virtual ~Region();
 	Region(const Level* level, const TilePos& min, const TilePos& max);
+	// Copies the tiles, data and light in the box into one flat array, so it
+	// can be read from any thread while the level goes on changing. Reads
+	// outside the box give air. A biome source has to be given with setBiomeSource.
+	Region(const Level* level, const TilePos& min, const TilePos& max, bool bSnapshot);
+
+	void setBiomeSource(BiomeSource* pBiomeSource) { m_pBiomeSource = pBiomeSource; }
+	bool isSnapshot() const { return m_pSnapshot != nullptr; }
+	bool hasTouchedSky() const { return m_bTouchedSky; }
 
 	// inlined in the original, but I doubt they'd actually copy paste this logic
 	LevelChunk* getChunkAt(const ChunkPos& pos) const
@@ -31,12 +39,30 @@ public:
 		int indexX = pos.x - field_4.x;
 		int indexZ = pos.z - field_4.z;
 
-		if (indexX < 0 || indexZ < 0 || indexX >= field_14.x || indexZ >= field_14.z)
+		// a snapshot has no business handing out the level's chunks
+		if (!field_C || indexX < 0 || indexZ < 0 || indexX >= field_14.x || indexZ >= field_14.z)
 			return nullptr;
 
 		return field_C[indexZ * field_14.x + indexX];
 	}
 
+private:
+	void _init(const Level* level, const TilePos& min, const TilePos& max);
+	void _copyColumn(const TilePos& pos, LevelChunk* pChunk);
+
+	// snapshot only
+	bool _isInBox(const TilePos& pos) const
+	{
+		// negative offsets wrap around to huge unsigned ones
+		return unsigned(pos.x - m_boxMin.x) < unsigned(m_boxSize.x)
+			&& unsigned(pos.y - m_boxMin.y) < unsigned(m_boxSize.y)
+			&& unsigned(pos.z - m_boxMin.z) < unsigned(m_boxSize.z);
+	}
+	int _getBoxIndex(const TilePos& pos) const
+	{
+		return ((pos.x - m_boxMin.x) * m_boxSize.z + (pos.z - m_boxMin.z)) * m_boxSize.y + (pos.y - m_boxMin.y);
+	}
+
 private:
 	ChunkPos field_4;
 	// accesses to the array are performed as follows:
@@ -51,5 +77,16 @@ private:
 	int field_28;
 	int field_2C;
 	int field_30;
+
+	// snapshot only: one byte per tile in the box for the tile id, the data
+	// and the light (sky light in the high nibble), y being the innermost
+	uint8_t* m_pSnapshot;
+	uint8_t* m_pSnapshotData;
+	uint8_t* m_pSnapshotLight;
+	TilePos m_boxMin;
+	TilePos m_boxSize;
+	int m_skyDarken;
+	BiomeSource* m_pBiomeSource;
+	mutable bool m_bTouchedSky;
 };
 
@@ -0,0 +1,244 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#include "TickNextTickWheel.hpp"
+
+#define C_TICK_WHEEL_MASK (C_TICK_WHEEL_SIZE - 1)
+#define C_TICK_KEYS_START_SIZE (1024)
+
+TickNextTickWheel::TickNextTickWheel()
+{
+	m_dueIndex = 0;
+	m_bHaveDue = false;
+	m_time = 0;
+	m_size = 0;
+	m_nKeys = 0;
+
+	Key key;
+	key.m_tile = -1;
+	m_keys.resize(C_TICK_KEYS_START_SIZE, key);
+}
+
+bool TickNextTickWheel::add(const TickNextTickData& tick)
+{
+	if (!_addKey(tick.field_4, tick.field_10))
+		return false;
+
+	m_size++;
+
+	if (m_bHaveDue && tick.m_delay == m_time)
+	{
+		// added later than everything that's due, so it goes last
+		m_due.push_back(tick);
+		return true;
+	}
+
+	if (tick.m_delay < m_time)
+	{
+		// due before what was up next, which may happen if the time's set back
+		_putBackDue();
+		m_time = tick.m_delay;
+	}
+
+	m_buckets[tick.m_delay & C_TICK_WHEEL_MASK].push_back(tick);
+	return true;
+}
+
+const TickNextTickData* TickNextTickWheel::peek()
+{
+	if (m_size == 0)
+		return nullptr;
+
+	while (!m_bHaveDue || m_dueIndex >= m_due.size())
+		_advance();
+
+	return &m_due[m_dueIndex];
+}
+
+void TickNextTickWheel::pop()
+{
+	const TickNextTickData& tick = m_due[m_dueIndex];
+	_removeKey(tick.field_4, tick.field_10);
+
+	m_dueIndex++;
+	m_size--;
+}
+
+void TickNextTickWheel::clear()
+{
+	for (int i = 0; i < C_TICK_WHEEL_SIZE; i++)
+		m_buckets[i].clear();
+
+	m_due.clear();
+	m_dueIndex = 0;
+	m_bHaveDue = false;
+	m_time = 0;
+	m_size = 0;
+
+	for (size_t i = 0; i < m_keys.size(); i++)
+		m_keys[i].m_tile = -1;
+
+	m_nKeys = 0;
+}
+
+void TickNextTickWheel::_advance()
+{
+	if (m_bHaveDue)
+	{
+		// everything due at m_time was handed out
+		m_due.clear();
+		m_dueIndex = 0;
+		m_bHaveDue = false;
+		m_time++;
+	}
+
+	for (int i = 0; i < C_TICK_WHEEL_SIZE; i++, m_time++)
+	{
+		_takeDue(m_time);
+		if (m_bHaveDue)
+			return;
+	}
+
+	// Nothing's due for a whole turn of the wheel, the time must have been set forward.
+	// Skip to the earliest tick instead of going around again and again.
+	bool bFound = false;
+	int32_t earliest = 0;
+	for (int i = 0; i < C_TICK_WHEEL_SIZE; i++)
+	{
+		for (size_t j = 0; j < m_buckets[i].size(); j++)
+		{
+			if (!bFound || earliest > m_buckets[i][j].m_delay)
+				earliest = m_buckets[i][j].m_delay;
+
+			bFound = true;
+		}
+	}
+
+	m_time = earliest;
+	_takeDue(m_time);
+}
+
+void TickNextTickWheel::_takeDue(int32_t time)
+{
+	// the ticks of later turns of the wheel stay in the bucket, in the same order
+	std::vector<TickNextTickData>& bucket = m_buckets[time & C_TICK_WHEEL_MASK];
+	size_t nKept = 0;
+
+	for (size_t i = 0; i < bucket.size(); i++)
+	{
+		if (bucket[i].m_delay == time)
+			m_due.push_back(bucket[i]);
+		else
+			bucket[nKept++] = bucket[i];
+	}
+
+	bucket.erase(bucket.begin() + nKept, bucket.end());
+
+	m_dueIndex = 0;
+	m_bHaveDue = !m_due.empty();
+}
+
+void TickNextTickWheel::_putBackDue()
+{
+	if (!m_bHaveDue)
+		return;
+
+	std::vector<TickNextTickData>& bucket = m_buckets[m_time & C_TICK_WHEEL_MASK];
+	bucket.insert(bucket.end(), m_due.begin() + m_dueIndex, m_due.end());
+
+	m_due.clear();
+	m_dueIndex = 0;
+	m_bHaveDue = false;
+}
+
+size_t TickNextTickWheel::_hash(const TilePos& pos, int tile)
+{
+	uint32_t hash = uint32_t(pos.x) * 73856093U ^ uint32_t(pos.y) * 19349663U ^ uint32_t(pos.z) * 83492791U ^ uint32_t(tile) * 2654435761U;
+	return hash ^ (hash >> 15);
+}
+
+bool TickNextTickWheel::_addKey(const TilePos& pos, int tile)
+{
+	size_t mask = m_keys.size() - 1;
+	size_t index = _hash(pos, tile) & mask;
+
+	while (m_keys[index].m_tile >= 0)
+	{
+		if (m_keys[index].m_tile == tile && m_keys[index].m_pos == pos)
+			return false;
+
+		index = (index + 1) & mask;
+	}
+
+	m_keys[index].m_pos = pos;
+	m_keys[index].m_tile = tile;
+	m_nKeys++;
+
+	if (size_t(m_nKeys) * 2 > m_keys.size())
+		_growKeys();
+
+	return true;
+}
+
+void TickNextTickWheel::_removeKey(const TilePos& pos, int tile)
+{
+	size_t mask = m_keys.size() - 1;
+	size_t index = _hash(pos, tile) & mask;
+
+	while (m_keys[index].m_tile != tile || !(m_keys[index].m_pos == pos))
+	{
+		if (m_keys[index].m_tile < 0)
+			return;
+
+		index = (index + 1) & mask;
+	}
+
+	// Move the keys after it back into the gap, if the gap lies between them and where they'd rather be.
+	// There are no tombstones that way.
+	size_t next = index;
+	while (true)
+	{
+		next = (next + 1) & mask;
+		if (m_keys[next].m_tile < 0)
+			break;
+
+		size_t home = _hash(m_keys[next].m_pos, m_keys[next].m_tile) & mask;
+		bool bStays = index <= next ? (index < home && home <= next) : (index < home || home <= next);
+		if (bStays)
+			continue;
+
+		m_keys[index] = m_keys[next];
+		index = next;
+	}
+
+	m_keys[index].m_tile = -1;
+	m_nKeys--;
+}
+
+void TickNextTickWheel::_growKeys()
+{
+	std::vector<Key> oldKeys;
+	oldKeys.swap(m_keys);
+
+	Key key;
+	key.m_tile = -1;
+	m_keys.resize(oldKeys.size() * 2, key);
+
+	size_t mask = m_keys.size() - 1;
+	for (size_t i = 0; i < oldKeys.size(); i++)
+	{
+		if (oldKeys[i].m_tile < 0)
+			continue;
+
+		size_t index = _hash(oldKeys[i].m_pos, oldKeys[i].m_tile) & mask;
+		while (m_keys[index].m_tile >= 0)
+			index = (index + 1) & mask;
+
+		m_keys[index] = oldKeys[i];
+	}
+}
@@ -0,0 +1,66 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#pragma once
+
+#include <vector>
+#include "common/Utils.hpp"
+#include "TickNextTickData.hpp"
+
+// Custom: The pending tile ticks of a level, handed out in the same order the
+// std::set of TickNextTickData used to: lowest delay first, and of those the
+// one added first. The ticks are kept in buckets by the time they're due, the
+// bucket being the time modulo C_TICK_WHEEL_SIZE, so adding one is a push_back
+// and the next one is almost always at the front of the current bucket.
+// A tile that's waiting for a tick at some position isn't added there again
+// until that tick was handed out, like in Java Edition.
+#define C_TICK_WHEEL_SIZE (256) // must be a power of two
+
+class TickNextTickWheel
+{
+public:
+	TickNextTickWheel();
+
+	// Returns false if the same tile was already waiting for a tick there
+	bool add(const TickNextTickData& tick);
+	// The tick that's up next, or null if there are none
+	const TickNextTickData* peek();
+	// Takes away the tick peek returned
+	void pop();
+	void clear();
+	int size() const { return m_size; }
+
+private:
+	struct Key
+	{
+		TilePos m_pos;
+		int m_tile; // -1 if the slot is free
+	};
+
+	void _advance();
+	void _takeDue(int32_t time);
+	void _putBackDue();
+
+	static size_t _hash(const TilePos& pos, int tile);
+	bool _addKey(const TilePos& pos, int tile);
+	void _removeKey(const TilePos& pos, int tile);
+	void _growKeys();
+
+private:
+	std::vector<TickNextTickData> m_buckets[C_TICK_WHEEL_SIZE];
+	// the ticks due at m_time, in the order they were added. Nothing in the buckets is due before m_time.
+	std::vector<TickNextTickData> m_due;
+	size_t m_dueIndex;
+	bool m_bHaveDue;
+	int32_t m_time;
+	int m_size;
+	// open addressed, with linear probing, the positions and tiles of every tick in the wheel
+	std::vector<Key> m_keys;
+	int m_nKeys;
+};
+
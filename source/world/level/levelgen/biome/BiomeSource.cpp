@@ -35,7 +35,11 @@ BiomeSource::BiomeSource(Level* pLevel) :
 	m_pPerlinNoise[0] = new PerlinNoise(&m_Random1, 4);
 	m_pPerlinNoise[1] = new PerlinNoise(&m_Random2, 4);
 	m_pPerlinNoise[2] = new PerlinNoise(&m_Random3, 2);
+	// getRegion only allocates as much as the first call asks for,
+	// so size these for a whole chunk up front.
 	field_4 = new float[256];
+	field_8 = new float[256];
+	field_C = new float[256];
 }
 
 Biome* BiomeSource::getBiome(const ChunkPos& pos)
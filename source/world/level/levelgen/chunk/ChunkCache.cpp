@@ -62,22 +62,32 @@ LevelChunk* ChunkCache::getChunk(const ChunkPos& pos)
 			m_chunkMap[pos.z][pos.x] = pChunk;
 			pChunk->lightLava();
 
+			// have the storage read the next chunks while this one is being lit
+			if (!hasChunk(ChunkPos(pos.x + 1, pos.z)))
+				m_pChunkStorage->prefetch(ChunkPos(pos.x + 1, pos.z));
+			if (!hasChunk(ChunkPos(pos.x, pos.z + 1)))
+				m_pChunkStorage->prefetch(ChunkPos(pos.x, pos.z + 1));
+
+			//@BUG: This used to ask for the same tiles around the chunk's corner
+			// over and over, once for every column, and the old light updates
+			// merged all of those. Ask for the whole lot once instead.
 			TilePos global(pos, 0);
+			int maxHeight = 0;
 			for (int i = global.x, m = 0; m < 16; i++, m++)
 			{
 				for (int j = global.z, n = 0; n < 16; j++, n++)
 				{
 					int height = m_pLevel->getHeightmap(TilePos(i, 0, j));
-					if (height >= 0)
-					{
-						for (int k = height; k > 0; k--)
-						{
-							m_pLevel->updateLight(LightLayer::Sky,   TilePos(global.x,   k, global.z),   TilePos(global.x,   k, global.z));
-							m_pLevel->updateLight(LightLayer::Block, TilePos(global.x-1, k, global.z-1), TilePos(global.x+1, k, global.z+1));
-						}
-					}
+					if (maxHeight < height)
+						maxHeight = height;
 				}
 			}
+
+			if (maxHeight > 0)
+			{
+				m_pLevel->updateLight(LightLayer::Sky,   TilePos(global.x,   1, global.z),   TilePos(global.x,   maxHeight, global.z));
+				m_pLevel->updateLight(LightLayer::Block, TilePos(global.x-1, 1, global.z-1), TilePos(global.x+1, maxHeight, global.z+1));
+			}
 		}
 		else
 		{
@@ -87,6 +97,17 @@ LevelChunk* ChunkCache::getChunk(const ChunkPos& pos)
 
 			m_chunkMap[pos.z][pos.x] = pChunk;
 			pChunk->lightLava();
+
+			// The chunk lit its height map gaps before it could be found in
+			// here, so the light updates for those got dropped. Redo them.
+			if (!pChunk->isEmpty())
+			{
+				for (int i = 0; i < 16; i++)
+				{
+					for (int j = 0; j < 16; j++)
+						pChunk->lightGaps(ChunkTilePos(i, 0, j));
+				}
+			}
 		}
 
 		pChunk = m_chunkMap[pos.z][pos.x];
@@ -194,6 +215,19 @@ void ChunkCache::postProcess(ChunkSource* pChkSrc, const ChunkPos& pos)
 	}
 }
 
+void ChunkCache::prepareChunks(const ChunkPos& minPos, const ChunkPos& maxPos)
+{
+	// Chunks that are on disk get generated anyway, so only
+	// call this for parts of the world that haven't been saved yet.
+	if (!m_pChunkSource)
+		return;
+
+	ChunkPos lo(Mth::Max(minPos.x, 0), Mth::Max(minPos.z, 0));
+	ChunkPos hi(Mth::Min(maxPos.x, C_MAX_CHUNKS_X - 1), Mth::Min(maxPos.z, C_MAX_CHUNKS_Z - 1));
+
+	m_pChunkSource->prepareChunks(lo, hi);
+}
+
 void ChunkCache::save(LevelChunk* pChunk)
 {
 	if (m_pChunkStorage)
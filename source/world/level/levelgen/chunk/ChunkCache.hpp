@@ -27,6 +27,7 @@ public:
 	bool hasChunk(const ChunkPos& pos) override;
 	std::string gatherStats() override;
 	void postProcess(ChunkSource*, const ChunkPos& pos) override;
+	void prepareChunks(const ChunkPos& minPos, const ChunkPos& maxPos) override;
 	bool shouldSave() override;
 	void saveAll() override;
 	int tick() override;
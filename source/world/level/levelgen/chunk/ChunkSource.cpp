@@ -17,6 +17,11 @@ void ChunkSource::saveAll()
 
 }
 
+void ChunkSource::prepareChunks(const ChunkPos& minPos, const ChunkPos& maxPos)
+{
+
+}
+
 #ifdef ENH_IMPROVED_SAVING
 void ChunkSource::saveUnsaved()
 {
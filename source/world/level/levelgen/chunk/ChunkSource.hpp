@@ -27,6 +27,9 @@ public:
 	virtual bool shouldSave() = 0;
 	virtual void saveAll();
 	virtual std::string gatherStats() = 0;
+	// Lets a source build the terrain of a block of chunks in bulk ahead of time.
+	// getChunk() must still be called on every one of them afterwards.
+	virtual void prepareChunks(const ChunkPos& minPos, const ChunkPos& maxPos);
 #ifdef ENH_IMPROVED_SAVING
 	virtual void saveUnsaved();
 #endif
@@ -16,6 +16,7 @@ LevelChunk::~LevelChunk()
 	SAFE_DELETE_ARRAY(m_lightBlk.m_data);
 	SAFE_DELETE_ARRAY(m_lightSky.m_data);
 	SAFE_DELETE_ARRAY(m_tileData.m_data);
+	_clearCollisionMasks();
 }
 
 constexpr int MakeBlockDataIndex(const ChunkTilePos& pos)
@@ -46,6 +47,7 @@ void LevelChunk::_init()
 	field_238 = 0;
 	field_23C = 0;
 	m_pBlockData = nullptr;
+	m_pCollisionMasks = nullptr;
 }
 
 LevelChunk::LevelChunk(Level* pLevel, const ChunkPos& pos)
@@ -209,6 +211,15 @@ void LevelChunk::lightGaps(const ChunkTilePos& pos)
 	lightGap(TilePos(coords.x + 1, coords.y, coords.z), heightMap);
 	lightGap(TilePos(coords.x, coords.y, coords.z - 1), heightMap);
 	lightGap(TilePos(coords.x, coords.y, coords.z + 1), heightMap);
+
+	// Sky light goes on below the height map through water and the like, and
+	// nothing else tells the light engine to spread that out sideways.
+	ChunkTilePos lit(pos.x, heightMap, pos.z);
+	while (lit.y > 0 && m_lightSky.get(ChunkTilePos(pos.x, lit.y - 1, pos.z)) > 1)
+		lit.y--;
+
+	if (lit.y < heightMap)
+		m_pLevel->updateLight(LightLayer::Sky, TilePos(coords.x, lit.y, coords.z), TilePos(coords.x, heightMap - 1, coords.z));
 }
 
 void LevelChunk::lightGap(const TilePos& pos, uint8_t heightMap)
@@ -313,6 +324,7 @@ void LevelChunk::deleteBlockData()
 		delete[] m_pBlockData;
 
 	m_pBlockData = nullptr;
+	_clearCollisionMasks();
 }
 
 void LevelChunk::removeEntity(Entity* pEnt)
@@ -547,6 +559,7 @@ bool LevelChunk::setTile(const ChunkTilePos& pos, TileID tile)
 	tilePos.x += pos.x;
 	tilePos.z += pos.z;
 	m_pBlockData[index] = tile;
+	_updateCollisionMask(pos, tile);
 	if (oldTile)
 	{
 		Tile::tiles[oldTile]->onRemove(m_pLevel, tilePos);
@@ -602,6 +615,7 @@ bool LevelChunk::setTileAndData(const ChunkTilePos& pos, TileID tile, TileData d
 	tilePos.x += pos.x;
 	tilePos.z += pos.z;
 	m_pBlockData[index] = tile;
+	_updateCollisionMask(pos, tile);
 	if (oldTile)
 	{
 		Tile::tiles[oldTile]->onRemove(m_pLevel, tilePos);
@@ -666,6 +680,7 @@ bool LevelChunk::setData(const ChunkTilePos& pos, TileData data)
 void LevelChunk::setBlocks(uint8_t* pData, int y)
 {
 	LOG_I("LevelChunk::setBlocks");
+	_clearCollisionMasks();
 	for (int i = 0; i < 8192; i++)
 	{
 		m_pBlockData[8192 * y + i] = pData[i];
@@ -700,6 +715,7 @@ void LevelChunk::setBlocks(uint8_t* pData, int y)
 int LevelChunk::setBlocksAndData(uint8_t* pData, int a3, int a4, int a5, int a6, int a7, int a8, int a9)
 {
 	LOG_I("LevelChunk::setBlocksAndData");
+	_clearCollisionMasks();
 
 	if (a3 >= a6)
 	{
@@ -877,3 +893,81 @@ bool LevelChunk::isEmpty()
 {
 	return false;
 }
+
+const uint64_t* LevelChunk::getCollisionColumn(const ChunkTilePos& pos)
+{
+	buildCollisionMasks();
+
+	return &m_pCollisionMasks[MakeHeightMapIndex(pos) * C_COLLISION_MASKS * C_COLLISION_MASK_WORDS];
+}
+
+const uint64_t* LevelChunk::getPathColumn(const ChunkTilePos& pos) const
+{
+	if (!m_pCollisionMasks)
+		return nullptr;
+
+	return &m_pCollisionMasks[(MakeHeightMapIndex(pos) * C_COLLISION_MASKS + 2) * C_COLLISION_MASK_WORDS];
+}
+
+void LevelChunk::buildCollisionMasks()
+{
+	if (m_pCollisionMasks)
+		return;
+
+	m_pCollisionMasks = new uint64_t[256 * C_COLLISION_MASKS * C_COLLISION_MASK_WORDS];
+	memset(m_pCollisionMasks, 0, 256 * C_COLLISION_MASKS * C_COLLISION_MASK_WORDS * sizeof(uint64_t));
+
+	// through getTile, an empty chunk has no block data of its own
+	ChunkTilePos pos;
+	for (int x = 0; x < 16; x++)
+	{
+		for (int z = 0; z < 16; z++)
+		{
+			for (int y = C_MIN_Y; y < C_MAX_Y; y++)
+			{
+				pos = ChunkTilePos(x, y, z);
+				_updateCollisionMask(pos, getTile(pos));
+			}
+		}
+	}
+}
+
+void LevelChunk::_updateCollisionMask(const ChunkTilePos& pos, TileID tile)
+{
+	if (!m_pCollisionMasks)
+		return;
+
+	uint64_t* pCubes = &m_pCollisionMasks[MakeHeightMapIndex(pos) * C_COLLISION_MASKS * C_COLLISION_MASK_WORDS];
+	uint64_t* pCustom = pCubes + C_COLLISION_MASK_WORDS;
+	uint64_t* pPath = pCustom + C_COLLISION_MASK_WORDS;
+	uint64_t* pTiles = pPath + C_COLLISION_MASK_WORDS;
+	uint64_t bit = uint64_t(1) << (pos.y & 63);
+
+	pCubes[pos.y >> 6] &= ~bit;
+	pCustom[pos.y >> 6] &= ~bit;
+	pPath[pos.y >> 6] &= ~bit;
+	pTiles[pos.y >> 6] &= ~bit;
+
+	if (PathFinder::mayBlockPath(tile))
+		pPath[pos.y >> 6] |= bit;
+
+	if (tile != TILE_AIR)
+		pTiles[pos.y >> 6] |= bit;
+
+	switch (Tile::collisionType[tile])
+	{
+	case Tile::COLLISION_CUBE:
+		pCubes[pos.y >> 6] |= bit;
+		break;
+	case Tile::COLLISION_CUSTOM:
+		pCustom[pos.y >> 6] |= bit;
+		break;
+	}
+}
+
+void LevelChunk::_clearCollisionMasks()
+{
+	// ChunkCache deletes the block data before it deletes the chunk, so this runs twice
+	SAFE_DELETE_ARRAY(m_pCollisionMasks);
+	m_pCollisionMasks = nullptr;
+}
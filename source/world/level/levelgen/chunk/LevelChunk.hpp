@@ -21,6 +21,12 @@ class Level;
 class AABB;
 class Entity;
 
+// Custom: the words of one collision mask, one bit per tile of a column
+#define C_COLLISION_MASK_WORDS (C_MAX_Y / 64)
+// Custom: the masks kept for each column: full cubes, the other tiles that collide, what may block paths,
+// and every tile that isn't air
+#define C_COLLISION_MASKS (4)
+
 class LevelChunk
 {
 private:
@@ -72,6 +78,19 @@ public:
 	virtual bool isEmpty();
 	//...
 
+	// Custom: the collision masks of a column, the full cubes first and the tiles that have to be asked after
+	// them. Built the first time they are needed, and kept up to date by setTile and setTileAndData.
+	const uint64_t* getCollisionColumn(const ChunkTilePos& pos);
+	// Custom: the tiles of a column that PathFinder::isFree has to look at. Null until buildCollisionMasks
+	// is called, so the threads that look for paths never build the masks themselves.
+	const uint64_t* getPathColumn(const ChunkTilePos& pos) const;
+	static bool hasCollisionBit(const uint64_t* pMask, int y) { return (pMask[y >> 6] >> (y & 63)) & 1; }
+	void buildCollisionMasks();
+
+private:
+	void _updateCollisionMask(const ChunkTilePos& pos, TileID tile);
+	void _clearCollisionMasks();
+
 public:
 	static bool touchedSky;
 
@@ -94,4 +113,5 @@ public:
 	int field_23C;
 	TileID* m_pBlockData;
 	std::vector<Entity*> m_entities[128 / 16];
+	uint64_t* m_pCollisionMasks; // Custom
 };
@@ -6,9 +6,11 @@
 	SPDX-License-Identifier: BSD-1-Clause
  ********************************************************************/
 
+#include <vector>
 #include "RandomLevelSource.hpp"
 #include "world/level/Level.hpp"
 #include "world/tile/SandTile.hpp"
+#include "common/CThread.hpp"
 
 
 const float RandomLevelSource::SNOW_CUTOFF = 0.5f;
@@ -28,6 +30,7 @@ RandomLevelSource::RandomLevelSource(Level* level, int32_t seed, int version) :
 	m_perlinNoise8(&m_random, 8),
 	m_pLevel(level)
 {
+	m_pBiomeSource = nullptr;
 	field_4 = false;
 	field_19F0 = 1.0f;
 	field_7280 = nullptr;
@@ -53,6 +56,24 @@ RandomLevelSource::RandomLevelSource(Level* level, int32_t seed, int version) :
 	LOG_I("random.get : %d", random.genrand_int32() >> 1);
 }
 
+RandomLevelSource::~RandomLevelSource()
+{
+	SAFE_DELETE_ARRAY(field_7280);
+	SAFE_DELETE_ARRAY(field_7E84);
+	SAFE_DELETE_ARRAY(field_7E88);
+	SAFE_DELETE_ARRAY(field_7E8C);
+	SAFE_DELETE_ARRAY(field_7E90);
+	SAFE_DELETE_ARRAY(field_7E94);
+}
+
+BiomeSource* RandomLevelSource::_getBiomeSource()
+{
+	if (m_pBiomeSource)
+		return m_pBiomeSource;
+
+	return m_pLevel->getBiomeSource();
+}
+
 // @BUG: Potential collisions.
 inline int GetChunkHash(const ChunkPos& pos)
 {
@@ -73,16 +94,12 @@ LevelChunk* RandomLevelSource::getChunk(const ChunkPos& pos)
 		return iter->second;
 
 	// have to generate the chunk
-	m_random.init_genrand(341872712 * pos.x + 132899541 * pos.z);
-
 	TileID* pLevelData = new TileID[32768];
 
 	LevelChunk* pChunk = new LevelChunk(m_pLevel, pLevelData, pos);
 	m_chunks.insert(std::pair<int, LevelChunk*>(hashCode, pChunk));
 
-	Biome** pBiomeBlock = m_pLevel->getBiomeSource()->getBiomeBlock(TilePos(pos, 0), 16, 16);
-	prepareHeights(pos, pLevelData, nullptr, m_pLevel->getBiomeSource()->field_4);
-	buildSurfaces(pos, pLevelData, pBiomeBlock);
+	generateTerrain(pos, pLevelData);
 	pChunk->recalcHeightmap();
 
 	// @NOTE: Java Edition Beta 1.6 uses the m_largeCaveFeature.
@@ -93,6 +110,114 @@ LevelChunk* RandomLevelSource::getChunk(const ChunkPos& pos)
 	return pChunk;
 }
 
+void RandomLevelSource::generateTerrain(const ChunkPos& pos, TileID* pLevelData)
+{
+	m_random.init_genrand(341872712 * pos.x + 132899541 * pos.z);
+
+	Biome** pBiomeBlock = _getBiomeSource()->getBiomeBlock(TilePos(pos, 0), 16, 16);
+	prepareHeights(pos, pLevelData, nullptr, _getBiomeSource()->field_4);
+	buildSurfaces(pos, pLevelData, pBiomeBlock);
+}
+
+struct TerrainJobs
+{
+	Level* m_pLevel;
+	std::vector<ChunkPos> m_positions;
+	std::vector<TileID*> m_tiles;
+	CMutex m_lock;
+	int m_nextJob;
+};
+
+void* RandomLevelSource::_generateTerrainRoutine(void* ptr)
+{
+	TerrainJobs* pJobs = (TerrainJobs*)ptr;
+	Level* pLevel = pJobs->m_pLevel;
+
+	// Noise tables and scratch buffers are per instance, so every thread
+	// gets its own copies, seeded the same way as the level's.
+	BiomeSource* pBiomeSource = new BiomeSource(pLevel);
+	RandomLevelSource* pSource = new RandomLevelSource(pLevel, pLevel->getSeed(), pLevel->getLevelData()->getGeneratorVersion());
+	pSource->m_pBiomeSource = pBiomeSource;
+
+	while (true)
+	{
+		pJobs->m_lock.lock();
+		int job = pJobs->m_nextJob++;
+		pJobs->m_lock.unlock();
+
+		if (job >= int(pJobs->m_positions.size()))
+			break;
+
+		TileID* pTiles = new TileID[32768];
+		pSource->generateTerrain(pJobs->m_positions[job], pTiles);
+		pJobs->m_tiles[job] = pTiles;
+	}
+
+	delete pSource;
+	delete pBiomeSource;
+
+	return nullptr;
+}
+
+void RandomLevelSource::prepareChunks(const ChunkPos& minPos, const ChunkPos& maxPos)
+{
+	TerrainJobs jobs;
+	jobs.m_pLevel = m_pLevel;
+	jobs.m_nextJob = 0;
+
+	for (int x = minPos.x; x <= maxPos.x; x++)
+	{
+		for (int z = minPos.z; z <= maxPos.z; z++)
+		{
+			ChunkPos pos(x, z);
+			if (m_chunks.find(GetChunkHash(pos)) == m_chunks.end())
+				jobs.m_positions.push_back(pos);
+		}
+	}
+
+	if (jobs.m_positions.empty())
+		return;
+
+	jobs.m_tiles.resize(jobs.m_positions.size(), nullptr);
+
+	float startTime = float(getTimeS());
+
+	// One thread per processor, this one included. Each of them makes its own copy of the
+	// level source, so there's no point in having more than there are chunks.
+	int nThreads = CThread::getProcessorCount();
+	if (nThreads > int(jobs.m_positions.size()))
+		nThreads = int(jobs.m_positions.size());
+
+	std::vector<CThread*> threads;
+	for (int i = 1; i < nThreads; i++)
+		threads.push_back(new CThread(&RandomLevelSource::_generateTerrainRoutine, &jobs));
+
+	_generateTerrainRoutine(&jobs);
+
+	// joins the threads
+	for (size_t i = 0; i < threads.size(); i++)
+		SAFE_DELETE(threads[i]);
+
+	// The rest of getChunk() touches the level, so it stays on this thread.
+	for (size_t i = 0; i < jobs.m_positions.size(); i++)
+	{
+		const ChunkPos& pos = jobs.m_positions[i];
+		TileID* pLevelData = jobs.m_tiles[i];
+
+		LevelChunk* pChunk = new LevelChunk(m_pLevel, pLevelData, pos);
+		m_chunks.insert(std::pair<int, LevelChunk*>(GetChunkHash(pos), pChunk));
+
+		pChunk->recalcHeightmap();
+
+#ifdef TEST_CAVES
+		m_largeCaveFeature.apply(this, m_pLevel, pos.x, pos.z, pLevelData, 0);
+#endif
+	}
+
+	LOG_I("Generated terrain for %d chunks on %d threads in %.2fs", int(jobs.m_positions.size()), nThreads, float(getTimeS()) - startTime);
+	(void)startTime; // LOG_I compiles to nothing in some builds
+}
+
 LevelChunk* RandomLevelSource::getChunkDontCreate(const ChunkPos& pos)
 {
 	int hashCode = GetChunkHash(pos);
@@ -118,8 +243,8 @@ float* RandomLevelSource::getHeights(float* fptr, int a3, int a4, int a5, int a6
 		fptr = new float[a6 * a7 * a8];
 	}
 
-	float* bsf4 = m_pLevel->getBiomeSource()->field_4;
-	float* bsf8 = m_pLevel->getBiomeSource()->field_8;
+	float* bsf4 = _getBiomeSource()->field_4;
+	float* bsf8 = _getBiomeSource()->field_8;
 
 	constexpr float C_MAGIC_1 = 684.412f;
 
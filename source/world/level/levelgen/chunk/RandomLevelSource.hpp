@@ -24,6 +24,7 @@ class RandomLevelSource : public ChunkSource
 {
 public:
 	RandomLevelSource(Level*, int32_t seed, int);
+	~RandomLevelSource();
 	int tick() override;
 	bool shouldSave() override;
 	bool hasChunk(const ChunkPos& pos) override;
@@ -32,11 +33,20 @@ public:
 	LevelChunk* getChunkDontCreate(const ChunkPos& pos) override;
 	std::string gatherStats() override;
 	void postProcess(ChunkSource*, const ChunkPos& pos) override;
+	void prepareChunks(const ChunkPos& minPos, const ChunkPos& maxPos) override;
 
+	// Fills in the tiles of a chunk before post-processing. This only depends
+	// on the seed and the chunk's position, so it may run on any thread as
+	// long as every thread has a RandomLevelSource and BiomeSource of its own.
+	void generateTerrain(const ChunkPos& pos, TileID*);
 	float* getHeights(float*, int, int, int, int, int, int);
 	void prepareHeights(const ChunkPos& pos, TileID*, void*, float*);
 	void buildSurfaces (const ChunkPos& pos, TileID*, Biome**);
-	
+
+private:
+	BiomeSource* _getBiomeSource();
+	static void* _generateTerrainRoutine(void*);
+
 
 public:
 	bool field_4;
@@ -54,6 +64,8 @@ public:
 	PerlinNoise m_perlinNoise7;
 	PerlinNoise m_perlinNoise8;
 	Level* m_pLevel;
+	// If set, used instead of the level's biome source. Worker threads need their own.
+	BiomeSource* m_pBiomeSource;
 	float* field_7280;
 	float field_7284[256];
 	float field_7684[256];
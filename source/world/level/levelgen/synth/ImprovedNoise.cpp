@@ -8,6 +8,7 @@
 
 #include "ImprovedNoise.hpp"
 #include "common/Mth.hpp"
+#include "common/SIMD.hpp"
 
 ImprovedNoise::ImprovedNoise()
 {
@@ -106,6 +107,213 @@ float ImprovedNoise::noise(float x, float y, float z)
 							       grad(p[BB+1], x-1, y-1, z-1 ))));
 }
 
+#ifdef USE_SIMD
+
+// The SIMD versions below do the exact same float operations as grad(), lerp() and
+// fade(), in the same order, so a batch of lanes matches the scalar results bit for bit.
+static inline SimdFloat _gradSimd(SimdInt hash, SimdFloat x, SimdFloat y, SimdFloat z)
+{
+	SimdInt h = Simd::andi(hash, Simd::set(0xF));
+	SimdFloat u = Simd::select(Simd::cmplt(h, Simd::set(8)), x, y);
+	SimdInt xMask = Simd::ori(Simd::cmpeq(h, Simd::set(12)), Simd::cmpeq(h, Simd::set(14)));
+	SimdFloat v = Simd::select(Simd::cmplt(h, Simd::set(4)), y, Simd::select(xMask, x, z));
+	u = Simd::flipSign(u, Simd::shl31(Simd::andi(h, Simd::set(1))));
+	v = Simd::flipSign(v, Simd::shl30(Simd::andi(h, Simd::set(2))));
+	return Simd::add(u, v);
+}
+
+static inline SimdFloat _lerpSimd(SimdFloat prog, SimdFloat a, SimdFloat b)
+{
+	return Simd::add(a, Simd::mul(Simd::sub(b, a), prog));
+}
+
+static inline SimdFloat _fadeSimd(SimdFloat x)
+{
+	SimdFloat inner = Simd::add(Simd::mul(x, Simd::sub(Simd::mul(x, Simd::set(6.0f)), Simd::set(15.0f))), Simd::set(10.0f));
+	return Simd::mul(Simd::mul(Simd::mul(x, x), x), inner);
+}
+
+void ImprovedNoise::add(float* a2, float a3, float a4, float a5, int a6, int a7, int a8, float a9, float a10, float a11, float a12)
+{
+	// The inner loop is evaluated 4 samples at a time. The lattice lookups are
+	// done per sample, then the gradients and interpolation run on all lanes.
+	// Lanes past the end of a row are computed on padding and never stored.
+	SimdFloat one = Simd::set(1.0f);
+	SimdFloat zero = Simd::set(0.0f);
+	SimdFloat scale = Simd::set(1.0f / a12);
+
+	if (a7 == 1)
+	{
+		for (int i = 0; i < a6; i++)
+		{
+			float x2 = m_offsetX + a9 * (i + a3);
+			int   x3 = Mth::floor(x2);
+			float x4 = float(x3);
+			float x5 = x2 - x4;
+
+			int* x6 = &m_permutation[uint8_t(x3)];
+			int* x8 = &m_permutation[uint8_t(x3 + 1)];
+			float* x7 = &a2[a8 * i];
+
+			SimdFloat sx5 = Simd::set(x5);
+			SimdFloat sx5m1 = Simd::sub(sx5, one);
+			SimdFloat fx5 = _fadeSimd(sx5);
+
+			for (int j = 0; j < a8; j += 4)
+			{
+				int n = a8 - j < 4 ? a8 - j : 4;
+
+				float x12[4];
+				int h13[4], h15[4], h13n[4], h15n[4];
+				for (int l = 0; l < 4; l++)
+				{
+					float x9 = m_offsetZ + a11 * ((j + (l < n ? l : n - 1)) + a5);
+					int   x10 = Mth::floor(x9);
+					float x11 = float(x10);
+					x12[l] = x9 - x11;
+
+					int* x13 = &m_permutation[uint8_t(x10) + m_permutation[*x6]];
+					int* x15 = &m_permutation[uint8_t(x10) + m_permutation[*x8]];
+					h13[l] = x13[0]; h13n[l] = x13[1];
+					h15[l] = x15[0]; h15n[l] = x15[1];
+				}
+
+				SimdFloat sx12 = Simd::load(x12);
+				SimdFloat sx12m1 = Simd::sub(sx12, one);
+
+				SimdFloat x16 = _gradSimd(Simd::load(h13), sx5, zero, sx12);
+				SimdFloat x17 = _gradSimd(Simd::load(h15), sx5m1, zero, sx12);
+				SimdFloat x18 = _lerpSimd(fx5, x16, x17);
+				SimdFloat x19 = _gradSimd(Simd::load(h13n), sx5, zero, sx12m1);
+				SimdFloat x20 = _gradSimd(Simd::load(h15n), sx5m1, zero, sx12m1);
+				SimdFloat x21 = _lerpSimd(fx5, x19, x20);
+
+				float result[4];
+				Simd::store(result, Simd::mul(scale, _lerpSimd(_fadeSimd(sx12), x18, x21)));
+				for (int l = 0; l < n; l++)
+					x7[j + l] += result[l];
+			}
+		}
+
+		return;
+	}
+
+	int x35 = 0;
+
+	for (int i = 0; i < a6; i++)
+	{
+		float x36 = m_offsetX + a9 * (i + a3);
+		int   x37 = Mth::floor(x36);
+		float x38 = float(x37);
+		float x39 = x36 - x38;
+		float x40 = fade(x39);
+		if (a8 <= 0) continue;
+
+		SimdFloat sx39 = Simd::set(x39);
+		SimdFloat sx39m1 = Simd::sub(sx39, one);
+		SimdFloat sx40 = Simd::set(x40);
+
+		int* x42 = &m_permutation[uint8_t(x37)];
+		int* x43 = &m_permutation[uint8_t(x37) + 1];
+		for (int j = 0; j < a8; j++)
+		{
+			float x44 = m_offsetZ + a11 * (j + a5);
+			int   x45 = Mth::floor(x44);
+			float x46 = float(x45);
+			float x47 = x44 - x46;
+			uint8_t x48 = uint8_t(x45);
+			if (a7 <= 0) continue;
+
+			SimdFloat sx47 = Simd::set(x47);
+			SimdFloat sx47m1 = Simd::sub(sx47, one);
+			SimdFloat fx47 = _fadeSimd(sx47);
+
+			// The corner gradients only get recalculated when the Y lattice
+			// cell changes, using the Y fraction of the first sample in that
+			// cell. Every lane keeps track of which fraction that was. If all
+			// the lanes of a batch are still in the cell the last batch was
+			// all in, its corners are reused, like the scalar code does.
+			int x34 = -1;
+			float x53Cached = 0.0f;
+			bool bUniform = false;
+			SimdFloat x30 = zero, x31 = zero, x32 = zero, x33 = zero;
+
+			float* x49 = &a2[x35];
+			for (int k = 0; k < a7; k += 4)
+			{
+				int n = a7 - k < 4 ? a7 - k : 4;
+
+				float x53[4], x53c[4];
+				uint8_t bx51[4];
+				bool bChanged = false, bChangedInside = false;
+				for (int l = 0; l < 4; l++)
+				{
+					float x50 = m_offsetY + a10 * ((k + (l < n ? l : n - 1)) + a4);
+					int   x51 = Mth::floor(x50);
+					float x52 = float(x51);
+					x53[l] = x50 - x52;
+					bx51[l] = uint8_t(x51);
+
+					if (bx51[l] != x34)
+					{
+						x34 = bx51[l];
+						x53Cached = x53[l];
+						bChanged = true;
+						if (l > 0)
+							bChangedInside = true;
+					}
+
+					x53c[l] = x53Cached;
+				}
+
+				if (bChanged || !bUniform)
+				{
+					int h60[4], h61[4], h62[4], h63[4], h64[4], h65[4], h66[4], h67[4];
+					for (int l = 0; l < 4; l++)
+					{
+						int* x54 = &m_permutation[bx51[l] + *x42];
+						int  x55 = x54[0] + x48;
+						int  x56 = x54[1] + x48;
+						int* x57 = &m_permutation[bx51[l] + *x43];
+						int  x58 = x57[1] + x48;
+						int* x59 = &m_permutation[*x57 + x48];
+						h60[l] = m_permutation[x55];
+						h61[l] = x59[0];
+						h62[l] = m_permutation[x56];
+						h63[l] = m_permutation[x58];
+						h64[l] = m_permutation[x55 + 1];
+						h65[l] = x59[1];
+						h66[l] = m_permutation[x56 + 1];
+						h67[l] = m_permutation[x58 + 1];
+					}
+
+					SimdFloat sy = Simd::load(x53c);
+					SimdFloat sym1 = Simd::sub(sy, one);
+
+					x33 = _lerpSimd(sx40, _gradSimd(Simd::load(h60), sx39, sy,   sx47),   _gradSimd(Simd::load(h61), sx39m1, sy,   sx47));
+					x32 = _lerpSimd(sx40, _gradSimd(Simd::load(h62), sx39, sym1, sx47),   _gradSimd(Simd::load(h63), sx39m1, sym1, sx47));
+					x31 = _lerpSimd(sx40, _gradSimd(Simd::load(h64), sx39, sy,   sx47m1), _gradSimd(Simd::load(h65), sx39m1, sy,   sx47m1));
+					x30 = _lerpSimd(sx40, _gradSimd(Simd::load(h66), sx39, sym1, sx47m1), _gradSimd(Simd::load(h67), sx39m1, sym1, sx47m1));
+
+					bUniform = !bChangedInside;
+				}
+
+				SimdFloat fy = _fadeSimd(Simd::load(x53));
+				SimdFloat x68 = _lerpSimd(fy, x33, x32);
+				SimdFloat x69 = _lerpSimd(fy, x31, x30);
+
+				float result[4];
+				Simd::store(result, Simd::mul(scale, _lerpSimd(fx47, x68, x69)));
+				for (int l = 0; l < n; l++)
+					x49[k + l] += result[l];
+			}
+			x35 += a7;
+		}
+	}
+}
+
+#else
+
 void ImprovedNoise::add(float* a2, float a3, float a4, float a5, int a6, int a7, int a8, float a9, float a10, float a11, float a12)
 {
 	// @TODO: clean this up
@@ -211,3 +419,5 @@ void ImprovedNoise::add(float* a2, float a3, float a4, float a5, int a6, int a7,
 		}
 	}
 }
+
+#endif
@@ -41,7 +41,7 @@ void PerlinNoise::init(int nOctaves)
 PerlinNoise::~PerlinNoise()
 {
 	for (int i = 0; i < m_nOctaves; i++)
-		delete[] m_pImprovedNoise[i];
+		delete m_pImprovedNoise[i];
 
 	delete[] m_pImprovedNoise;
 }
@@ -7,13 +7,10 @@
  ********************************************************************/
 #include "PathFinder.hpp"
 #include "world/level/Level.hpp"
+#include "world/level/Region.hpp"
 #include "world/tile/DoorTile.hpp"
 #include "world/entity/Entity.hpp"
 
-static int dword_1CD868;
-static int dword_1CD86C;
-static int dword_1CD870;
-
 constexpr int MakeNodeHash(const TilePos& pos)
 {
 	// NOTE: Same as in Java Edition Beta 1.3_01
@@ -24,11 +21,20 @@ constexpr int MakeNodeHash(const TilePos& pos)
 		(pos.z < 0 ? 0x8000 : 0);
 }
 
+// Custom: spreads the hash, whose low bits are only the height, over the whole table
+constexpr size_t MakeNodeTableIndex(int hash)
+{
+	return size_t((uint32_t(hash) * 2654435761U) ^ ((uint32_t(hash) * 2654435761U) >> 16));
+}
+
 PathFinder::PathFinder()
 {
 	m_pLevel = nullptr;
 	m_nodeCount = 0;
 	m_bEntityIsDoorBreaker = false;
+	m_nodesFound = 0;
+	m_maxNodesFound = 0;
+	m_nodeTable.resize(NODE_TABLE_SIZE, nullptr);
 }
 
 PathFinder::~PathFinder()
@@ -42,6 +48,10 @@ PathFinder::~PathFinder()
 
 int PathFinder::isFree(Entity* pEntity, const TilePos& pos, const Node* node)
 {
+	// Custom: most of the time nothing's in the way, which the chunks' masks tell without asking every tile
+	if (_isClear(pos, node->m_tilePos))
+		return 1;
+
 	TilePos tp(pos);
 
 	for (tp.x = pos.x; tp.x < pos.x + node->m_tilePos.x; tp.x++)
@@ -136,18 +146,101 @@ Node* PathFinder::getNode(Entity* pEntity, const TilePos& pos, const Node* node,
 
 Node* PathFinder::getNode(const TilePos& pos)
 {
-	NodeMap::iterator iter = m_nodeMap.find(MakeNodeHash(pos));
+	int hash = MakeNodeHash(pos);
+	size_t mask = m_nodeTable.size() - 1;
+	size_t index = MakeNodeTableIndex(hash) & mask;
 
-	if (iter != m_nodeMap.end())
-		return iter->second;
+	// linear probing, nothing is ever taken out of the table until it's cleared
+	while (m_nodeTable[index])
+	{
+		if (m_nodeTable[index]->m_hash == hash)
+			return m_nodeTable[index];
+
+		index = (index + 1) & mask;
+	}
 
 	Node* pNode = new_Node(pos);
-	dword_1CD868++;
-	m_nodeMap[MakeNodeHash(pos)] = pNode;
+	m_nodesFound++;
+	m_nodeTable[index] = pNode;
+
+	if (size_t(m_nodeCount) * 2 > m_nodeTable.size())
+		_growNodeTable();
 
 	return pNode;
 }
 
+bool PathFinder::_isClear(const TilePos& pos, const TilePos& size) const
+{
+	if (m_pLevel->isSnapshot() || pos.y < C_MIN_Y || pos.y + size.y > C_MAX_Y)
+		return false;
+
+	TilePos tp(pos);
+	for (tp.x = pos.x; tp.x < pos.x + size.x; tp.x++)
+	{
+		for (tp.z = pos.z; tp.z < pos.z + size.z; tp.z++)
+		{
+			// what's outside of the region reads as air
+			LevelChunk* pChunk = m_pLevel->getChunkAt(tp);
+			if (!pChunk)
+				continue;
+
+			const uint64_t* pMask = pChunk->getPathColumn(tp);
+			if (!pMask)
+				return false;
+
+			for (int y = pos.y; y < pos.y + size.y; y++)
+			{
+				if (LevelChunk::hasCollisionBit(pMask, y))
+					return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void PathFinder::_clearNodeTable()
+{
+	memset(&m_nodeTable[0], 0, m_nodeTable.size() * sizeof(Node*));
+}
+
+void PathFinder::_growNodeTable()
+{
+	std::vector<Node*> oldTable;
+	oldTable.swap(m_nodeTable);
+	m_nodeTable.resize(oldTable.size() * 2, nullptr);
+
+	size_t mask = m_nodeTable.size() - 1;
+	for (size_t i = 0; i < oldTable.size(); i++)
+	{
+		if (!oldTable[i])
+			continue;
+
+		size_t index = MakeNodeTableIndex(oldTable[i]->m_hash) & mask;
+		while (m_nodeTable[index])
+			index = (index + 1) & mask;
+
+		m_nodeTable[index] = oldTable[i];
+	}
+}
+
+bool PathFinder::mayBlockPath(TileID tile)
+{
+	// the same questions isFree asks
+	if (tile == TILE_AIR)
+		return false;
+
+	if (tile == Tile::door_iron->m_ID || tile == Tile::door_wood->m_ID || tile == Tile::fence->m_ID)
+		return true;
+
+	Tile* pTile = Tile::tiles[tile];
+	if (!pTile)
+		return false;
+
+	Material* pMtl = pTile->m_pMaterial;
+	return pMtl->blocksMotion() || pMtl == Material::water || pMtl == Material::lava;
+}
+
 int PathFinder::getNeighbors(Entity* pEntity, Node* node1, const Node* node2, Node* node3, float maxDist)
 {
 	int nr = 0;
@@ -168,8 +261,8 @@ int PathFinder::getNeighbors(Entity* pEntity, Node* node1, const Node* node2, No
 
 bool PathFinder::reconstructPath(Path& path, Node* nodeEnd)
 {
-	if (dword_1CD870 < dword_1CD868)
-		dword_1CD870 = dword_1CD868;
+	if (m_maxNodesFound < m_nodesFound)
+		m_maxNodesFound = m_nodesFound;
 
 	int number = 1;
 	Node* temp = nodeEnd;
@@ -196,7 +289,7 @@ bool PathFinder::reconstructPath(Path& path, Node* nodeEnd)
 
 bool PathFinder::findPath(Path& path, Entity* pEntity, Node* nodeStart, Node* nodeEnd, const Node* node3, float fp)
 {
-	dword_1CD868 = 0;
+	m_nodesFound = 0;
 
 	nodeStart->field_4 = 0;
 	nodeStart->field_C = nodeStart->field_8 = nodeStart->distanceTo(nodeEnd);
@@ -255,7 +348,7 @@ bool PathFinder::findPath(Path& path, Entity* pEntity, Node* nodeStart, Node* no
 bool PathFinder::findPath(Path& path, Entity* pEntity, const Vec3& pos, float d)
 {
 	// uh?
-	m_nodeMap.clear();
+	_clearNodeTable();
 
 	m_nodeCount = 0;
 	// not treating spillover btw? or what
@@ -8,18 +8,18 @@
 #pragma once
 
 #include <vector>
-#include <map>
 #include "Path.hpp"
 #include "BinaryHeap.hpp"
+#include "common/Utils.hpp"
 #include "world/level/TilePos.hpp"
 
-class LevelSource;
+class Region;
 class Entity;
 
 #define MAX_NODE_COUNT (2048)
 #define NEIGHBORS_SIZE (32)
-
-typedef std::map <int, Node*> NodeMap;
+// Custom: twice the reserve, so the node table stays at most half full in all but the biggest searches
+#define NODE_TABLE_SIZE (MAX_NODE_COUNT * 2)
 
 class PathFinder
 {
@@ -36,22 +36,33 @@ public:
 	bool findPath(Path&, Entity*, const Entity*, float);
 	bool findPath(Path&, Entity*, const TilePos& tilePos, float);
 
-	void setLevel(LevelSource* pLevel)
+	void setLevel(Region* pLevel)
 	{
 		m_pLevel = pLevel;
 	}
 
+	// Custom: whether isFree might have something to say about a tile. If not, it's walked through
+	// whatever its data, which lets LevelChunk keep the answer in a column mask.
+	static bool mayBlockPath(TileID tile);
+
 private:
 	Node* new_Node(const TilePos& pos);
 	bool reconstructPath(Path& path, Node* node2);
+	bool _isClear(const TilePos& pos, const TilePos& size) const;
+	void _clearNodeTable();
+	void _growNodeTable();
 
 private:
-	LevelSource* m_pLevel;
+	Region* m_pLevel;
 	BinaryHeap m_binaryHeap;
-	NodeMap m_nodeMap;
+	// Custom: open addressed and found by the nodes' hashes, like the map it replaces
+	std::vector<Node*> m_nodeTable;
 	Node m_nodeReserve[MAX_NODE_COUNT];
 	std::vector<Node*> m_nodeSpillover;
 	int m_nodeCount;
 	Node* m_neighbors[NEIGHBORS_SIZE];
 	bool m_bEntityIsDoorBreaker;
+	// Custom: these were globals, but there's a PathFinder per thread now (see Level::tickEntities)
+	int m_nodesFound;
+	int m_maxNodesFound;
 };
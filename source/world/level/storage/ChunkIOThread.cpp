@@ -0,0 +1,318 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#include "ChunkIOThread.hpp"
+
+#include <algorithm>
+#include "CompressedChunkFormat.hpp"
+#include "common/Utils.hpp"
+
+#define C_IO_IDLE_SLEEP_MS (5)
+// How many read-aheads are kept until they're used. Loading the world row by
+// row asks for the chunk below each one, which is used a row later.
+#define C_READ_AHEAD_WINDOW (32)
+
+static int _getIndex(const ChunkPos& pos)
+{
+	// same layout as RegionFile's offset table
+	return pos.x + 32 * pos.z;
+}
+
+ChunkIOThread::ChunkIOThread(const std::string& levelDirPath)
+{
+	m_pRegionFile = new RegionFile(levelDirPath);
+	m_bFileOpened = false;
+	m_bStop = false;
+	m_pThread = new CThread(&ChunkIOThread::_threadRoutine, this);
+}
+
+ChunkIOThread::~ChunkIOThread()
+{
+	// the worker drains all pending writes before exiting
+	m_bStop = true;
+	SAFE_DELETE(m_pThread);
+
+	for (std::map<int, ChunkIOBuffer>::iterator it = m_pendingWrites.begin(); it != m_pendingWrites.end(); ++it)
+		delete[] it->second.m_pData;
+	for (std::map<int, ChunkIOBuffer>::iterator it = m_completedReads.begin(); it != m_completedReads.end(); ++it)
+		delete[] it->second.m_pData;
+
+	SAFE_DELETE(m_pRegionFile);
+}
+
+void* ChunkIOThread::_threadRoutine(void* ptr)
+{
+	ChunkIOThread* pThis = (ChunkIOThread*)ptr;
+
+	while (!pThis->m_bStop)
+	{
+		// writes first, so a burst of read-aheads can't hold back an autosave
+		if (pThis->_processWrite())
+			continue;
+
+		if (pThis->_processRead())
+			continue;
+
+		CThread::sleep(C_IO_IDLE_SLEEP_MS);
+	}
+
+	while (pThis->_processWrite());
+
+	return nullptr;
+}
+
+bool ChunkIOThread::_openFile()
+{
+	if (!m_bFileOpened)
+		m_bFileOpened = m_pRegionFile->open();
+
+	return m_bFileOpened;
+}
+
+bool ChunkIOThread::_readFromFile(const ChunkPos& pos, ChunkIOBuffer& buffer)
+{
+	if (!_openFile())
+		return false;
+
+	RakNet::BitStream* pBitStream = nullptr;
+	if (!m_pRegionFile->readChunk(pos, &pBitStream))
+		return false;
+
+	// the bit stream doesn't own its data, so we can keep it
+	buffer.m_pData = pBitStream->GetData();
+	buffer.m_size = pBitStream->GetNumberOfBytesUsed();
+	delete pBitStream;
+
+	return true;
+}
+
+bool ChunkIOThread::_processWrite()
+{
+	// The file lock is held for the whole write, so that anyone who no longer
+	// finds this chunk in the queue waits for it to reach the disk.
+	m_fileLock.lock();
+	m_queueLock.lock();
+
+	if (m_pendingWrites.empty())
+	{
+		m_queueLock.unlock();
+		m_fileLock.unlock();
+		return false;
+	}
+
+	std::map<int, ChunkIOBuffer>::iterator it = m_pendingWrites.begin();
+	int index = it->first;
+	ChunkIOBuffer buffer = it->second;
+	m_pendingWrites.erase(it);
+
+	m_queueLock.unlock();
+
+	ChunkPos pos(index % 32, index / 32);
+	if (buffer.m_bCompress)
+	{
+		int compressedSize = 0;
+		uint8_t* pCompressed = CompressedChunkFormat::compress(buffer.m_pData, &compressedSize);
+		if (pCompressed)
+		{
+			delete[] buffer.m_pData;
+			buffer.m_pData = pCompressed;
+			buffer.m_size = compressedSize;
+		}
+	}
+
+	if (_openFile())
+	{
+		RakNet::BitStream bs(buffer.m_pData, buffer.m_size, false);
+		m_pRegionFile->writeChunk(pos, bs);
+	}
+	else
+	{
+		LOG_W("Not saving :(   (x: %d  z: %d)", pos.x, pos.z);
+	}
+
+	m_fileLock.unlock();
+
+	delete[] buffer.m_pData;
+	return true;
+}
+
+bool ChunkIOThread::_processRead()
+{
+	m_fileLock.lock();
+	m_queueLock.lock();
+
+	int index = -1;
+	while (!m_pendingReads.empty())
+	{
+		int idx = m_pendingReads.front();
+		m_pendingReads.pop_front();
+
+		// already served from memory
+		if (m_completedReads.find(idx) != m_completedReads.end() ||
+			m_pendingWrites.find(idx) != m_pendingWrites.end())
+			continue;
+
+		index = idx;
+		break;
+	}
+
+	m_queueLock.unlock();
+
+	if (index < 0)
+	{
+		m_fileLock.unlock();
+		return false;
+	}
+
+	ChunkIOBuffer buffer;
+	buffer.m_bCompress = false;
+	if (_readFromFile(ChunkPos(index % 32, index / 32), buffer))
+	{
+		m_queueLock.lock();
+
+		// it may have been dropped, or loaded without it, while it was read
+		if (std::find(m_readAheads.begin(), m_readAheads.end(), index) != m_readAheads.end())
+			m_completedReads[index] = buffer;
+		else
+			delete[] buffer.m_pData;
+
+		m_queueLock.unlock();
+	}
+
+	m_fileLock.unlock();
+	return true;
+}
+
+void ChunkIOThread::queueWrite(const ChunkPos& pos, RakNet::BitStream& bitStream, bool bCompress)
+{
+	ChunkIOBuffer buffer;
+	buffer.m_bCompress = bCompress;
+	buffer.m_size = bitStream.GetNumberOfBytesUsed();
+	buffer.m_pData = new uint8_t[buffer.m_size];
+	memcpy(buffer.m_pData, bitStream.GetData(), buffer.m_size);
+
+	int index = _getIndex(pos);
+
+	m_queueLock.lock();
+
+	std::map<int, ChunkIOBuffer>::iterator it = m_pendingWrites.find(index);
+	if (it != m_pendingWrites.end())
+		delete[] it->second.m_pData;
+
+	m_pendingWrites[index] = buffer;
+
+	// a read-ahead of this chunk is stale now
+	_dropRead(index);
+
+	m_queueLock.unlock();
+}
+
+void ChunkIOThread::_dropRead(int index)
+{
+	m_readAheads.remove(index);
+	m_pendingReads.remove(index);
+
+	std::map<int, ChunkIOBuffer>::iterator it = m_completedReads.find(index);
+	if (it != m_completedReads.end())
+	{
+		delete[] it->second.m_pData;
+		m_completedReads.erase(it);
+	}
+}
+
+void ChunkIOThread::queueRead(const ChunkPos& pos)
+{
+	int index = _getIndex(pos);
+
+	m_queueLock.lock();
+
+	// asked for again, so it moves to the back of the window
+	std::list<int>::iterator it = std::find(m_readAheads.begin(), m_readAheads.end(), index);
+	if (it != m_readAheads.end())
+		m_readAheads.erase(it);
+	else
+		m_pendingReads.push_back(index);
+
+	m_readAheads.push_back(index);
+
+	// the player went elsewhere before these were loaded
+	while (m_readAheads.size() > C_READ_AHEAD_WINDOW)
+		_dropRead(m_readAheads.front());
+
+	m_queueLock.unlock();
+}
+
+bool ChunkIOThread::readChunk(const ChunkPos& pos, RakNet::BitStream** pBitStream)
+{
+	int index = _getIndex(pos);
+	ChunkIOBuffer buffer;
+
+	m_queueLock.lock();
+
+	std::map<int, ChunkIOBuffer>::iterator it = m_pendingWrites.find(index);
+	if (it != m_pendingWrites.end())
+	{
+		// the newest data hasn't hit the disk yet
+		buffer.m_bCompress = false;
+		buffer.m_size = it->second.m_size;
+		buffer.m_pData = new uint8_t[buffer.m_size];
+		memcpy(buffer.m_pData, it->second.m_pData, buffer.m_size);
+
+		m_queueLock.unlock();
+
+		*pBitStream = new RakNet::BitStream(buffer.m_pData, buffer.m_size, false);
+		return true;
+	}
+
+	it = m_completedReads.find(index);
+	if (it != m_completedReads.end())
+	{
+		buffer = it->second;
+		m_completedReads.erase(it);
+		m_readAheads.remove(index);
+
+		m_queueLock.unlock();
+
+		*pBitStream = new RakNet::BitStream(buffer.m_pData, buffer.m_size, false);
+		return true;
+	}
+
+	// it's read here, so a read-ahead of it would never be used
+	_dropRead(index);
+
+	m_queueLock.unlock();
+
+	m_fileLock.lock();
+	bool bRead = _readFromFile(pos, buffer);
+	m_fileLock.unlock();
+
+	if (!bRead)
+		return false;
+
+	*pBitStream = new RakNet::BitStream(buffer.m_pData, buffer.m_size, false);
+	return true;
+}
+
+void ChunkIOThread::flush()
+{
+	while (true)
+	{
+		m_queueLock.lock();
+		bool bEmpty = m_pendingWrites.empty();
+		m_queueLock.unlock();
+
+		if (bEmpty)
+			break;
+
+		CThread::sleep(1);
+	}
+
+	// wait for the write that may still be in flight
+	m_fileLock.lock();
+	m_fileLock.unlock();
+}
@@ -0,0 +1,75 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#pragma once
+
+#include <map>
+#include <list>
+#include <string>
+#include <stdint.h>
+#include "common/CThread.hpp"
+#include "RegionFile.hpp"
+
+// ChunkIOThread - Owns the level's RegionFile and performs all chunk reads
+// and writes on a dedicated worker, so autosaves don't stall the game thread.
+//
+// Writes are queued as serialized snapshots and coalesced per chunk. Reads
+// can be requested ahead of time; completed reads wait in a queue until the
+// chunk is actually loaded through readChunk(). Only the latest few read-aheads
+// are kept, so the ones for chunks that never get loaded don't pile up.
+
+struct ChunkIOBuffer
+{
+	uint8_t* m_pData;
+	unsigned int m_size;
+	// convert to CompressedChunkFormat before writing
+	bool m_bCompress;
+};
+
+class ChunkIOThread
+{
+public:
+	ChunkIOThread(const std::string& levelDirPath);
+	~ChunkIOThread();
+
+	// Copies the contents of the bit stream. Replaces any write still pending for this chunk.
+	// Compression, if requested, is done on the worker. Pending writes are always served raw.
+	void queueWrite(const ChunkPos& pos, RakNet::BitStream& bitStream, bool bCompress);
+	// Asks the worker to read this chunk ahead of time. Drops the oldest read-ahead
+	// that wasn't used if there are too many.
+	void queueRead(const ChunkPos& pos);
+	// Same contract as RegionFile::readChunk. Serves pending writes and completed
+	// read-aheads first, and falls back to a blocking read.
+	bool readChunk(const ChunkPos& pos, RakNet::BitStream** pBitStream);
+	// Blocks until every queued write has reached the disk.
+	void flush();
+
+private:
+	static void* _threadRoutine(void* ptr);
+	bool _openFile();
+	bool _processWrite();
+	bool _processRead();
+	bool _readFromFile(const ChunkPos& pos, ChunkIOBuffer& buffer);
+	// Forgets a read-ahead, read or not. m_queueLock must be held.
+	void _dropRead(int index);
+
+private:
+	RegionFile* m_pRegionFile;
+	bool m_bFileOpened;
+	// Guards m_pendingWrites, m_readAheads, m_pendingReads and m_completedReads
+	CMutex m_queueLock;
+	// Guards m_pRegionFile. Always taken before m_queueLock.
+	CMutex m_fileLock;
+	std::map<int, ChunkIOBuffer> m_pendingWrites;
+	// every read-ahead that wasn't used yet, oldest first
+	std::list<int> m_readAheads;
+	std::list<int> m_pendingReads;
+	std::map<int, ChunkIOBuffer> m_completedReads;
+	volatile bool m_bStop;
+	CThread* m_pThread;
+};
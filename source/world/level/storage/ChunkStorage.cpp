@@ -17,6 +17,10 @@ LevelChunk* ChunkStorage::load(Level* level, const ChunkPos& pos)
 	return 0;
 }
 
+void ChunkStorage::prefetch(const ChunkPos& pos)
+{
+}
+
 void ChunkStorage::save(Level* level, LevelChunk* chunk)
 {
 }
@@ -21,6 +21,8 @@ class ChunkStorage
 public:
 	virtual ~ChunkStorage();
 	virtual LevelChunk* load(Level*, const ChunkPos& pos);
+	// Hints that the chunk will be loaded soon. Positions outside the world are ignored
+	virtual void prefetch(const ChunkPos& pos);
 	virtual void save(Level*, LevelChunk*);
 	void saveEntities(Level* level) { saveEntities(level, nullptr); }
 	virtual void saveEntities(Level* level, LevelChunk* chunk);
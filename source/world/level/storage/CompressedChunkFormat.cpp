@@ -0,0 +1,212 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#include <cstring>
+#include "CompressedChunkFormat.hpp"
+#include "common/Utils.hpp"
+
+#define C_SECTIONS       (128 / 16)
+#define C_SECTION_TILES  (16 * 16 * 16)
+#define C_SECTION_NIBBLE (C_SECTION_TILES / 2)
+
+// offsets of the arrays inside a raw chunk
+#define C_RAW_TILES      (0)
+#define C_RAW_DATA       (C_RAW_TILES    + 16 * 16 * 128)
+#define C_RAW_SKY_LIGHT  (C_RAW_DATA     + 16 * 16 * 128 / 2)
+#define C_RAW_BLK_LIGHT  (C_RAW_SKY_LIGHT + 16 * 16 * 128 / 2)
+#define C_RAW_UPDATE_MAP (C_RAW_BLK_LIGHT + 16 * 16 * 128 / 2)
+
+// magic + uncompressed size
+#define C_HEADER_SIZE (8)
+// worst case: every section has a full palette and 8 bit indices
+#define C_MAX_PAYLOAD_SIZE (C_SECTIONS * (1 + 256 + C_SECTION_TILES + 3 * C_SECTION_NIBBLE) + 256)
+
+static const uint8_t g_magic[4] = { 'C', 'H', 'K', '3' };
+
+static int _getBitsPerIndex(int paletteSize)
+{
+	if (paletteSize <= 1)  return 0;
+	if (paletteSize <= 2)  return 1;
+	if (paletteSize <= 4)  return 2;
+	if (paletteSize <= 16) return 4;
+	return 8;
+}
+
+// Chunk arrays are indexed (x << 11) | (z << 7) | y, so every column holds
+// 16 contiguous tiles (8 contiguous nibble bytes) of each section.
+static int _getColumnOffset(int column, int section)
+{
+	return (column << 7) | (section << 4);
+}
+
+bool CompressedChunkFormat::isCompressed(const uint8_t* pData, int size)
+{
+	if (size == C_RAW_CHUNK_SIZE || size < C_HEADER_SIZE)
+		return false;
+
+	return memcmp(pData, g_magic, sizeof g_magic) == 0;
+}
+
+uint8_t* CompressedChunkFormat::compress(const uint8_t* pRaw, int* pSizeOut)
+{
+	uint8_t* pPayload = new uint8_t[C_MAX_PAYLOAD_SIZE];
+	int size = 0;
+
+	for (int s = 0; s < C_SECTIONS; s++)
+	{
+		int16_t paletteIndex[256];
+		memset(paletteIndex, 0xFF, sizeof paletteIndex);
+
+		uint8_t palette[256];
+		int paletteSize = 0;
+
+		for (int c = 0; c < 256; c++)
+		{
+			const uint8_t* pTiles = pRaw + C_RAW_TILES + _getColumnOffset(c, s);
+			for (int y = 0; y < 16; y++)
+			{
+				if (paletteIndex[pTiles[y]] >= 0)
+					continue;
+
+				paletteIndex[pTiles[y]] = int16_t(paletteSize);
+				palette[paletteSize++] = pTiles[y];
+			}
+		}
+
+		pPayload[size++] = uint8_t(paletteSize - 1);
+		memcpy(pPayload + size, palette, paletteSize);
+		size += paletteSize;
+
+		int bits = _getBitsPerIndex(paletteSize);
+		if (bits)
+		{
+			int packedSize = C_SECTION_TILES * bits / 8;
+			uint8_t* pPacked = pPayload + size;
+			memset(pPacked, 0, packedSize);
+
+			for (int c = 0, i = 0; c < 256; c++)
+			{
+				const uint8_t* pTiles = pRaw + C_RAW_TILES + _getColumnOffset(c, s);
+				for (int y = 0; y < 16; y++, i++)
+				{
+					int bit = i * bits;
+					pPacked[bit >> 3] |= uint8_t(paletteIndex[pTiles[y]] << (bit & 7));
+				}
+			}
+
+			size += packedSize;
+		}
+
+		static const int nibbleArrays[] = { C_RAW_DATA, C_RAW_SKY_LIGHT, C_RAW_BLK_LIGHT };
+		for (int a = 0; a < 3; a++)
+		{
+			for (int c = 0; c < 256; c++)
+			{
+				memcpy(pPayload + size, pRaw + nibbleArrays[a] + (_getColumnOffset(c, s) >> 1), 8);
+				size += 8;
+			}
+		}
+	}
+
+	memcpy(pPayload + size, pRaw + C_RAW_UPDATE_MAP, 256);
+	size += 256;
+
+	size_t compressedSize = 0;
+	uint8_t* pCompressed = ZlibDeflateToMemory(pPayload, size, &compressedSize);
+	SAFE_DELETE_ARRAY(pPayload);
+
+	if (!pCompressed)
+		return nullptr;
+
+	uint8_t* pOut = new uint8_t[C_HEADER_SIZE + compressedSize];
+	memcpy(pOut, g_magic, sizeof g_magic);
+	memcpy(pOut + 4, &size, sizeof(int));
+	memcpy(pOut + C_HEADER_SIZE, pCompressed, compressedSize);
+	SAFE_DELETE_ARRAY(pCompressed);
+
+	*pSizeOut = int(C_HEADER_SIZE + compressedSize);
+	return pOut;
+}
+
+uint8_t* CompressedChunkFormat::decompress(const uint8_t* pData, int size)
+{
+	if (!isCompressed(pData, size))
+		return nullptr;
+
+	int payloadSize = 0;
+	memcpy(&payloadSize, pData + 4, sizeof(int));
+	if (payloadSize <= 0 || payloadSize > C_MAX_PAYLOAD_SIZE)
+		return nullptr;
+
+	uint8_t* pPayload = ZlibInflateToMemory((uint8_t*)pData + C_HEADER_SIZE, size - C_HEADER_SIZE, payloadSize);
+	if (!pPayload)
+		return nullptr;
+
+	uint8_t* pRaw = new uint8_t[C_RAW_CHUNK_SIZE];
+	int pos = 0;
+
+	for (int s = 0; s < C_SECTIONS; s++)
+	{
+		if (pos + 1 > payloadSize)
+			goto _corrupt;
+
+		int paletteSize = pPayload[pos++] + 1;
+		int bits = _getBitsPerIndex(paletteSize);
+		int packedSize = C_SECTION_TILES * bits / 8;
+
+		if (pos + paletteSize + packedSize + 3 * C_SECTION_NIBBLE > payloadSize)
+			goto _corrupt;
+
+		const uint8_t* palette = pPayload + pos;
+		const uint8_t* pPacked = palette + paletteSize;
+		pos += paletteSize + packedSize;
+
+		int mask = (1 << bits) - 1;
+		for (int c = 0, i = 0; c < 256; c++)
+		{
+			uint8_t* pTiles = pRaw + C_RAW_TILES + _getColumnOffset(c, s);
+			for (int y = 0; y < 16; y++, i++)
+			{
+				int index = 0;
+				if (bits)
+				{
+					int bit = i * bits;
+					index = (pPacked[bit >> 3] >> (bit & 7)) & mask;
+				}
+
+				if (index >= paletteSize)
+					goto _corrupt;
+
+				pTiles[y] = palette[index];
+			}
+		}
+
+		static const int nibbleArrays[] = { C_RAW_DATA, C_RAW_SKY_LIGHT, C_RAW_BLK_LIGHT };
+		for (int a = 0; a < 3; a++)
+		{
+			for (int c = 0; c < 256; c++)
+			{
+				memcpy(pRaw + nibbleArrays[a] + (_getColumnOffset(c, s) >> 1), pPayload + pos, 8);
+				pos += 8;
+			}
+		}
+	}
+
+	if (pos + 256 > payloadSize)
+		goto _corrupt;
+
+	memcpy(pRaw + C_RAW_UPDATE_MAP, pPayload + pos, 256);
+
+	SAFE_DELETE_ARRAY(pPayload);
+	return pRaw;
+
+_corrupt:
+	SAFE_DELETE_ARRAY(pPayload);
+	SAFE_DELETE_ARRAY(pRaw);
+	return nullptr;
+}
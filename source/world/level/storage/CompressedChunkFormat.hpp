@@ -0,0 +1,33 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+// Size of a chunk as written by ExternalFileLevelStorage::save: tile IDs,
+// tile data, sky light and block light, followed by the update map.
+#define C_RAW_CHUNK_SIZE (16 * 16 * 128 * 1 + 16 * 16 * 128 / 2 * 3 + 256)
+
+// Chunk format used from storage version 3 onwards.
+//
+// Every 16-high section stores its tile IDs as indices into a palette of the
+// IDs it actually contains, packed into 0, 1, 2, 4 or 8 bits each. The nibble
+// arrays of the section follow, and the whole chunk is deflated with zlib.
+// Chunks saved by older versions are raw arrays of a fixed size, so both
+// kinds can be told apart and live in the same chunks.dat.
+class CompressedChunkFormat
+{
+public:
+	static bool isCompressed(const uint8_t* pData, int size);
+	// Takes a raw chunk of C_RAW_CHUNK_SIZE bytes. You must SAFE_DELETE_ARRAY what it returns.
+	static uint8_t* compress(const uint8_t* pRaw, int* pSizeOut);
+	// Returns a raw chunk of C_RAW_CHUNK_SIZE bytes, or null if the data is corrupt.
+	// You must SAFE_DELETE_ARRAY what it returns.
+	static uint8_t* decompress(const uint8_t* pData, int size);
+};
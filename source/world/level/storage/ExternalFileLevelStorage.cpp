@@ -9,6 +9,7 @@
 #include <stdint.h>
 
 #include "ExternalFileLevelStorage.hpp"
+#include "CompressedChunkFormat.hpp"
 #include "world/level/Level.hpp"
 #include "GetTime.h"
 #include "nbt/CompoundTag.hpp"
@@ -33,6 +34,10 @@ ExternalFileLevelStorage::ExternalFileLevelStorage(const std::string& name, cons
 
 	createFolderIfNotExists(m_levelDirPath.c_str());
 
+#ifdef ENH_ASYNC_CHUNK_IO
+	m_pIOThread = new ChunkIOThread(m_levelDirPath);
+#endif
+
 	std::string datLevel  = m_levelDirPath + "/" + "level.dat";
 	std::string datPlayer = m_levelDirPath + "/" + "player.dat";
 
@@ -54,6 +59,10 @@ ExternalFileLevelStorage::ExternalFileLevelStorage(const std::string& name, cons
 
 ExternalFileLevelStorage::~ExternalFileLevelStorage()
 {
+#ifdef ENH_ASYNC_CHUNK_IO
+	// finishes all queued writes
+	SAFE_DELETE(m_pIOThread);
+#endif
 	SAFE_DELETE(m_pRegionFile);
 	SAFE_DELETE(m_pLevelData);
 }
@@ -212,10 +221,25 @@ void ExternalFileLevelStorage::tick()
 
 void ExternalFileLevelStorage::flush()
 {
+#ifdef ENH_ASYNC_CHUNK_IO
+	m_pIOThread->flush();
+#endif
 }
 
 LevelChunk* ExternalFileLevelStorage::load(Level* level, const ChunkPos& pos)
 {
+#ifdef ENH_ASYNC_CHUNK_IO
+	RakNet::BitStream* pBitStream = nullptr;
+	if (!m_pIOThread->readChunk(pos, &pBitStream))
+		return nullptr;
+
+	LevelChunk* pChunk = _readChunk(level, pos, *pBitStream);
+
+	delete[] pBitStream->GetData();
+	delete pBitStream;
+
+	return pChunk;
+#else
 	if (!m_pRegionFile)
 	{
 		m_pRegionFile = new RegionFile(m_levelDirPath);
@@ -229,28 +253,63 @@ LevelChunk* ExternalFileLevelStorage::load(Level* level, const ChunkPos& pos)
 		}
 	}
 
-	RakNet::BitStream* pBitStream = nullptr;
-	if (!m_pRegionFile->readChunk(pos, &pBitStream))
+	const uint8_t* pData = nullptr;
+	int length = 0;
+	if (!m_pRegionFile->readChunkView(pos, &pData, &length))
 		return nullptr;
 
-	pBitStream->ResetReadPointer();
+	// read the arrays straight out of the region file's view
+	RakNet::BitStream bs((unsigned char*)pData, length, false);
+	return _readChunk(level, pos, bs);
+#endif
+}
+
+LevelChunk* ExternalFileLevelStorage::_readChunk(Level* level, const ChunkPos& pos, RakNet::BitStream& bs)
+{
+	if (CompressedChunkFormat::isCompressed(bs.GetData(), bs.GetNumberOfBytesUsed()))
+	{
+		uint8_t* pRaw = CompressedChunkFormat::decompress(bs.GetData(), bs.GetNumberOfBytesUsed());
+		if (!pRaw)
+		{
+			LOG_W("Chunk is corrupted, regenerating   (x: %d  z: %d)", pos.x, pos.z);
+			return nullptr;
+		}
+
+		RakNet::BitStream rawBs(pRaw, C_RAW_CHUNK_SIZE, false);
+		LevelChunk* pChunk = _readRawChunk(level, pos, rawBs, true);
+		SAFE_DELETE_ARRAY(pRaw);
+
+		return pChunk;
+	}
+
+	LevelChunk* pChunk = _readRawChunk(level, pos, bs, m_storageVersion >= 1);
+
+#ifndef ENH_DISABLE_FORCED_SAVE_UPGRADES
+	// rewrite it in the current format on the next autosave
+	if (m_bForceConversion)
+		pChunk->m_bUnsaved = true;
+#endif
+
+	return pChunk;
+}
+
+LevelChunk* ExternalFileLevelStorage::_readRawChunk(Level* level, const ChunkPos& pos, RakNet::BitStream& bs, bool bHasLight)
+{
+	bs.ResetReadPointer();
 
 	TileID* pData = new TileID[16 * 16 * 128];
-	pBitStream->Read((char*)pData, 16 * 16 * 128 * sizeof(TileID));
+	bs.Read((char*)pData, 16 * 16 * 128 * sizeof(TileID));
 
 	LevelChunk* pChunk = new LevelChunk(level, pData, pos);
-	pBitStream->Read((char*)pChunk->m_tileData.m_data, 16 * 16 * 128 / 2);
+	bs.Read((char*)pChunk->m_tileData.m_data, 16 * 16 * 128 / 2);
 
-	if (m_storageVersion >= 1)
+	if (bHasLight)
 	{
-		pBitStream->Read((char*)pChunk->m_lightSky.m_data, 16 * 16 * 128 / 2);
-		pBitStream->Read((char*)pChunk->m_lightBlk.m_data, 16 * 16 * 128 / 2);
+		bs.Read((char*)pChunk->m_lightSky.m_data, 16 * 16 * 128 / 2);
+		bs.Read((char*)pChunk->m_lightBlk.m_data, 16 * 16 * 128 / 2);
 	}
 
-	pBitStream->Read((char*)pChunk->m_updateMap, sizeof pChunk->m_updateMap);
-	
-	delete pBitStream->GetData();
-	delete pBitStream;
+	bs.Read((char*)pChunk->m_updateMap, sizeof pChunk->m_updateMap);
 
 	pChunk->recalcHeightmap();
 	pChunk->m_bUnsaved = false;
@@ -260,6 +319,17 @@ LevelChunk* ExternalFileLevelStorage::load(Level* level, const ChunkPos& pos)
 	return pChunk;
 }
 
+void ExternalFileLevelStorage::prefetch(const ChunkPos& pos)
+{
+#ifdef ENH_ASYNC_CHUNK_IO
+	// there's nothing to read past the edges of the world
+	if (pos.x < 0 || pos.z < 0 || pos.x >= C_MAX_CHUNKS_X || pos.z >= C_MAX_CHUNKS_Z)
+		return;
+
+	m_pIOThread->queueRead(pos);
+#endif
+}
+
 void ExternalFileLevelStorage::loadEntities(Level* level, LevelChunk* chunk)
 {
 	m_lastEntitySave = m_timer;
@@ -323,6 +393,7 @@ void ExternalFileLevelStorage::loadEntities(Level* level, LevelChunk* chunk)
 
 void ExternalFileLevelStorage::save(Level* level, LevelChunk* chunk)
 {
+#ifndef ENH_ASYNC_CHUNK_IO
 	if (!m_pRegionFile)
 		m_pRegionFile = new RegionFile(m_levelDirPath);
 
@@ -334,7 +405,9 @@ void ExternalFileLevelStorage::save(Level* level, LevelChunk* chunk)
 		LOG_W("Not saving :(   (x: %d  z: %d)", chunk->m_chunkPos.x, chunk->m_chunkPos.z);
 		return;
 	}
+#endif
 
+	// Snapshot the chunk's arrays. With ENH_ASYNC_CHUNK_IO this is all the game thread does.
 	RakNet::BitStream bs;
 	bs.Write((const char*)chunk->m_pBlockData,        16 * 16 * 128 * sizeof(TileID));
 	bs.Write((const char*)chunk->m_tileData.m_data, chunk->m_tileData.m_size);
@@ -347,7 +420,27 @@ void ExternalFileLevelStorage::save(Level* level, LevelChunk* chunk)
 
 	bs.Write((const char*)chunk->m_updateMap, sizeof chunk->m_updateMap);
 
-	m_pRegionFile->writeChunk(chunk->m_chunkPos, bs);
+	bool bCompress = m_pLevelData->getStorageVersion() >= 3;
+
+#ifdef ENH_ASYNC_CHUNK_IO
+	m_pIOThread->queueWrite(chunk->m_chunkPos, bs, bCompress);
+#else
+	int compressedSize = 0;
+	uint8_t* pCompressed = nullptr;
+	if (bCompress)
+		pCompressed = CompressedChunkFormat::compress(bs.GetData(), &compressedSize);
+
+	if (pCompressed)
+	{
+		RakNet::BitStream compressedBs(pCompressed, compressedSize, false);
+		m_pRegionFile->writeChunk(chunk->m_chunkPos, compressedBs);
+		SAFE_DELETE_ARRAY(pCompressed);
+	}
+	else
+	{
+		m_pRegionFile->writeChunk(chunk->m_chunkPos, bs);
+	}
+#endif
 }
 
 void ExternalFileLevelStorage::saveEntities(Level* level, LevelChunk* chunk)
@@ -420,7 +513,7 @@ bool ExternalFileLevelStorage::readLevelData(const std::string& path, LevelData&
 	{
 		levelData.v1_read(bs, version);
 	}
-	else if (version == 2)
+	else if (version >= 2)
 	{
 		levelData.read(bs, version);
 	}
@@ -12,6 +12,7 @@
 #include "LevelStorage.hpp"
 #include "ChunkStorage.hpp"
 #include "RegionFile.hpp"
+#include "ChunkIOThread.hpp"
 
 #ifndef DEMO
 
@@ -30,6 +31,8 @@ public:
 
 private:
 	void _setLevelData(LevelData* levelData);
+	LevelChunk* _readChunk(Level* level, const ChunkPos& pos, RakNet::BitStream& bs);
+	LevelChunk* _readRawChunk(Level* level, const ChunkPos& pos, RakNet::BitStream& bs, bool bHasLight);
 
 public:
 	// LevelStorage
@@ -45,6 +48,7 @@ public:
 
 	// ChunkStorage
 	LevelChunk* load(Level* level, const ChunkPos& pos) override;
+	void prefetch(const ChunkPos& pos) override;
 	void loadEntities(Level* level, LevelChunk* chunk) override;
 	void save(Level* level, LevelChunk* chunk) override;
 	void saveEntities(Level* level, LevelChunk* chunk) override;
@@ -58,6 +62,9 @@ public:
 	std::string m_levelDirPath;
 	LevelData* m_pLevelData;
 	RegionFile* m_pRegionFile;
+#ifdef ENH_ASYNC_CHUNK_IO
+	ChunkIOThread* m_pIOThread;
+#endif
 	Level* m_pLevel;
 	int m_timer;
 	unsigned int m_storageVersion;
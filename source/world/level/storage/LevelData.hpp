@@ -14,7 +14,10 @@
 #include "world/phys/Vec3.hpp"
 #include "world/item/Inventory.hpp"
 
-#define LEVEL_STORAGE_VERSION_DEFAULT 2
+// 1 - level.dat in a raw binary format, with a separate player.dat
+// 2 - level.dat as NBT
+// 3 - chunks are stored in the palette compressed CompressedChunkFormat
+#define LEVEL_STORAGE_VERSION_DEFAULT 3
 
 struct PlayerData
 {
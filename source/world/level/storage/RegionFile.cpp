@@ -1,5 +1,13 @@
+#include <cstring>
 #include "RegionFile.hpp"
 
+#ifdef USE_MMAP_REGION_FILE
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #define SECTOR_BYTES (4096)
 
 static void void_sub(int a, int b)
@@ -13,6 +21,12 @@ RegionFile::RegionFile(const std::string fileName)
 {
 	m_pFile = nullptr;
 	m_fileName = fileName + "/" + "chunks.dat";
+	m_nSectors = 0;
+
+#ifdef USE_MMAP_REGION_FILE
+	m_fd = -1;
+	m_pMapping = nullptr;
+#endif
 
 	field_20 = new int[1024];
 	field_24 = new int[1024];
@@ -28,53 +42,218 @@ RegionFile::~RegionFile()
 
 void RegionFile::close()
 {
+#ifdef USE_MMAP_REGION_FILE
+	if (m_pMapping)
+	{
+		munmap(m_pMapping, size_t(m_nSectors) * SECTOR_BYTES);
+		m_pMapping = nullptr;
+	}
+
+	if (m_fd >= 0)
+	{
+		::close(m_fd);
+		m_fd = -1;
+	}
+#endif
+
 	if (m_pFile)
 	{
 		fclose(m_pFile);
 		m_pFile = nullptr;
 	}
+
+	m_nSectors = 0;
 }
 
 bool RegionFile::open()
 {
 	close();
 	memset(field_20, 0, 1024 * sizeof(int));
-	
+	m_sectorBitmap.clear();
+
+#ifdef USE_MMAP_REGION_FILE
+	m_fd = ::open(m_fileName.c_str(), O_RDWR | O_CREAT, 0644);
+	if (m_fd < 0)
+		return false;
+
+	struct stat st;
+	if (fstat(m_fd, &st) != 0)
+	{
+		close();
+		return false;
+	}
+
+	// a new file only holds the offset table
+	int nSectors = int(st.st_size / SECTOR_BYTES);
+	if (nSectors < 1)
+		nSectors = 1;
+
+	if (!_resize(nSectors))
+	{
+		close();
+		return false;
+	}
+
+	memcpy(field_20, m_pMapping, 1024 * sizeof(int));
+#else
 	m_pFile = fopen(m_fileName.c_str(), "r+b");
 	if (m_pFile)
 	{
 		READ(field_20, sizeof(int), 1024, m_pFile);
-		
-		field_28[0] = false;
 
-		for (int i = 0; i < 1024; i++)
+		fseek(m_pFile, 0, SEEK_END);
+		m_nSectors = int(ftell(m_pFile) / SECTOR_BYTES);
+	}
+	else
+	{
+		m_pFile = fopen(m_fileName.c_str(), "w+b");
+		if (!m_pFile)
+			return false;
+
+		WRITE(field_20, sizeof(int), 1024, m_pFile);
+		m_nSectors = 1;
+	}
+#endif
+
+	_setSectorUsed(0, true);
+
+	for (int i = 0; i < 1024; i++)
+	{
+		int v13 = this->field_20[i];
+		if (v13)
 		{
-			int v13 = this->field_20[i];
-			if (v13)
+			int v12 = v13 >> 8;
+			int v11 = uint8_t(v13);
+			for (int j = 0; j < v11; ++j)
 			{
-				int v12 = v13 >> 8;
-				int v11 = uint8_t(v13);
-				for (int j = 0; j < v11; ++j)
-				{
-					field_28[j + v12] = false;
-				}
+				_setSectorUsed(j + v12, true);
 			}
 		}
+	}
+
+	return true;
+}
+
+bool RegionFile::_readAt(int offset, void* pData, int size)
+{
+#ifdef USE_MMAP_REGION_FILE
+	if (offset + size > m_nSectors * SECTOR_BYTES)
+		return false;
+
+	memcpy(pData, m_pMapping + offset, size);
+	return true;
+#else
+	fseek(m_pFile, offset, SEEK_SET);
+	return int(fread(pData, 1, size, m_pFile)) == size;
+#endif
+}
+
+bool RegionFile::_writeAt(int offset, const void* pData, int size)
+{
+#ifdef USE_MMAP_REGION_FILE
+	if (offset + size > m_nSectors * SECTOR_BYTES)
+		return false;
 
-		return m_pFile != nullptr;
+	memcpy(m_pMapping + offset, pData, size);
+	return true;
+#else
+	fseek(m_pFile, offset, SEEK_SET);
+	return int(fwrite(pData, 1, size, m_pFile)) == size;
+#endif
+}
+
+bool RegionFile::_resize(int nSectors)
+{
+#ifdef USE_MMAP_REGION_FILE
+	if (m_pMapping)
+	{
+		munmap(m_pMapping, size_t(m_nSectors) * SECTOR_BYTES);
+		m_pMapping = nullptr;
 	}
 
-	m_pFile = fopen(m_fileName.c_str(), "w+b");
-	if (!m_pFile)
+	m_nSectors = 0;
+
+	size_t size = size_t(nSectors) * SECTOR_BYTES;
+
+	// new sectors read back as zeroes, same as the ones the stdio path appends
+	if (ftruncate(m_fd, off_t(size)) != 0)
+		return false;
+
+	void* pMapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+	if (pMapping == MAP_FAILED)
 		return false;
 
-	WRITE(field_20, sizeof(int), 1024, m_pFile);
-	field_28[0] = false;
+	m_pMapping = (uint8_t*)pMapping;
+#else
+	fseek(m_pFile, 0, SEEK_END);
+	for (int i = m_nSectors; i < nSectors; i++)
+	{
+		WRITE(field_24, sizeof(int), 1024, m_pFile);
+	}
+#endif
 
+	m_nSectors = nSectors;
 	return true;
 }
 
-bool RegionFile::readChunk(const ChunkPos& pos, RakNet::BitStream** pBitStream)
+bool RegionFile::_isSectorUsed(int sector) const
+{
+	unsigned int word = unsigned(sector) >> 5;
+	if (word >= m_sectorBitmap.size())
+		return false;
+
+	return (m_sectorBitmap[word] >> (sector & 31)) & 1;
+}
+
+void RegionFile::_setSectorUsed(int sector, bool bUsed)
+{
+	unsigned int word = unsigned(sector) >> 5;
+	if (word >= m_sectorBitmap.size())
+		m_sectorBitmap.resize(word + 1, 0);
+
+	if (bUsed)
+		m_sectorBitmap[word] |=  (1U << (sector & 31));
+	else
+		m_sectorBitmap[word] &= ~(1U << (sector & 31));
+}
+
+int RegionFile::_findFreeSectors(int count) const
+{
+	// first fit
+	int runStart = 0, runLength = 0;
+	for (int i = 0; i < m_nSectors; )
+	{
+		// skip over completely used words
+		if ((i & 31) == 0 && unsigned(i >> 5) < m_sectorBitmap.size() && m_sectorBitmap[i >> 5] == 0xFFFFFFFF)
+		{
+			i += 32;
+			runStart = i;
+			runLength = 0;
+			continue;
+		}
+
+		if (_isSectorUsed(i))
+		{
+			runStart = i + 1;
+			runLength = 0;
+		}
+		else if (++runLength == count)
+		{
+			return runStart;
+		}
+
+		i++;
+	}
+
+	// No gap is large enough. The file gets extended from here, which
+	// also reuses any free sectors at its end.
+	if (runStart > m_nSectors)
+		runStart = m_nSectors;
+
+	return runStart;
+}
+
+bool RegionFile::readChunkView(const ChunkPos& pos, const uint8_t** ppData, int* pLength)
 {
 	int idx = field_20[32 * pos.z + pos.x];
 	if (!idx)
@@ -83,16 +262,44 @@ bool RegionFile::readChunk(const ChunkPos& pos, RakNet::BitStream** pBitStream)
 	int thing = (idx >> 8);
 	int offset = (idx & 0xFF);
 
+	// A corrupt offset table mustn't send us past the end of the file,
+	// the mapping would hand out memory that isn't there. Sector 0 is
+	// the offset table itself.
+	if (thing < 1 || thing + offset > m_nSectors)
+		return false;
+
 	int length = 0;
-	fseek(m_pFile, thing * SECTOR_BYTES, SEEK_SET);
-	fread(&length, sizeof(int), 1, m_pFile);
-	
-	assert(length < ((offset & 0xff) * SECTOR_BYTES));
+	if (!_readAt(thing * SECTOR_BYTES, &length, sizeof(int)))
+		return false;
+
+	// the length includes itself, and has to fit in the chunk's sectors
+	if (length < int(sizeof(int)) || length > offset * SECTOR_BYTES)
+		return false;
 
 	length -= 4;
 
+#ifdef USE_MMAP_REGION_FILE
+	*ppData = m_pMapping + thing * SECTOR_BYTES + sizeof(int);
+#else
+	m_readBuffer.resize(length + 1);
+	if (int(fread(&m_readBuffer[0], 1, length, m_pFile)) != length)
+		return false;
+	*ppData = &m_readBuffer[0];
+#endif
+
+	*pLength = length;
+	return true;
+}
+
+bool RegionFile::readChunk(const ChunkPos& pos, RakNet::BitStream** pBitStream)
+{
+	const uint8_t* pView = nullptr;
+	int length = 0;
+	if (!readChunkView(pos, &pView, &length))
+		return false;
+
 	uint8_t* data = new uint8_t[length];
-	READ(data, 1, length, m_pFile);
+	memcpy(data, pView, length);
 
 	*pBitStream = new RakNet::BitStream(data, length, false);
 	return true;
@@ -100,11 +307,10 @@ bool RegionFile::readChunk(const ChunkPos& pos, RakNet::BitStream** pBitStream)
 
 bool RegionFile::write(int index, RakNet::BitStream& bitStream)
 {
-	fseek(m_pFile, index * SECTOR_BYTES, 0);
 	int length = sizeof(int) + bitStream.GetNumberOfBytesUsed();
 
-	WRITE(&length, sizeof(length), 1, m_pFile);
-	WRITE(bitStream.GetData(), 1, bitStream.GetNumberOfBytesUsed(), m_pFile);
+	_writeAt(index * SECTOR_BYTES, &length, sizeof(length));
+	_writeAt(index * SECTOR_BYTES + sizeof(length), bitStream.GetData(), bitStream.GetNumberOfBytesUsed());
 
 	return true;
 }
@@ -124,52 +330,32 @@ bool RegionFile::writeChunk(const ChunkPos& pos, RakNet::BitStream& bitStream)
 		write(field20iU, bitStream);
 		return true;
 	}
-	
+
 	for (int i = 0; i < field20iL; i++)
 	{
-		field_28[i + field20iU] = true;
+		_setSectorUsed(i + field20iU, false);
 	}
 
-	bool bNeedWrite = false;
-	int v22 = 0, i = 0;
-	while (i < lowerIndex)
+	int v22 = _findFreeSectors(lowerIndex);
+	if (v22 + lowerIndex > m_nSectors && !_resize(v22 + lowerIndex))
 	{
-		if (field_28.find(i + v22) == field_28.end())
+		// keep the old copy around
+		for (int i = 0; i < field20iL; i++)
 		{
-			bNeedWrite = true;
-			break;
+			_setSectorUsed(i + field20iU, true);
 		}
 
-		if (field_28[i + v22])
-		{
-			i++;
-		}
-		else
-		{
-			v22 += i + 1;
-			i = 0;
-		}
-	}
-
-	if (bNeedWrite)
-	{
-		fseek(m_pFile, 0, SEEK_END);
-		for (int j = 0; lowerIndex - i > j; j++)
-		{
-			fwrite(field_24, sizeof(int), 1024, m_pFile);
-			field_28[j + v22] = true;
-		}
+		return false;
 	}
 
 	field_20[32 * pos.z + pos.x] = (v22 << 8) | lowerIndex;
 	for (int k = 0; k < lowerIndex; k++)
 	{
-		field_28[k + v22] = false;
+		_setSectorUsed(k + v22, true);
 	}
 
 	write(v22, bitStream);
-	fseek(m_pFile, sizeof(int) * (pos.x + 32 * pos.z), SEEK_SET);
-	fwrite(&field_20[pos.x + 32 * pos.z], sizeof(int), 1, m_pFile);
+	_writeAt(sizeof(int) * (pos.x + 32 * pos.z), &field_20[pos.x + 32 * pos.z], sizeof(int));
 
 	return true;
 }
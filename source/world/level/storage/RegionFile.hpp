@@ -3,10 +3,16 @@
 #include <cstdio>
 #include <string>
 #include <cassert>
-#include <map>
+#include <vector>
+#include <stdint.h>
 #include "BitStream.h"
 #include "world/level/levelgen/chunk/ChunkPos.hpp"
 
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__) && !defined(NO_MMAP_REGION_FILE)
+// Map chunks.dat into memory instead of going through stdio
+#define USE_MMAP_REGION_FILE
+#endif
+
 class RegionFile
 {
 public:
@@ -15,14 +21,32 @@ public:
 	void close();
 	bool open();
 	bool readChunk(const ChunkPos& pos, RakNet::BitStream**);
+	// Returns the chunk's data without copying it out of the mapped file.
+	// The view is only valid until the next call on this RegionFile.
+	bool readChunkView(const ChunkPos& pos, const uint8_t** ppData, int* pLength);
 	bool write(int index, RakNet::BitStream&);
 	bool writeChunk(const ChunkPos& pos, RakNet::BitStream&);
 
+private:
+	bool _readAt(int offset, void* pData, int size);
+	bool _writeAt(int offset, const void* pData, int size);
+	bool _resize(int nSectors);
+	bool _isSectorUsed(int sector) const;
+	void _setSectorUsed(int sector, bool bUsed);
+	int  _findFreeSectors(int count) const;
+
 public:
 	FILE* m_pFile;
 	std::string m_fileName;
 	int* field_20;
 	int* field_24;
-	std::map<int, bool> field_28;
+	// One bit per sector, set while the sector is in use
+	std::vector<uint32_t> m_sectorBitmap;
+	int m_nSectors;
+#ifdef USE_MMAP_REGION_FILE
+	int m_fd;
+	uint8_t* m_pMapping;
+#else
+	std::vector<uint8_t> m_readBuffer;
+#endif
 };
-
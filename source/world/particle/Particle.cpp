@@ -10,6 +10,54 @@
 
 float Particle::xOff, Particle::yOff, Particle::zOff;
 
+constexpr size_t MaxSize(size_t a, size_t b)
+{
+	return a > b ? a : b;
+}
+
+// Custom: big enough for any of the particles in Particle.hpp, bigger ones get their memory the usual way
+#define C_PARTICLE_SLOT_SIZE ((MaxSize(MaxSize(MaxSize(sizeof(Particle), sizeof(TerrainParticle)), \
+                                               MaxSize(sizeof(BubbleParticle), sizeof(SmokeParticle))), \
+                                       MaxSize(MaxSize(sizeof(RedDustParticle), sizeof(ExplodeParticle)), \
+                                               MaxSize(sizeof(FlameParticle), sizeof(LavaParticle)))) + 15) & ~size_t(15))
+#define C_PARTICLE_SLOTS_PER_BLOCK (256)
+
+// Custom: a block of slots. Each slot starts with the block it belongs to, the particle comes after that.
+struct ParticleBlock
+{
+	ParticleBlock* pPrev;
+	ParticleBlock* pNext;
+	void* pFreeSlots;
+	int nUsed;
+};
+
+#define C_PARTICLE_SLOT_HEADER ((sizeof(ParticleBlock*) + 15) & ~size_t(15))
+#define C_PARTICLE_BLOCK_HEADER ((sizeof(ParticleBlock) + 15) & ~size_t(15))
+#define C_PARTICLE_SLOT_STRIDE (C_PARTICLE_SLOT_HEADER + C_PARTICLE_SLOT_SIZE)
+
+// Custom: the blocks that still have a free slot
+static ParticleBlock* g_pParticleBlocks = nullptr;
+
+static void _linkParticleBlock(ParticleBlock* pBlock)
+{
+	pBlock->pPrev = nullptr;
+	pBlock->pNext = g_pParticleBlocks;
+	if (g_pParticleBlocks)
+		g_pParticleBlocks->pPrev = pBlock;
+	g_pParticleBlocks = pBlock;
+}
+
+static void _unlinkParticleBlock(ParticleBlock* pBlock)
+{
+	if (pBlock->pPrev)
+		pBlock->pPrev->pNext = pBlock->pNext;
+	else
+		g_pParticleBlocks = pBlock->pNext;
+
+	if (pBlock->pNext)
+		pBlock->pNext->pPrev = pBlock->pPrev;
+}
+
 void Particle::_init()
 {
 	field_DC = 0;
@@ -49,6 +97,70 @@ Particle::Particle(Level* level, const Vec3& pos, const Vec3& dir) : Entity(leve
 	field_EC = int(4.0f / (0.1f + 0.9f * sharedRandom.nextFloat()));
 }
 
+void* Particle::operator new(size_t size)
+{
+	if (size > C_PARTICLE_SLOT_SIZE)
+		return ::operator new(size);
+
+	ParticleBlock* pBlock = g_pParticleBlocks;
+	if (!pBlock)
+	{
+		uint8_t* pMem = (uint8_t*)::operator new(C_PARTICLE_BLOCK_HEADER + C_PARTICLE_SLOT_STRIDE * C_PARTICLE_SLOTS_PER_BLOCK);
+		pBlock = (ParticleBlock*)pMem;
+		pBlock->pFreeSlots = nullptr;
+		pBlock->nUsed = 0;
+
+		for (int i = C_PARTICLE_SLOTS_PER_BLOCK - 1; i >= 0; i--)
+		{
+			void** pSlot = (void**)(pMem + C_PARTICLE_BLOCK_HEADER + i * C_PARTICLE_SLOT_STRIDE);
+			*pSlot = pBlock->pFreeSlots;
+			pBlock->pFreeSlots = pSlot;
+		}
+
+		_linkParticleBlock(pBlock);
+	}
+
+	void** pSlot = (void**)pBlock->pFreeSlots;
+	pBlock->pFreeSlots = *pSlot;
+	pBlock->nUsed++;
+
+	if (!pBlock->pFreeSlots)
+		_unlinkParticleBlock(pBlock);
+
+	*(ParticleBlock**)pSlot = pBlock;
+	return (uint8_t*)pSlot + C_PARTICLE_SLOT_HEADER;
+}
+
+void Particle::operator delete(void* ptr, size_t size)
+{
+	if (!ptr)
+		return;
+
+	if (size > C_PARTICLE_SLOT_SIZE)
+	{
+		::operator delete(ptr);
+		return;
+	}
+
+	void** pSlot = (void**)((uint8_t*)ptr - C_PARTICLE_SLOT_HEADER);
+	ParticleBlock* pBlock = *(ParticleBlock**)pSlot;
+
+	if (!pBlock->pFreeSlots)
+		_linkParticleBlock(pBlock);
+
+	*pSlot = pBlock->pFreeSlots;
+	pBlock->pFreeSlots = pSlot;
+	pBlock->nUsed--;
+
+	// A block nothing lives in anymore is given back after a storm of them. The last
+	// one is kept, so that a few particles coming and going don't allocate it each time.
+	if (pBlock->nUsed == 0 && (pBlock->pPrev || pBlock->pNext))
+	{
+		_unlinkParticleBlock(pBlock);
+		::operator delete(pBlock);
+	}
+}
+
 int Particle::getParticleTexture()
 {
 	return PT_PARTICLES;
@@ -92,11 +204,22 @@ void Particle::render(Tesselator& t, float f, float a4, float a5, float a6, floa
 	float siz2X = a7 * field_F0 * 0.1f;
 	float siz2Z = a8 * field_F0 * 0.1f;
 
+	// Custom: the quad goes into the tesselator in one go
+	float xyz[12] = {
+		posX - sizeX - siz2X, posY - sizeY, posZ - sizeZ - siz2Z,
+		posX - sizeX + siz2X, posY + sizeY, posZ - sizeZ + siz2Z,
+		posX + sizeX + siz2X, posY + sizeY, posZ + sizeZ + siz2Z,
+		posX + sizeX - siz2X, posY - sizeY, posZ + sizeZ - siz2Z,
+	};
+	float uv[8] = {
+		texU_1 + C_MAGIC_1, texV_1 + C_MAGIC_1,
+		texU_1 + C_MAGIC_1, texV_1,
+		texU_1,             texV_1,
+		texU_1,             texV_1 + C_MAGIC_1,
+	};
+
 	t.color(m_rCol * fBright, m_gCol * fBright, m_bCol * fBright);
-	t.vertexUV(posX - sizeX - siz2X, posY - sizeY, posZ - sizeZ - siz2Z, texU_1 + C_MAGIC_1, texV_1 + C_MAGIC_1);
-	t.vertexUV(posX - sizeX + siz2X, posY + sizeY, posZ - sizeZ + siz2Z, texU_1 + C_MAGIC_1, texV_1);
-	t.vertexUV(posX + sizeX + siz2X, posY + sizeY, posZ + sizeZ + siz2Z, texU_1,             texV_1);
-	t.vertexUV(posX + sizeX - siz2X, posY - sizeY, posZ + sizeZ - siz2Z, texU_1,             texV_1 + C_MAGIC_1);
+	t.quadUV(xyz, uv);
 }
 
 void Particle::tick()
@@ -44,6 +44,10 @@ public:
 	Particle* scale(float);
 	Particle* setPower(float);
 
+	// Custom: particles are made and thrown away by the hundreds, so they live in pooled slots
+	static void* operator new(size_t size);
+	static void operator delete(void* ptr, size_t size);
+
 public:
 	int field_DC;
 	float field_E0;
@@ -13,7 +13,13 @@ ParticleEngine::ParticleEngine(Level* level, Textures* textures)
 {
 	m_pLevel = level;
 	m_pTextures = textures;
+	m_bTicking = false;
 	m_pTextures->loadTexture("particles.png", true);
+
+	// sized and placed like the Particle constructor does it
+	m_mover.setLevel(level);
+	m_mover.setSize(0.2f, 0.2f);
+	m_mover.m_heightOffset = 0.5f * m_mover.m_bbHeight;
 }
 
 void ParticleEngine::setLevel(Level* level)
@@ -25,7 +31,7 @@ void ParticleEngine::setLevel(Level* level)
 	for (int i = 0; i < 4; i++)
 	{
 #ifndef ORIGINAL_CODE
-		for (std::vector<Particle*>::iterator it = m_particles[i].begin(); it != m_particles[i].end(); it++)
+		for (std::deque<Particle*>::iterator it = m_particles[i].begin(); it != m_particles[i].end(); it++)
 		{
 			Particle* pParticle = *it;
 			delete pParticle;
@@ -35,21 +41,141 @@ void ParticleEngine::setLevel(Level* level)
 		m_particles[i].clear();
 	}
 
+	m_terrainParticles.clear();
+
 #ifndef ORIGINAL_CODE
 	m_pLevel = level;
 #endif
+	m_mover.setLevel(level);
 }
 
 void ParticleEngine::add(Particle* particle)
 {
-	m_particles[particle->getParticleTexture()].push_back(particle);
+	std::deque<Particle*>& particles = m_particles[particle->getParticleTexture()];
+
+	particles.push_back(particle);
+
+	// Custom: so that a storm of them can't drag the frame down. While ticking,
+	// the list is being compacted, so this waits until the end of tick().
+	if (!m_bTicking)
+		_trim(particles);
+}
+
+void ParticleEngine::_trim(std::deque<Particle*>& particles)
+{
+	while (particles.size() > C_MAX_PARTICLES)
+	{
+		delete particles.front();
+		particles.pop_front();
+	}
+}
+
+// Custom: calls op on each of the arrays of a TerrainParticles
+template <typename Op>
+static void _forEachArray(ParticleEngine::TerrainParticles& p, Op& op)
+{
+	op(p.m_x); op(p.m_y); op(p.m_z);
+	op(p.m_xo); op(p.m_yo); op(p.m_zo);
+	op(p.m_xd); op(p.m_yd); op(p.m_zd);
+	op(p.m_hitbox);
+	op(p.m_age); op(p.m_lifetime);
+	op(p.m_gravity); op(p.m_size);
+	op(p.m_tex);
+	op(p.m_uOff); op(p.m_vOff);
+	op(p.m_r); op(p.m_g); op(p.m_b);
+	op(p.m_bOnGround); op(p.m_bInWeb);
+	op(p.m_fireTicks);
+}
+
+struct ResizeArray
+{
+	size_t m_size;
+	template <typename T> void operator()(std::vector<T>& v) { v.resize(m_size); }
+};
+
+struct CopyInArray
+{
+	size_t m_to, m_from;
+	template <typename T> void operator()(std::vector<T>& v) { v[m_to] = v[m_from]; }
+};
+
+struct EraseFrontOfArray
+{
+	size_t m_count;
+	template <typename T> void operator()(std::vector<T>& v) { v.erase(v.begin(), v.begin() + m_count); }
+};
+
+struct FreeArray
+{
+	template <typename T> void operator()(std::vector<T>& v) { std::vector<T>().swap(v); }
+};
+
+void ParticleEngine::TerrainParticles::resize(size_t size)
+{
+	ResizeArray op = { size };
+	_forEachArray(*this, op);
+}
+
+void ParticleEngine::TerrainParticles::copy(size_t to, size_t from)
+{
+	CopyInArray op = { to, from };
+	_forEachArray(*this, op);
+}
+
+void ParticleEngine::TerrainParticles::eraseFront(size_t count)
+{
+	EraseFrontOfArray op = { count };
+	_forEachArray(*this, op);
+}
+
+void ParticleEngine::TerrainParticles::clear()
+{
+	// the memory goes back too, not just the particles
+	FreeArray op;
+	_forEachArray(*this, op);
+}
+
+void ParticleEngine::_addTerrainParticle(const TerrainParticle& particle)
+{
+	TerrainParticles& p = m_terrainParticles;
+
+	p.m_x.push_back(particle.m_pos.x);
+	p.m_y.push_back(particle.m_pos.y);
+	p.m_z.push_back(particle.m_pos.z);
+	p.m_xo.push_back(particle.m_oPos.x);
+	p.m_yo.push_back(particle.m_oPos.y);
+	p.m_zo.push_back(particle.m_oPos.z);
+	p.m_xd.push_back(particle.m_vel.x);
+	p.m_yd.push_back(particle.m_vel.y);
+	p.m_zd.push_back(particle.m_vel.z);
+	p.m_hitbox.push_back(particle.m_hitbox);
+	p.m_age.push_back(particle.field_E8);
+	p.m_lifetime.push_back(particle.field_EC);
+	p.m_gravity.push_back(particle.field_F4);
+	p.m_size.push_back(particle.field_F0);
+	p.m_tex.push_back(particle.field_DC);
+	p.m_uOff.push_back(particle.field_E0);
+	p.m_vOff.push_back(particle.field_E4);
+	p.m_r.push_back(particle.m_rCol);
+	p.m_g.push_back(particle.m_gCol);
+	p.m_b.push_back(particle.m_bCol);
+	p.m_bOnGround.push_back(particle.m_bOnGround);
+	p.m_bInWeb.push_back(particle.m_bIsInWeb);
+	p.m_fireTicks.push_back(particle.m_fireTicks);
+}
+
+void ParticleEngine::_trimTerrainParticles()
+{
+	// like _trim, the oldest make way
+	if (m_terrainParticles.size() > C_MAX_PARTICLES)
+		m_terrainParticles.eraseFront(m_terrainParticles.size() - C_MAX_PARTICLES);
 }
 
 std::string ParticleEngine::countParticles()
 {
 	// @NOTE: For whatever reason this returns a string??
 	std::stringstream ss;
-	ss << (m_particles[0].size() + m_particles[1].size() + m_particles[2].size() + m_particles[3].size());
+	ss << (m_particles[0].size() + m_particles[1].size() + m_particles[2].size() + m_particles[3].size() + m_terrainParticles.size());
 	return ss.str();
 }
 
@@ -99,7 +225,11 @@ void ParticleEngine::crack(const TilePos& tilePos, Facing::Name face)
 			break;
 	}
 
-	add((new TerrainParticle(m_pLevel, pos, pTile))->init(tilePos, face)->setPower(0.2f)->scale(0.6f));
+	// Custom: made the same way, then kept in m_terrainParticles
+	TerrainParticle particle(m_pLevel, pos, pTile);
+	particle.init(tilePos, face)->setPower(0.2f)->scale(0.6f);
+	_addTerrainParticle(particle);
+	_trimTerrainParticles();
 }
 
 void ParticleEngine::destroyEffect(const TilePos& pos)
@@ -124,11 +254,15 @@ void ParticleEngine::destroyEffect(const TilePos& pos)
 					      vec1.y - float(pos.y) - 0.5f,
 					      vec1.z - float(pos.z) - 0.5f);
 
-				add((new TerrainParticle(m_pLevel, vec1, vec2, pTile))->init(pos));
+				TerrainParticle particle(m_pLevel, vec1, vec2, pTile);
+				particle.init(pos);
+				_addTerrainParticle(particle);
 			}
 		}
 	}
 
+	_trimTerrainParticles();
+
 	if (timeS != -1.0)
 		getTimeS();
 
@@ -170,12 +304,15 @@ void ParticleEngine::render(Entity* ent, float f)
 
 		t.begin();
 
-		for (std::vector<Particle*>::iterator it = m_particles[i].begin(); it != m_particles[i].end(); it++)
+		for (std::deque<Particle*>::iterator it = m_particles[i].begin(); it != m_particles[i].end(); it++)
 		{
 			Particle* pParticle = *it;
 			pParticle->render(t, f, x1, x2, x3, x4, x5);
 		}
 
+		if (i == PT_TERRAIN)
+			_renderTerrainParticles(t, f, x1, x2, x3, x4, x5);
+
 		t.draw();
 	}
 }
@@ -198,21 +335,198 @@ void ParticleEngine::renderLit(Entity* player, float a)
 
 void ParticleEngine::tick()
 {
+	m_bTicking = true;
+
 	for (int p = 0; p < 4; p++)
 	{
-		for (size_t i = 0; i < m_particles[p].size(); i++)
+		// Custom: the ones still alive are moved up in the same pass, in the same order,
+		// instead of erasing the dead ones one at a time
+		std::deque<Particle*>& particles = m_particles[p];
+		size_t nAlive = 0;
+
+		for (size_t i = 0; i < particles.size(); i++)
 		{
-			Particle* particle = m_particles[p][i];
+			Particle* particle = particles[i];
 			particle->tick();
 
 			if (particle->m_bRemoved)
 			{
 				// remove it
-				m_particles[p].erase(m_particles[p].begin() + i);
-				i--;
 				delete particle;
 				continue;
 			}
+
+			particles[nAlive++] = particle;
+		}
+
+		particles.resize(nAlive);
+
+		if (p == PT_TERRAIN)
+			_tickTerrainParticles();
+	}
+
+	m_bTicking = false;
+
+	for (int p = 0; p < 4; p++)
+		_trim(m_particles[p]);
+}
+
+void ParticleEngine::_tickTerrainParticles()
+{
+	// Custom: Particle::tick, in passes over all of them
+	TerrainParticles& p = m_terrainParticles;
+	size_t nParticles = p.size();
+
+	for (size_t i = 0; i < nParticles; i++)
+	{
+		p.m_xo[i] = p.m_x[i];
+		p.m_yo[i] = p.m_y[i];
+		p.m_zo[i] = p.m_z[i];
+		p.m_age[i]++;
+		p.m_yd[i] -= p.m_gravity[i] * 0.04f;
+	}
+
+	for (size_t i = 0; i < nParticles; i++)
+	{
+		// these are gone at the end of the tick anyway
+		if (p.m_age[i] >= p.m_lifetime[i])
+			continue;
+
+		AABB& hitbox = p.m_hitbox[i];
+		AABB swept = hitbox;
+		swept.expand(p.m_xd[i], p.m_yd[i], p.m_zd[i]);
+
+		AABBVector* pCubes = p.m_bInWeb[i] ? nullptr : m_pLevel->getOnlyCubes(swept);
+		if (pCubes)
+		{
+			// what Entity::move comes down to when there is nothing but air and full cubes around
+			float xd = p.m_xd[i], yd = p.m_yd[i], zd = p.m_zd[i];
+
+			for (size_t c = 0; c < pCubes->size(); c++)
+				yd = pCubes->at(c).clipYCollide(hitbox, yd);
+			hitbox.move(0.0f, yd, 0.0f);
+
+			for (size_t c = 0; c < pCubes->size(); c++)
+				xd = pCubes->at(c).clipXCollide(hitbox, xd);
+			hitbox.move(xd, 0.0f, 0.0f);
+
+			for (size_t c = 0; c < pCubes->size(); c++)
+				zd = pCubes->at(c).clipZCollide(hitbox, zd);
+			hitbox.move(0.0f, 0.0f, zd);
+
+			p.m_x[i] = (hitbox.min.x + hitbox.max.x) / 2.0f;
+			p.m_y[i] = hitbox.min.y + m_mover.m_heightOffset;
+			p.m_z[i] = (hitbox.min.z + hitbox.max.z) / 2.0f;
+			p.m_bOnGround[i] = p.m_yd[i] != yd && p.m_yd[i] < 0.0f;
+
+			if (p.m_xd[i] != xd)
+				p.m_xd[i] = 0.0f;
+			if (p.m_yd[i] != yd)
+				p.m_yd[i] = 0.0f;
+			if (p.m_zd[i] != zd)
+				p.m_zd[i] = 0.0f;
+
+			if (p.m_fireTicks[i] <= 0)
+				p.m_fireTicks[i] = int16_t(-m_mover.m_flameTime);
+			continue;
 		}
+
+		// anything else, like water, webs or slabs, goes through Entity::move itself
+		Particle& mover = m_mover;
+		mover.m_pos = Vec3(p.m_x[i], p.m_y[i], p.m_z[i]);
+		mover.m_hitbox = hitbox;
+		mover.m_vel = Vec3(p.m_xd[i], p.m_yd[i], p.m_zd[i]);
+		mover.m_bOnGround = p.m_bOnGround[i];
+		mover.m_bIsInWeb = p.m_bInWeb[i];
+		mover.m_fireTicks = p.m_fireTicks[i];
+		mover.m_distanceFallen = 0.0f;
+
+		mover.move(mover.m_vel);
+
+		p.m_x[i] = mover.m_pos.x;
+		p.m_y[i] = mover.m_pos.y;
+		p.m_z[i] = mover.m_pos.z;
+		hitbox = mover.m_hitbox;
+		p.m_xd[i] = mover.m_vel.x;
+		p.m_yd[i] = mover.m_vel.y;
+		p.m_zd[i] = mover.m_vel.z;
+		p.m_bOnGround[i] = mover.m_bOnGround;
+		p.m_bInWeb[i] = mover.m_bIsInWeb;
+		p.m_fireTicks[i] = mover.m_fireTicks;
+	}
+
+	for (size_t i = 0; i < nParticles; i++)
+	{
+		float friction = p.m_bOnGround[i] ? 0.7f : 1.0f;
+		p.m_xd[i] = p.m_xd[i] * 0.98f * friction;
+		p.m_yd[i] = p.m_yd[i] * 0.98f;
+		p.m_zd[i] = p.m_zd[i] * 0.98f * friction;
+	}
+
+	// the ones still alive are moved up, in the same order
+	size_t nAlive = 0;
+	for (size_t i = 0; i < nParticles; i++)
+	{
+		if (p.m_age[i] >= p.m_lifetime[i])
+			continue;
+
+		if (nAlive != i)
+			p.copy(nAlive, i);
+		nAlive++;
+	}
+
+	if (nAlive == 0)
+		p.clear();
+	else
+		p.resize(nAlive);
+}
+
+void ParticleEngine::_renderTerrainParticles(Tesselator& t, float f, float x1, float x2, float x3, float x4, float x5)
+{
+	// Custom: TerrainParticle::render, for each of them
+	constexpr float C_MAGIC_1 = 0.015609f; // @BUG: Slightly bigger than 1/64.0f
+
+	TerrainParticles& p = m_terrainParticles;
+	for (size_t i = 0; i < p.size(); i++)
+	{
+		int texture = p.m_tex[i];
+		int texX = texture % 16;
+		if (texture < 0)
+			texture += 15;
+
+		float texU_1 = (float(texX)         + 0.25f * p.m_uOff[i]) / 16.0f;
+		float texV_1 = (float(texture >> 4) + 0.25f * p.m_vOff[i]) / 16.0f;
+
+		float posX = Mth::Lerp(p.m_xo[i], p.m_x[i], f) - Particle::xOff;
+		float posY = Mth::Lerp(p.m_yo[i], p.m_y[i], f) - Particle::yOff;
+		float posZ = Mth::Lerp(p.m_zo[i], p.m_z[i], f) - Particle::zOff;
+
+		// Entity::getBrightness, from where it is
+		m_mover.m_pos = Vec3(p.m_x[i], p.m_y[i], p.m_z[i]);
+		m_mover.m_hitbox = p.m_hitbox[i];
+		float fBright = m_mover.getBrightness(f);
+
+		float size = p.m_size[i];
+		float sizeX = x1 * size * 0.1f;
+		float sizeY = x2 * size * 0.1f;
+		float sizeZ = x3 * size * 0.1f;
+		float siz2X = x4 * size * 0.1f;
+		float siz2Z = x5 * size * 0.1f;
+
+		float xyz[12] = {
+			posX - sizeX - siz2X, posY - sizeY, posZ - sizeZ - siz2Z,
+			posX - sizeX + siz2X, posY + sizeY, posZ - sizeZ + siz2Z,
+			posX + sizeX + siz2X, posY + sizeY, posZ + sizeZ + siz2Z,
+			posX + sizeX - siz2X, posY - sizeY, posZ + sizeZ - siz2Z,
+		};
+		float uv[8] = {
+			texU_1 + C_MAGIC_1, texV_1 + C_MAGIC_1,
+			texU_1 + C_MAGIC_1, texV_1,
+			texU_1,             texV_1,
+			texU_1,             texV_1 + C_MAGIC_1,
+		};
+
+		t.color(p.m_r[i] * fBright, p.m_g[i] * fBright, p.m_b[i] * fBright);
+		t.quadUV(xyz, uv);
 	}
 }
@@ -8,10 +8,15 @@
 
 #pragma once
 
+#include <deque>
+#include <vector>
 #include "world/level/Level.hpp"
 #include "client/renderer/Textures.hpp"
 #include "Particle.hpp"
 
+// Custom: how many particles of one texture there can be, after that the oldest ones make way
+#define C_MAX_PARTICLES (4000)
+
 class ParticleEngine
 {
 public:
@@ -26,11 +31,52 @@ public:
 	void tick();
 	void setLevel(Level*);
 
+private:
+	void _trim(std::deque<Particle*>& particles);
+	void _addTerrainParticle(const TerrainParticle& particle);
+	void _tickTerrainParticles();
+	void _trimTerrainParticles();
+	void _renderTerrainParticles(Tesselator& t, float f, float x1, float x2, float x3, float x4, float x5);
+
+public:
+	// Custom: the terrain particles, which destroyEffect and crack make by the dozen, kept as arrays
+	// of each of their fields rather than as Particle objects, oldest first, so that they are
+	// ticked and drawn in passes over those arrays
+	struct TerrainParticles
+	{
+		size_t size() const { return m_age.size(); }
+		void resize(size_t size);
+		void copy(size_t to, size_t from);
+		void eraseFront(size_t count);
+		void clear();
+
+		std::vector<float> m_x, m_y, m_z;
+		std::vector<float> m_xo, m_yo, m_zo;
+		std::vector<float> m_xd, m_yd, m_zd;
+		std::vector<AABB> m_hitbox;
+		std::vector<int> m_age, m_lifetime;
+		std::vector<float> m_gravity, m_size;
+		std::vector<int> m_tex;
+		std::vector<float> m_uOff, m_vOff;
+		std::vector<float> m_r, m_g, m_b;
+		// what Entity::move keeps from one move to the next
+		std::vector<uint8_t> m_bOnGround, m_bInWeb;
+		std::vector<int16_t> m_fireTicks;
+	};
+
 public:
 	Level* m_pLevel;
 	// todo
-	std::vector<Particle*> m_particles[4];
+	// Custom: a deque, oldest first, so the oldest can be let go of cheaply
+	std::deque<Particle*> m_particles[4];
 	Textures* m_pTextures;
 	Random m_random;
+	// Custom: set while tick() walks the lists, so that particles spawned by other
+	// particles don't let the oldest ones go from under it
+	bool m_bTicking;
+	TerrainParticles m_terrainParticles;
+	// Custom: the terrain particles with anything but air and full cubes around them are moved
+	// through this one, so they float, get stuck in webs and burn the way a Particle does
+	Particle m_mover;
 };
 
@@ -77,9 +77,20 @@ void TerrainParticle::render(Tesselator& t, float f, float a4, float a5, float a
 	float siz2X = a7 * field_F0 * 0.1f;
 	float siz2Z = a8 * field_F0 * 0.1f;
 
+	// Custom: handed over as one quad, like in Particle::render
+	float xyz[12] = {
+		posX - sizeX - siz2X, posY - sizeY, posZ - sizeZ - siz2Z,
+		posX - sizeX + siz2X, posY + sizeY, posZ - sizeZ + siz2Z,
+		posX + sizeX + siz2X, posY + sizeY, posZ + sizeZ + siz2Z,
+		posX + sizeX - siz2X, posY - sizeY, posZ + sizeZ - siz2Z,
+	};
+	float uv[8] = {
+		texU_1 + C_MAGIC_1, texV_1 + C_MAGIC_1,
+		texU_1 + C_MAGIC_1, texV_1,
+		texU_1,             texV_1,
+		texU_1,             texV_1 + C_MAGIC_1,
+	};
+
 	t.color(m_rCol * fBright, m_gCol * fBright, m_bCol * fBright);
-	t.vertexUV(posX - sizeX - siz2X, posY - sizeY, posZ - sizeZ - siz2Z, texU_1 + C_MAGIC_1, texV_1 + C_MAGIC_1);
-	t.vertexUV(posX - sizeX + siz2X, posY + sizeY, posZ - sizeZ + siz2Z, texU_1 + C_MAGIC_1, texV_1);
-	t.vertexUV(posX + sizeX + siz2X, posY + sizeY, posZ + sizeZ + siz2Z, texU_1, texV_1);
-	t.vertexUV(posX + sizeX - siz2X, posY - sizeY, posZ + sizeZ - siz2Z, texU_1, texV_1 + C_MAGIC_1);
+	t.quadUV(xyz, uv);
 }
\ No newline at end of file
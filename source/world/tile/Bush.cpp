@@ -66,3 +66,8 @@ AABB* Bush::getAABB(const Level* level, const TilePos& pos)
 {
 	return nullptr;
 }
+
+Tile::CollisionType Bush::getCollisionType() const
+{
+	return COLLISION_NONE;
+}
@@ -17,6 +17,7 @@ public:
 
 	virtual bool canSurvive(const Level*, const TilePos& pos) const override;
 	virtual AABB* getAABB(const Level*, const TilePos& pos) override;
+	virtual CollisionType getCollisionType() const override;
 	virtual int getRenderShape() const override;
 	virtual bool isCubeShaped() const override;
 	virtual bool isSolidRender() const override;
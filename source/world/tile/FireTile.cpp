@@ -56,6 +56,11 @@ AABB* FireTile::getAABB(const Level* level, const TilePos& pos)
 	return nullptr;
 }
 
+Tile::CollisionType FireTile::getCollisionType() const
+{
+	return COLLISION_NONE;
+}
+
 int FireTile::getResourceCount(Random* random) const
 {
 	return 0;
@@ -16,6 +16,7 @@ public:
 	FireTile(int ID, int texture);
 
 	AABB* getAABB(const Level*, const TilePos& pos) override;
+	CollisionType getCollisionType() const override;
 	int getRenderShape() const override;
 	bool isCubeShaped() const override;
 	bool isSolidRender() const override;
@@ -9,8 +9,6 @@
 #include "world/tile/FurnaceTile.hpp"
 #include "world/level/Level.hpp"
 #include "world/entity/Player.hpp"
-#include "world/entity/LocalPlayer.hpp"
-#include "client/gui/screens/FurnaceScreen.hpp"
 
 FurnaceTile::FurnaceTile(TileID id, bool lit) : Tile(id, Material::stone)
 {
@@ -42,15 +40,10 @@ void FurnaceTile::onPlace(Level* level, const TilePos& pos)
 int FurnaceTile::use(Level* level, const TilePos& pos, Player* player)
 {
 	// Open furnace GUI when player interacts with furnace
-	if (player) {
-		// Check if this is a LocalPlayer (client-side)
-		LocalPlayer* localPlayer = dynamic_cast<LocalPlayer*>(player);
-		if (localPlayer && localPlayer->m_pMinecraft) {
-			// Open the furnace screen with the tile position
-			localPlayer->m_pMinecraft->setScreen(new FurnaceScreen(localPlayer, pos));
-			return 1; // Indicate interaction was handled
-		}
-	}
+	// Only the client's own player has a screen to open it on
+	if (player && player->openFurnace(pos))
+		return 1; // Indicate interaction was handled
+
 	return 0;
 }
 
@@ -19,6 +19,12 @@ bool HalfTransparentTile::isSolidRender() const
 	return false;
 }
 
+Tile::CollisionType HalfTransparentTile::getCollisionType() const
+{
+	// not a solid render, but still the whole tile
+	return COLLISION_CUBE;
+}
+
 bool HalfTransparentTile::shouldRenderFace(const LevelSource* level, const TilePos& pos, Facing::Name face) const
 {
 	if (field_6C || level->getTile(pos) != m_ID)
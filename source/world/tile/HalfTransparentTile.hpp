@@ -16,6 +16,7 @@ public:
 	HalfTransparentTile(int ID, int texture, Material*);
 
 	virtual bool isSolidRender() const override;
+	virtual CollisionType getCollisionType() const override;
 	virtual bool shouldRenderFace(const LevelSource*, const TilePos& pos, Facing::Name face) const override;
 
 public:
@@ -47,6 +47,11 @@ AABB* LiquidTile::getAABB(const Level*, const TilePos& pos)
 	return nullptr;
 }
 
+Tile::CollisionType LiquidTile::getCollisionType() const
+{
+	return COLLISION_NONE;
+}
+
 float LiquidTile::getBrightness(const LevelSource* level, const TilePos& pos) const
 {
 	float b1 = level->getBrightness(pos);
@@ -20,6 +20,7 @@ public:
 	virtual void tick(Level*, const TilePos& pos, Random* random) override;
 	void animateTick(Level*, const TilePos& pos, Random* random) override;
 	AABB* getAABB(const Level*, const TilePos& pos) override;
+	CollisionType getCollisionType() const override;
 	float getBrightness(const LevelSource*, const TilePos& pos) const override;
 	int getRenderLayer() const override;
 	int getRenderShape() const override;
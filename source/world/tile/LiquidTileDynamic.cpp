@@ -63,8 +63,45 @@ bool LiquidTileDynamic::canSpreadTo(Level* level, const TilePos& pos)
 	return !isWaterBlocking(level, pos);
 }
 
+int LiquidTileDynamic::_getSlopeIndex(const TilePos& pos) const
+{
+	int dx = pos.x - m_slopeOrigin.x + C_SLOPE_RANGE;
+	int dz = pos.z - m_slopeOrigin.z + C_SLOPE_RANGE;
+
+	if (pos.y != m_slopeOrigin.y || dx < 0 || dz < 0 || dx >= C_SLOPE_SIZE || dz >= C_SLOPE_SIZE)
+		return -1;
+
+	return dx * C_SLOPE_SIZE + dz;
+}
+
+int LiquidTileDynamic::_getSlopeFlags(Level* level, const TilePos& pos)
+{
+	int index = _getSlopeIndex(pos);
+	if (index >= 0 && m_slopeFlags[index])
+		return m_slopeFlags[index];
+
+	// the same questions in the same order getSpread and getSlopeDistance used to ask them
+	int flags = SLOPE_KNOWN;
+	if (isWaterBlocking(level, pos))
+		flags |= SLOPE_BLOCKING;
+	else if (level->getMaterial(pos) == m_pMaterial && level->getData(pos) == 0)
+		flags |= SLOPE_STILL;
+	else if (!isWaterBlocking(level, TilePos(pos.x, pos.y - 1, pos.z)))
+		flags |= SLOPE_OPEN_BELOW;
+
+	if (index >= 0)
+		m_slopeFlags[index] = flags;
+
+	return flags;
+}
+
 int LiquidTileDynamic::getSlopeDistance(Level* level, const TilePos& pos, int depth, int a7)
 {
+	int index = _getSlopeIndex(pos);
+	bool bMemo = index >= 0 && depth >= 1 && depth <= C_SLOPE_MAX_DEPTH && a7 >= 0 && a7 < 4;
+	if (bMemo && m_slopeCosts[index][depth - 1][a7] >= 0)
+		return m_slopeCosts[index][depth - 1][a7];
+
 	int cost = 1000;
 	
 	for (int i = 0; i < 4; i++)
@@ -81,15 +118,15 @@ int LiquidTileDynamic::getSlopeDistance(Level* level, const TilePos& pos, int de
 			case 3: check.z++; break;
 		}
 
-		if (isWaterBlocking(level, check))
-			continue;
-
-		if (level->getMaterial(check) == m_pMaterial &&
-			level->getData(check) == 0)
+		int flags = _getSlopeFlags(level, check);
+		if (flags & (SLOPE_BLOCKING | SLOPE_STILL))
 			continue;
 
-		if (!isWaterBlocking(level, TilePos(check.x, check.y - 1, check.z)))
-			return depth;
+		if (flags & SLOPE_OPEN_BELOW)
+		{
+			cost = depth;
+			break;
+		}
 
 		if (depth >= 4)
 			continue;
@@ -99,11 +136,18 @@ int LiquidTileDynamic::getSlopeDistance(Level* level, const TilePos& pos, int de
 			cost = otherCost;
 	}
 
+	if (bMemo)
+		m_slopeCosts[index][depth - 1][a7] = int16_t(cost);
+
 	return cost;
 }
 
 bool* LiquidTileDynamic::getSpread(Level* level, const TilePos& pos)
 {
+	m_slopeOrigin = pos;
+	memset(m_slopeFlags, 0, sizeof m_slopeFlags);
+	memset(m_slopeCosts, 0xFF, sizeof m_slopeCosts);
+
 	for (int i = 0; i < 4; i++)
 	{
 		field_74[i] = 1000;
@@ -126,17 +170,14 @@ bool* LiquidTileDynamic::getSpread(Level* level, const TilePos& pos)
 				break;
 		}
 
-		if (isWaterBlocking(level, chk))
-			continue;
-
-		if (level->getMaterial(chk) == m_pMaterial &&
-			level->getData(chk) == 0)
+		int flags = _getSlopeFlags(level, chk);
+		if (flags & (SLOPE_BLOCKING | SLOPE_STILL))
 			continue;
 
-		if (isWaterBlocking(level, TilePos(chk.x, chk.y - 1, chk.z)))
-			field_74[i] = getSlopeDistance(level, chk, 1, i);
-		else
+		if (flags & SLOPE_OPEN_BELOW)
 			field_74[i] = 0;
+		else
+			field_74[i] = getSlopeDistance(level, chk, 1, i);
 	}
 
 	int min = field_74[0];
@@ -10,6 +10,11 @@
 
 #include "LiquidTile.hpp"
 
+// Custom: how far from the tile getSpread works on getSlopeDistance can get, and the square of columns that covers
+#define C_SLOPE_RANGE (5)
+#define C_SLOPE_SIZE (C_SLOPE_RANGE * 2 + 1)
+#define C_SLOPE_MAX_DEPTH (4)
+
 class LiquidTileDynamic : public LiquidTile
 {
 public:
@@ -26,4 +31,25 @@ public:
 	void setStatic(Level*, const TilePos& pos);
 	void trySpreadTo(Level*, const TilePos& pos, TileData data);
 	int getSmallestDepth(Level*, const TilePos& pos, int oldDepth);
+
+private:
+	enum
+	{
+		SLOPE_KNOWN      = 1 << 0,
+		SLOPE_BLOCKING   = 1 << 1, // isWaterBlocking
+		SLOPE_STILL      = 1 << 2, // a source of this liquid
+		SLOPE_OPEN_BELOW = 1 << 3, // neither of the above, and the liquid can fall through the tile below
+	};
+
+	int _getSlopeIndex(const TilePos& pos) const;
+	int _getSlopeFlags(Level*, const TilePos& pos);
+
+private:
+	// Custom: Nothing changes while getSpread runs, but the searches from the four sides
+	// keep coming back to the same tiles, and often the same way. So what's been found out
+	// about the tiles around m_slopeOrigin, and the costs worked out from them, are kept
+	// until the next getSpread.
+	TilePos m_slopeOrigin;
+	uint8_t m_slopeFlags[C_SLOPE_SIZE * C_SLOPE_SIZE];
+	int16_t m_slopeCosts[C_SLOPE_SIZE * C_SLOPE_SIZE][C_SLOPE_MAX_DEPTH][4];
 };
@@ -97,6 +97,11 @@ AABB* ReedTile::getAABB(const Level* level, const TilePos& pos)
 	return nullptr;
 }
 
+Tile::CollisionType ReedTile::getCollisionType() const
+{
+	return COLLISION_NONE;
+}
+
 int ReedTile::getResource(TileData data, Random* random) const
 {
 	return Item::reeds->m_itemID;
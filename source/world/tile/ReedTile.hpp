@@ -17,6 +17,7 @@ public:
 
 	bool canSurvive(const Level*, const TilePos& pos) const override;
 	AABB* getAABB(const Level*, const TilePos& pos) override;
+	CollisionType getCollisionType() const override;
 	int getRenderShape() const override;
 	bool isCubeShaped() const override;
 	bool isSolidRender() const override;
@@ -17,3 +17,8 @@ AABB* SoulSandTile::getAABB(const Level* pLevel, const TilePos& pos)
 	rAABB->max.y -= 2 / 16.0;
 	return rAABB;
 }
+
+Tile::CollisionType SoulSandTile::getCollisionType() const
+{
+	return COLLISION_CUSTOM;
+}
@@ -96,6 +96,7 @@ bool  Tile::shouldTick   [C_MAX_TILES];
 bool  Tile::solid        [C_MAX_TILES];
 bool  Tile::translucent  [C_MAX_TILES];
 bool  Tile::isEntityTile [C_MAX_TILES];
+uint8_t Tile::collisionType[C_MAX_TILES];
 
 
 void Tile::_init()
@@ -206,6 +207,7 @@ Tile* Tile::init()
 	lightBlock[m_ID] = isSolidRender() ? 255 : 0;
 	translucent[m_ID] = m_pMaterial->blocksLight();
 	isEntityTile[m_ID] = 0;
+	collisionType[m_ID] = getCollisionType();
 
 	return this;
 }
@@ -275,6 +277,15 @@ int Tile::getSpawnResourcesAuxValue(int x) const
 	return 0;
 }
 
+Tile::CollisionType Tile::getCollisionType() const
+{
+	// the shape doesn't change for the tiles that render as a solid cube, and getAABB returns it as is
+	if (isSolidRender() && m_aabb.min == Vec3::ZERO && m_aabb.max == Vec3(1, 1, 1))
+		return COLLISION_CUBE;
+
+	return COLLISION_CUSTOM;
+}
+
 void Tile::initTiles()
 {
 	Tile::rock = (new StoneTile(TILE_STONE, TEXTURE_STONE, Material::stone))
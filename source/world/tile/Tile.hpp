@@ -39,6 +39,14 @@ public: // structs
 		SoundType(const std::string& name, float volume, float pitch) : m_name(name), volume(volume), pitch(pitch) {}
 	};
 
+	// Custom: how a tile collides, so that Level::getCubes only has to ask the tiles that decide for themselves
+	enum CollisionType
+	{
+		COLLISION_NONE,   // never has an AABB
+		COLLISION_CUBE,   // always the whole tile
+		COLLISION_CUSTOM, // getAABB and addAABBs decide
+	};
+
 public: // virtual functions
 	virtual ~Tile();
 	virtual bool isCubeShaped() const;
@@ -103,6 +111,7 @@ public: // virtual functions
 	virtual Tile* setDestroyTime(float);
 	virtual Tile* setTicking(bool);
 	virtual int getSpawnResourcesAuxValue(int) const;
+	virtual CollisionType getCollisionType() const; // Custom
 
 private:
 	void _init();
@@ -144,6 +153,7 @@ public: // static variables
 	static bool  solid        [C_MAX_TILES];
 	static bool  translucent  [C_MAX_TILES];
 	static bool  isEntityTile [C_MAX_TILES];
+	static uint8_t collisionType[C_MAX_TILES]; // Custom
 
 	// TODO
 	static Tile
@@ -19,6 +19,11 @@ AABB* TorchTile::getAABB(const Level*, const TilePos& pos)
 	return nullptr;
 }
 
+Tile::CollisionType TorchTile::getCollisionType() const
+{
+	return COLLISION_NONE;
+}
+
 int TorchTile::getRenderShape() const
 {
 	return SHAPE_TORCH;
@@ -16,6 +16,7 @@ public:
 	TorchTile(int ID, int texture, Material* pMtl);
 
 	AABB* getAABB(const Level*, const TilePos& pos) override;
+	CollisionType getCollisionType() const override;
 	bool isSolidRender() const override;
 	bool isCubeShaped() const override;
 	int getRenderShape() const override;
@@ -19,6 +19,12 @@ bool TransparentTile::isSolidRender() const
 	return false;
 }
 
+Tile::CollisionType TransparentTile::getCollisionType() const
+{
+	// not a solid render, but still the whole tile
+	return COLLISION_CUBE;
+}
+
 bool TransparentTile::shouldRenderFace(const LevelSource* level, const TilePos& pos, Facing::Name face) const
 {
 	if (!m_bTransparent && level->getTile(pos) == m_ID)
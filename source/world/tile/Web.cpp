@@ -34,3 +34,8 @@ AABB* Web::getAABB(const Level* level, const TilePos& pos)
 {
 	return nullptr;
 }
+
+Tile::CollisionType Web::getCollisionType() const
+{
+	return COLLISION_NONE;
+}
@@ -8,6 +8,7 @@ public:
 	Web(TileID id, int texture);
 
 	AABB* getAABB(const Level*, const TilePos& pos) override;
+	CollisionType getCollisionType() const override;
 	virtual int getRenderShape() const override;
 	virtual bool isCubeShaped() const override;
 	virtual bool isSolidRender() const override;
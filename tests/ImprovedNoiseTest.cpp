@@ -0,0 +1,103 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+// Checks the noise RandomLevelSource builds terrain from against hashes of
+// what the original scalar code gave, for a range of seeds. Terrain has to
+// come out the same on every platform, so the SIMD paths, and whatever the
+// compiler makes of them, have to match these bit for bit.
+//
+// test-improved-noise uses the noise as built into the core,
+// test-improved-noise-scalar is built with NO_SIMD.
+
+#include <cstdio>
+#include "world/level/levelgen/synth/PerlinNoise.hpp"
+
+#define C_SEEDS (8)
+
+struct Golden
+{
+	int32_t m_seed;
+	unsigned long long m_hash;
+};
+
+static const Golden g_golden[C_SEEDS] =
+{
+	{ 0,          0x2ce4aad4a32fd5d7ULL },
+	{ 1,          0xfe15baf381e478eeULL },
+	{ 42,         0x0c8b694755fcec8cULL },
+	{ 123456789,  0xbc59ec16e7358255ULL },
+	{ -1,         0x422564c8c249b817ULL },
+	{ -987654321, 0xe32520eb195fc058ULL },
+	{ 0x7FFFFFFF, 0xe3d7ca6545d5ec7fULL },
+	{ 31337,      0xb3a0c80327ffdae2ULL },
+};
+
+// FNV-1a, over the bits of the floats
+static void hashFloats(unsigned long long& hash, const float* pData, int count)
+{
+	const uint8_t* pBytes = (const uint8_t*)pData;
+	for (size_t i = 0; i < count * sizeof(float); i++)
+	{
+		hash ^= pBytes[i];
+		hash *= 1099511628211ULL;
+	}
+}
+
+static unsigned long long hashSeed(int32_t seed)
+{
+	unsigned long long hash = 1469598103934665603ULL;
+
+	Random random(seed);
+	PerlinNoise noise3D(&random, 16);
+	PerlinNoise noise2D(&random, 4);
+
+	float region3D[5 * 17 * 5];
+	float region2D[16 * 16];
+	float regionFlat[16 * 1 * 16];
+
+	// the same shapes and scales as RandomLevelSource, over a few chunks on both sides of 0
+	for (int z = -3; z <= 3; z++)
+	{
+		for (int x = -3; x <= 3; x++)
+		{
+			noise3D.getRegion(region3D, float(x * 4), 0.0f, float(z * 4), 5, 17, 5, 684.412f, 684.412f, 684.412f);
+			hashFloats(hash, region3D, 5 * 17 * 5);
+
+			noise2D.getRegion(region2D, float(x) * 16.0f, float(z) * 16.0f, 0.0f, 16, 16, 1, 1.0f / 32.0f, 1.0f / 32.0f, 1.0f);
+			hashFloats(hash, region2D, 16 * 16);
+
+			noise2D.getRegion(regionFlat, float(x) * 16.0f, 109.01f, float(z) * 16.0f, 16, 1, 16, 1.0f / 32.0f, 1.0f, 1.0f / 32.0f);
+			hashFloats(hash, regionFlat, 16 * 16);
+		}
+	}
+
+	return hash;
+}
+
+int main()
+{
+	int nFailed = 0;
+	for (int i = 0; i < C_SEEDS; i++)
+	{
+		unsigned long long hash = hashSeed(g_golden[i].m_seed);
+		if (hash != g_golden[i].m_hash)
+		{
+			printf("Seed %d: got %016llx, expected %016llx\n", g_golden[i].m_seed, hash, g_golden[i].m_hash);
+			nFailed++;
+		}
+	}
+
+	if (nFailed)
+	{
+		printf("%d of %d seeds don't match\n", nFailed, C_SEEDS);
+		return 1;
+	}
+
+	printf("All %d seeds match\n", C_SEEDS);
+	return 0;
+}
@@ -0,0 +1,73 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "common/Utils.hpp"
+
+// Bits the benchmarks share. Each benchmark is its own program, and prints
+// what it measured, plus a hash of its results where those have to stay the
+// same from one version of the code to the next.
+
+class Benchmark
+{
+public:
+	// The value of "--name <n>", or the default
+	static int getArg(int argc, char* argv[], const char* name, int def)
+	{
+		for (int i = 1; i + 1 < argc; i++)
+		{
+			if (!strcmp(argv[i], name))
+				return atoi(argv[i + 1]);
+		}
+
+		return def;
+	}
+
+	Benchmark(const char* name)
+	{
+		m_name = name;
+		m_hash = 1469598103934665603ULL;
+		m_startTime = getTimeS();
+	}
+
+	void restart() { m_startTime = getTimeS(); }
+	double getElapsed() const { return getTimeS() - m_startTime; }
+
+	// FNV-1a
+	void hash(const void* pData, size_t size)
+	{
+		const uint8_t* pBytes = (const uint8_t*)pData;
+		for (size_t i = 0; i < size; i++)
+		{
+			m_hash ^= pBytes[i];
+			m_hash *= 1099511628211ULL;
+		}
+	}
+
+	// "<what>: <count> in <s> s, <count/s> <unit>/s"
+	void report(const char* what, double count, const char* unit, double seconds) const
+	{
+		printf("%s: %s: %.0f %s in %.3f s, %.1f %s/s\n", m_name, what, count, unit, seconds, count / seconds, unit);
+	}
+
+	unsigned long long getHash() const { return m_hash; }
+
+	void reportHash() const
+	{
+		printf("%s: result hash %016llx\n", m_name, (unsigned long long)m_hash);
+	}
+
+private:
+	const char* m_name;
+	unsigned long long m_hash;
+	double m_startTime;
+};
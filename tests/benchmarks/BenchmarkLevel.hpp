@@ -0,0 +1,84 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+#pragma once
+
+#include "common/Logger.hpp"
+#include "common/Mth.hpp"
+#include "world/entity/EntityTypeDescriptor.hpp"
+#include "world/entity/MobCategory.hpp"
+#include "world/item/Item.hpp"
+#include "world/level/Level.hpp"
+#include "world/level/Material.hpp"
+#include "world/level/levelgen/biome/Biome.hpp"
+#include "world/level/storage/ExternalFileLevelStorageSource.hpp"
+#include "world/tile/SandTile.hpp"
+#include "world/tile/Tile.hpp"
+#include "ToolConfig.hpp"
+
+// A level for the benchmarks that need one. It's generated from a fixed
+// seed into a directory of its own, and deleted again afterwards, so every
+// run starts from the same terrain.
+
+class BenchmarkLevel
+{
+public:
+	// What platforms/server/main.cpp sets up before it makes a level
+	static void initGame()
+	{
+		Logger::setSingleton(new Logger);
+		Mth::initMth();
+		Material::initMaterials();
+		EntityTypeDescriptor::initDescriptors();
+		MobCategory::initMobCategories();
+		Tile::initTiles();
+		Item::initItems();
+		ToolConfig::initializeToolEfficiency();
+		Biome::initBiomes();
+	}
+
+	// The dir must not be named like the benchmark's executable
+	BenchmarkLevel(const char* dir, int seed)
+	{
+		createFolderIfNotExists(dir);
+		m_pStorageSource = new ExternalFileLevelStorageSource(dir);
+		m_pStorageSource->deleteLevel("level");
+
+		m_pLevel = new Level(m_pStorageSource->selectLevel("level", false, false), "level", seed, LEVEL_STORAGE_VERSION_DEFAULT, Dimension::getNew(0));
+	}
+
+	~BenchmarkLevel()
+	{
+		SAFE_DELETE(m_pLevel);
+		m_pStorageSource->deleteLevel("level");
+		SAFE_DELETE(m_pStorageSource);
+	}
+
+	// Generates all of the chunks, like DedicatedServer::_prepareLevel but without saving them
+	void generate()
+	{
+		m_pLevel->setUpdateLights(0);
+
+		for (int x = 8; x < C_MAX_CHUNKS_X * 16; x += 16)
+		{
+			for (int z = 8; z < C_MAX_CHUNKS_Z * 16; z += 16)
+				(void)m_pLevel->getTile(TilePos(x, (C_MAX_Y + C_MIN_Y) / 2, z));
+		}
+
+		m_pLevel->setUpdateLights(1);
+		m_pLevel->prepare();
+
+		SandTile::instaFall = false;
+	}
+
+	Level* get() const { return m_pLevel; }
+
+private:
+	ExternalFileLevelStorageSource* m_pStorageSource;
+	Level* m_pLevel;
+};
@@ -0,0 +1,160 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+// Walks a crowd of 2000 pig sized boxes across the hills of a generated
+// level and times their collision steps. A step is what Entity::move does
+// with a motion: get the boxes around it, then clip it along Y, X and Z.
+// A box that bumps into something turns around.
+//
+// The crowd walks once with the boxes from Level::getCubes, and once with
+// boxes from asking every tile, like getCubes used to. Both walks have to
+// take every box down the same path.
+//
+// Options: --steps <n>, per box (default: 200)
+//          --crowd <n> (default: 2000)
+
+#include <vector>
+#include "Benchmark.hpp"
+#include "BenchmarkLevel.hpp"
+
+#define C_BENCH_DIR "collision-benchmark"
+
+typedef AABBVector* (*GetCubesFunc)(Level*, const AABB&);
+
+// What Level::getCubes did before the collision masks
+static AABBVector* getCubesPerTile(Level* pLevel, const AABB& aabb)
+{
+	static AABBVector aabbs;
+	aabbs.clear();
+
+	long lowerX = floor(aabb.min.x);
+	long upperX = floor(aabb.max.x + 1);
+	long lowerY = floor(aabb.min.y);
+	long upperY = floor(aabb.max.y + 1);
+	long lowerZ = floor(aabb.min.z);
+	long upperZ = floor(aabb.max.z + 1);
+
+	for (long x = lowerX; x <= upperX; x++)
+	{
+		for (long z = lowerZ; z <= upperZ; z++)
+		{
+			if (!pLevel->hasChunkAt(TilePos((int)x, 64, (int)z)))
+				continue;
+
+			for (long y = lowerY - 1; y <= upperY; y++)
+			{
+				TilePos tp((int)x, (int)y, (int)z);
+				Tile* pTile = Tile::tiles[pLevel->getTile(tp)];
+				if (pTile)
+					pTile->addAABBs(pLevel, tp, &aabb, aabbs);
+			}
+		}
+	}
+
+	return &aabbs;
+}
+
+static AABBVector* getCubes(Level* pLevel, const AABB& aabb)
+{
+	return pLevel->getCubes(nullptr, aabb);
+}
+
+// Entity::move, minus the stepping up and the sneaking
+static Vec3 step(GetCubesFunc getCubesFunc, Level* pLevel, const AABB& hitbox, const Vec3& motion)
+{
+	AABB aabb = hitbox, expanded = hitbox;
+	expanded.expand(motion.x, motion.y, motion.z);
+	AABBVector* pCubes = getCubesFunc(pLevel, expanded);
+
+	Vec3 clipped = motion;
+	for (size_t i = 0; i < pCubes->size(); i++)
+		clipped.y = pCubes->at(i).clipYCollide(aabb, clipped.y);
+	aabb.move(0.0f, clipped.y, 0.0f);
+
+	for (size_t i = 0; i < pCubes->size(); i++)
+		clipped.x = pCubes->at(i).clipXCollide(aabb, clipped.x);
+	aabb.move(clipped.x, 0.0f, 0.0f);
+
+	for (size_t i = 0; i < pCubes->size(); i++)
+		clipped.z = pCubes->at(i).clipZCollide(aabb, clipped.z);
+
+	return clipped;
+}
+
+static double walk(Benchmark& bench, GetCubesFunc getCubesFunc, Level* pLevel, std::vector<AABB> crowd, std::vector<Vec3> motions, int nSteps, std::vector<AABB>& out)
+{
+	bench.restart();
+	for (int i = 0; i < nSteps; i++)
+	{
+		for (size_t j = 0; j < crowd.size(); j++)
+		{
+			Vec3& motion = motions[j];
+			Vec3 clipped = step(getCubesFunc, pLevel, crowd[j], motion);
+			crowd[j].move(clipped);
+
+			if (clipped.x != motion.x)
+				motion.x = -motion.x;
+			if (clipped.z != motion.z)
+				motion.z = -motion.z;
+		}
+	}
+	double elapsed = bench.getElapsed();
+
+	out.swap(crowd);
+	return elapsed;
+}
+
+int main(int argc, char* argv[])
+{
+	Benchmark bench("collision");
+
+	int nSteps = Benchmark::getArg(argc, argv, "--steps", 200);
+	int nCrowd = Benchmark::getArg(argc, argv, "--crowd", 2000);
+
+	BenchmarkLevel::initGame();
+	BenchmarkLevel level(C_BENCH_DIR, 1);
+	level.generate();
+
+	Level* pLevel = level.get();
+
+	std::vector<AABB> crowd;
+	std::vector<Vec3> motions;
+	Random random(7);
+	for (int i = 0; i < nCrowd; i++)
+	{
+		float x = 16.0f + random.nextFloat() * 224.0f, z = 16.0f + random.nextFloat() * 224.0f;
+		float y = float(pLevel->getHeightmap(TilePos(int(x), 0, int(z))));
+		crowd.push_back(AABB(x - 0.45f, y, z - 0.45f, x + 0.45f, y + 0.9f, z + 0.45f));
+
+		// walking, and falling
+		motions.push_back(Vec3((random.nextFloat() - 0.5f) * 0.4f, -0.08f, (random.nextFloat() - 0.5f) * 0.4f));
+	}
+
+	std::vector<AABB> perTileCrowd, cubesCrowd;
+	double perTileTime = walk(bench, getCubesPerTile, pLevel, crowd, motions, nSteps, perTileCrowd);
+	double cubesTime = walk(bench, getCubes, pLevel, crowd, motions, nSteps, cubesCrowd);
+
+	int nMismatches = 0;
+	float distance = 0.0f;
+	for (int i = 0; i < nCrowd; i++)
+	{
+		if (!(perTileCrowd[i].min == cubesCrowd[i].min) || !(perTileCrowd[i].max == cubesCrowd[i].max))
+			nMismatches++;
+
+		distance += crowd[i].min.distanceTo(cubesCrowd[i].min);
+		bench.hash(&cubesCrowd[i], sizeof(AABB));
+	}
+
+	double nTotalSteps = double(nSteps) * nCrowd;
+	bench.report("per tile", nTotalSteps, "steps", perTileTime);
+	bench.report("getCubes", nTotalSteps, "steps", cubesTime);
+	printf("collision: %d boxes walked %.1f blocks on average, %d mismatches\n", nCrowd, distance / nCrowd, nMismatches);
+	bench.reportHash();
+
+	return nMismatches ? 1 : 0;
+}
@@ -0,0 +1,186 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+// Drops 1000 item entities and 200 pigs onto a 64 by 64 patch of generated
+// terrain. Each of them looks for the entities around its hitbox, grown by
+// one, the way mobs push each other and players pick items up. The lookups
+// go through the chunks, like Level::getEntities used to, and through the
+// level's EntityGrid into a vector that is reused. Both have to find the
+// same entities. Then the level is ticked with all of them in it.
+//
+// Heap allocations on this thread are counted too.
+//
+// Options: --rounds <n>, lookups per entity (default: 50)
+//          --ticks <n> (default: 100)
+
+#include <new>
+#include <algorithm>
+#include "Benchmark.hpp"
+#include "BenchmarkLevel.hpp"
+#include "world/entity/ItemEntity.hpp"
+#include "world/entity/Pig.hpp"
+
+#define C_BENCH_DIR "entity-grid-benchmark"
+#define C_ITEMS (1000)
+#define C_MOBS (200)
+
+static __thread size_t g_nAllocs;
+
+void* operator new(size_t size)
+{
+	g_nAllocs++;
+	void* pMem = malloc(size ? size : 1);
+	if (!pMem)
+		throw std::bad_alloc();
+	return pMem;
+}
+
+void operator delete(void* pMem) noexcept
+{
+	free(pMem);
+}
+
+// What Level::getEntities did before the grid
+static EntityVector getEntitiesFromChunks(Level* pLevel, Entity* pAvoid, const AABB& aabb)
+{
+	EntityVector entities;
+
+	int lowerX = Mth::floor((aabb.min.x - 2.0f) / 16);
+	int lowerZ = Mth::floor((aabb.min.z - 2.0f) / 16);
+	int upperX = Mth::floor((aabb.max.x + 2.0f) / 16);
+	int upperZ = Mth::floor((aabb.max.z + 2.0f) / 16);
+
+	for (int z = lowerZ; z <= upperZ; z++)
+	{
+		for (int x = lowerX; x <= upperX; x++)
+		{
+			if (!pLevel->hasChunk(ChunkPos(x, z)))
+				continue;
+
+			pLevel->getChunk(ChunkPos(x, z))->getEntities(pAvoid, aabb, entities);
+		}
+	}
+
+	return entities;
+}
+
+static bool compareIds(const Entity* a, const Entity* b)
+{
+	return a->m_EntityID < b->m_EntityID;
+}
+
+int main(int argc, char* argv[])
+{
+	Benchmark bench("entity-grid");
+
+	int nRounds = Benchmark::getArg(argc, argv, "--rounds", 50);
+	int nTicks = Benchmark::getArg(argc, argv, "--ticks", 100);
+
+	BenchmarkLevel::initGame();
+	BenchmarkLevel level(C_BENCH_DIR, 1);
+	level.generate();
+
+	Level* pLevel = level.get();
+	pLevel->m_random.setSeed(3);
+	Entity::sharedRandom.setSeed(1);
+
+	Random random(5);
+	for (int i = 0; i < C_ITEMS + C_MOBS; i++)
+	{
+		float x = 96.0f + random.nextFloat() * 64.0f, z = 96.0f + random.nextFloat() * 64.0f;
+		Vec3 pos(x, float(pLevel->getHeightmap(TilePos(int(x), 0, int(z)))) + 0.5f, z);
+
+		Entity* pEnt;
+		if (i < C_ITEMS)
+		{
+			pEnt = new ItemEntity(pLevel, pos, new ItemInstance(Tile::dirt, 1));
+		}
+		else
+		{
+			pEnt = new Pig(pLevel);
+			pEnt->setPos(pos);
+		}
+
+		pLevel->addEntity(pEnt);
+		// files it in its chunk and the grid without ticking it, since that
+		// would take the game's unseeded random into it
+		pLevel->tick(pEnt, false);
+	}
+
+	EntityVector all = *pLevel->getAllEntities();
+	int nEntities = int(all.size());
+
+	size_t nChunkHits = 0, nGridHits = 0, nChunkAllocs, nGridAllocs;
+	double chunkTime, gridTime;
+
+	bench.restart();
+	size_t nAllocs = g_nAllocs;
+	for (int round = 0; round < nRounds; round++)
+	{
+		for (int i = 0; i < nEntities; i++)
+		{
+			AABB aabb = all[i]->m_hitbox;
+			aabb.grow(1.0f, 1.0f, 1.0f);
+			nChunkHits += getEntitiesFromChunks(pLevel, all[i], aabb).size();
+		}
+	}
+	nChunkAllocs = g_nAllocs - nAllocs;
+	chunkTime = bench.getElapsed();
+
+	EntityVector found;
+	bench.restart();
+	nAllocs = g_nAllocs;
+	for (int round = 0; round < nRounds; round++)
+	{
+		for (int i = 0; i < nEntities; i++)
+		{
+			AABB aabb = all[i]->m_hitbox;
+			aabb.grow(1.0f, 1.0f, 1.0f);
+			pLevel->getEntities(all[i], aabb, found);
+			nGridHits += found.size();
+		}
+	}
+	nGridAllocs = g_nAllocs - nAllocs;
+	gridTime = bench.getElapsed();
+
+	// the same entities, not just as many
+	int nMismatches = 0;
+	for (int i = 0; i < nEntities; i++)
+	{
+		AABB aabb = all[i]->m_hitbox;
+		aabb.grow(1.0f, 1.0f, 1.0f);
+
+		EntityVector fromChunks = getEntitiesFromChunks(pLevel, all[i], aabb);
+		pLevel->getEntities(all[i], aabb, found);
+
+		std::sort(fromChunks.begin(), fromChunks.end(), compareIds);
+		std::sort(found.begin(), found.end(), compareIds);
+		if (fromChunks != found)
+			nMismatches++;
+
+		for (size_t j = 0; j < found.size(); j++)
+			bench.hash(&found[j]->m_EntityID, sizeof found[j]->m_EntityID);
+	}
+
+	bench.restart();
+	nAllocs = g_nAllocs;
+	for (int i = 0; i < nTicks; i++)
+		pLevel->tickEntities();
+	size_t nTickAllocs = g_nAllocs - nAllocs;
+	double tickTime = bench.getElapsed();
+
+	double nQueries = double(nRounds) * nEntities;
+	bench.report("chunk scan", nQueries, "queries", chunkTime);
+	bench.report("grid", nQueries, "queries", gridTime);
+	bench.report("tickEntities", nTicks, "ticks", tickTime);
+	printf("entity-grid: %d entities, %zu and %zu hits, %d mismatches\n", nEntities, nChunkHits, nGridHits, nMismatches);
+	printf("entity-grid: %.2f allocations per query through the chunks, %.2f through the grid, %.1f per tick\n", nChunkAllocs / nQueries, nGridAllocs / nQueries, double(nTickAllocs) / nTicks);
+	bench.reportHash();
+
+	return nMismatches || nChunkHits != nGridHits ? 1 : 0;
+}
@@ -0,0 +1,140 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+// Culls the chunks of the far view distance, 26 by 8 by 26 of them, for a
+// sweep of camera orientations: 32 headings times 7 pitches. Each one is
+// timed through Chunk::cull, one chunk at a time like the renderer used
+// to, and through FrustumCuller::areVisible in one batch. The two have to
+// agree on every chunk, bit for bit.
+//
+// Options: --rounds <n>, culls per orientation (default: 200)
+
+#include <vector>
+#include "Benchmark.hpp"
+#include "client/renderer/Chunk.hpp"
+#include "client/renderer/FrustumCuller.hpp"
+
+#define C_CHUNKS_ACROSS (26)
+#define C_CHUNKS_UP (8)
+
+// What Frustum::doOurJobInGameRenderer makes of the matrices GameRenderer
+// sets up, for a 70 degree FOV at 16:9, without asking GL for them
+static void setupFrustum(FrustumCuller& culler, float yaw, float pitch)
+{
+	float fov = 70.0f * float(M_PI) / 180.0f, aspect = 16.0f / 9.0f, zNear = 0.05f, zFar = 256.0f;
+	float f = 1.0f / tanf(fov / 2.0f);
+
+	Matrix proj;
+	memset(proj.c, 0, sizeof proj.c);
+	proj.c[0] = f / aspect;
+	proj.c[5] = f;
+	proj.c[10] = (zFar + zNear) / (zNear - zFar);
+	proj.c[11] = -1.0f;
+	proj.c[14] = 2.0f * zFar * zNear / (zNear - zFar);
+
+	// pitch around X, then yaw around Y
+	Matrix rotX(1.0f), rotY(1.0f);
+	rotX.c[5] = cosf(pitch);
+	rotX.c[6] = sinf(pitch);
+	rotX.c[9] = -sinf(pitch);
+	rotX.c[10] = cosf(pitch);
+	rotY.c[0] = cosf(yaw);
+	rotY.c[2] = -sinf(yaw);
+	rotY.c[8] = sinf(yaw);
+	rotY.c[10] = cosf(yaw);
+
+	Frustum& fr = culler.m_frustumData.x;
+	fr.m[16] = proj;
+	fr.m[17] = rotY * rotX;
+	fr.m[18] = fr.m[17] * fr.m[16];
+
+	for (int i = 0; i < 6; i++)
+	{
+		for (int j = 0; j < 4; j++)
+			fr.m[i].c[j] = fr.m[18].c[3 + j * 4] - fr.m[18].c[i / 2 + j * 4];
+
+		fr.normalizePlane(fr.m, i);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Benchmark bench("frustum-cull");
+
+	int nRounds = Benchmark::getArg(argc, argv, "--rounds", 200);
+
+	Mth::initMth();
+
+	GLuint buffers[2] = { 0, 0 };
+	std::vector<Chunk*> chunks;
+	for (int z = 0; z < C_CHUNKS_ACROSS; z++)
+	{
+		for (int y = 0; y < C_CHUNKS_UP; y++)
+		{
+			for (int x = 0; x < C_CHUNKS_ACROSS; x++)
+				chunks.push_back(new Chunk(nullptr, TilePos(x * 16 - 200, y * 16, z * 16 - 200), 16, 0, buffers));
+		}
+	}
+
+	int nChunks = int(chunks.size());
+	AABBArray boxes;
+	boxes.resize(nChunks);
+	for (int i = 0; i < nChunks; i++)
+		boxes.set(i, chunks[i]->m_aabb);
+
+	std::vector<uint32_t> visible((nChunks + 31) / 32);
+
+	FrustumCuller culler;
+	culler.prepare(8.3f, 70.6f, -3.2f);
+
+	int nOrientations = 0, nMismatches = 0;
+	double nVisible = 0.0, chunkTime = 0.0, batchTime = 0.0;
+	for (int yaw = 0; yaw < 32; yaw++)
+	{
+		for (int pitch = -3; pitch <= 3; pitch++)
+		{
+			setupFrustum(culler, float(yaw) * float(M_PI) / 16.0f, float(pitch) * 0.45f);
+			nOrientations++;
+
+			bench.restart();
+			for (int round = 0; round < nRounds; round++)
+			{
+				for (int i = 0; i < nChunks; i++)
+					chunks[i]->cull(&culler);
+			}
+			chunkTime += bench.getElapsed();
+
+			bench.restart();
+			for (int round = 0; round < nRounds; round++)
+				culler.areVisible(boxes, &visible[0]);
+			batchTime += bench.getElapsed();
+
+			for (int i = 0; i < nChunks; i++)
+			{
+				bool bVisible = (visible[i >> 5] >> (i & 31)) & 1;
+				if (bVisible != chunks[i]->m_bVisible)
+					nMismatches++;
+				if (bVisible)
+					nVisible++;
+			}
+
+			bench.hash(&visible[0], visible.size() * sizeof(uint32_t));
+		}
+	}
+
+	for (int i = 0; i < nChunks; i++)
+		delete chunks[i];
+
+	double nCulled = double(nOrientations) * nRounds * nChunks;
+	bench.report("Chunk::cull", nCulled, "chunks", chunkTime);
+	bench.report("areVisible", nCulled, "chunks", batchTime);
+	printf("frustum-cull: %d orientations, %.1f%% of the chunks visible, %d mismatches\n", nOrientations, 100.0 * nVisible / (double(nOrientations) * nChunks), nMismatches);
+	bench.reportHash();
+
+	return nMismatches ? 1 : 0;
+}
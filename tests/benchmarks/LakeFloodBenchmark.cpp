@@ -0,0 +1,101 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+// Floods a stone basin, 128 by 128 and 24 deep, from a grid of water
+// sources on its rim, and times the game ticks it takes. Those are almost
+// all spent in Level::tickPendingTicks.
+//
+// Options: --ticks <n> (default: 400)
+//          --spacing <n>, between the sources (default: 8)
+
+#include "Benchmark.hpp"
+#include "BenchmarkLevel.hpp"
+
+#define C_BENCH_DIR "lake-flood-benchmark"
+
+#define C_BASIN_MIN_XZ (64)
+#define C_BASIN_MAX_XZ (191)
+#define C_BASIN_MIN_Y  (40)
+#define C_BASIN_MAX_Y  (63)
+
+int main(int argc, char* argv[])
+{
+	Benchmark bench("lake-flood");
+
+	int nTicks = Benchmark::getArg(argc, argv, "--ticks", 400);
+	int spacing = Benchmark::getArg(argc, argv, "--spacing", 8);
+	if (spacing < 1)
+		spacing = 1;
+
+	BenchmarkLevel::initGame();
+	BenchmarkLevel level(C_BENCH_DIR, 1);
+	level.generate();
+
+	Level* pLevel = level.get();
+	pLevel->setUpdateLights(0);
+	pLevel->m_random.setSeed(3);
+	Entity::sharedRandom.setSeed(1);
+
+	int32_t time = 1000;
+	pLevel->setTime(time);
+
+	// the basin, with nothing above it
+	for (int x = C_BASIN_MIN_XZ - 1; x <= C_BASIN_MAX_XZ + 1; x++)
+	{
+		for (int z = C_BASIN_MIN_XZ - 1; z <= C_BASIN_MAX_XZ + 1; z++)
+		{
+			for (int y = C_BASIN_MIN_Y - 1; y <= C_BASIN_MAX_Y + 8; y++)
+			{
+				bool bWall = x < C_BASIN_MIN_XZ || x > C_BASIN_MAX_XZ || z < C_BASIN_MIN_XZ || z > C_BASIN_MAX_XZ || y < C_BASIN_MIN_Y;
+				pLevel->setTileNoUpdate(TilePos(x, y, z), bWall && y <= C_BASIN_MAX_Y ? Tile::rock->m_ID : TILE_AIR);
+			}
+		}
+	}
+
+	for (int x = C_BASIN_MIN_XZ; x <= C_BASIN_MAX_XZ; x += spacing)
+	{
+		for (int z = C_BASIN_MIN_XZ; z <= C_BASIN_MAX_XZ; z += spacing)
+			pLevel->setTile(TilePos(x, C_BASIN_MAX_Y, z), Tile::water->m_ID);
+	}
+
+	int peakPending = 0;
+	bench.restart();
+	for (int i = 0; i < nTicks; i++)
+	{
+		pLevel->setTime(++time);
+		pLevel->tickPendingTicks(false);
+
+		if (peakPending < pLevel->m_pendingTicks.size())
+			peakPending = pLevel->m_pendingTicks.size();
+	}
+	double elapsed = bench.getElapsed();
+
+	int nWet = 0;
+	for (int x = C_BASIN_MIN_XZ; x <= C_BASIN_MAX_XZ; x++)
+	{
+		for (int z = C_BASIN_MIN_XZ; z <= C_BASIN_MAX_XZ; z++)
+		{
+			for (int y = C_BASIN_MIN_Y; y <= C_BASIN_MAX_Y; y++)
+			{
+				TilePos pos(x, y, z);
+				TileID tile = pLevel->getTile(pos);
+				TileData data = pLevel->getData(pos);
+				if (tile != TILE_AIR)
+					nWet++;
+
+				bench.hash(&tile, sizeof tile);
+				bench.hash(&data, sizeof data);
+			}
+		}
+	}
+
+	bench.report("flood", nTicks, "ticks", elapsed);
+	printf("lake-flood: %d tile ticks pending at most, %d left, %d wet tiles\n", peakPending, pLevel->m_pendingTicks.size(), nWet);
+	bench.reportHash();
+	return 0;
+}
@@ -0,0 +1,355 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+// Places 200 torches on generated terrain, one at a time, then takes them
+// away again, then digs a 32 by 32 pit 31 deep, and times each of those
+// until the light has settled.
+//
+// It's done twice, on two copies of the level. One goes through the
+// LightEngine, the other has the level's light updates turned off and goes
+// through a copy of the LightUpdate box sweeps the engine replaced. That
+// one is fed the requests LevelChunk::setTile makes for each tile. Both
+// copies have to end up with the same light on every tile.
+//
+// Options: --torches <n> (default: 200)
+
+#include <vector>
+#include "Benchmark.hpp"
+#include "BenchmarkLevel.hpp"
+#include "world/level/levelgen/chunk/LevelChunk.hpp"
+
+#define C_BENCH_DIR "light-benchmark"
+#define C_OLD_BENCH_DIR "light-benchmark-old"
+
+#define C_PIT_MIN_XZ (112)
+#define C_PIT_SIZE   (32)
+#define C_PIT_DEPTH  (31)
+
+// The light updates as Level kept them before the LightEngine
+class OldLightUpdates
+{
+public:
+	OldLightUpdates(Level* pLevel) : m_pLevel(pLevel) {}
+
+	void updateLight(const LightLayer& ll, const TilePos& tilePos1, const TilePos& tilePos2)
+	{
+		TilePos mid((tilePos2.x + tilePos1.x) / 2, (tilePos2.y + tilePos1.y) / 2, (tilePos2.z + tilePos1.z) / 2);
+
+		if (!m_pLevel->hasChunkAt(mid) || m_pLevel->getChunkAt(mid)->isEmpty())
+			return;
+
+		size_t size = m_updates.size();
+		size_t count = size < 5 ? size : 5;
+		for (size_t i = 0; i < count; i++)
+		{
+			LightUpdate& update = m_updates[size - i - 1];
+			if (update.m_lightLayer == &ll && update.expandToContain(tilePos1, tilePos2))
+				return;
+		}
+
+		m_updates.push_back(LightUpdate(ll, tilePos1, tilePos2));
+
+		if (m_updates.size() > 1000000)
+			m_updates.clear();
+	}
+
+	void updateLightIfOtherThan(const LightLayer& ll, const TilePos& tilePos, int bright)
+	{
+		if (!m_pLevel->hasChunkAt(tilePos))
+			return;
+
+		if (&ll == &LightLayer::Sky)
+		{
+			if (m_pLevel->isSkyLit(tilePos))
+				bright = 15;
+		}
+		else
+		{
+			TileID tile = m_pLevel->getTile(tilePos);
+			if (bright < Tile::lightEmission[tile])
+				bright = Tile::lightEmission[tile];
+		}
+
+		if (m_pLevel->getBrightness(ll, tilePos) != bright)
+			updateLight(ll, tilePos, tilePos);
+	}
+
+	// Level::updateLights, minus the cap on the calls to it
+	bool updateLights()
+	{
+		for (int i = 499; i && !m_updates.empty(); i--)
+		{
+			LightUpdate update = m_updates.back();
+			m_updates.pop_back();
+
+			update.update(this, m_pLevel);
+		}
+
+		return !m_updates.empty();
+	}
+
+private:
+	struct LightUpdate
+	{
+		const LightLayer* m_lightLayer;
+		TilePos m_tilePos1, m_tilePos2;
+
+		LightUpdate(const LightLayer& ll, const TilePos& tilePos1, const TilePos& tilePos2)
+		{
+			m_lightLayer = &ll;
+			m_tilePos1 = tilePos1;
+			m_tilePos2 = tilePos2;
+		}
+
+		bool expandToContain(const TilePos& tilePos1, const TilePos& tilePos2)
+		{
+			if (m_tilePos1 <= tilePos1 && m_tilePos2 >= tilePos2)
+				return true;
+
+			if (tilePos1 < m_tilePos1 - 1) return false;
+			if (tilePos2 > m_tilePos2 + 1) return false;
+
+			TilePos tp1(tilePos1), tp2(tilePos2);
+			if (tp1.y >= m_tilePos1.y) tp1.y = m_tilePos1.y;
+			if (tp1.x >= m_tilePos1.x) tp1.x = m_tilePos1.x;
+			if (tp2.y < m_tilePos2.y)  tp2.y = m_tilePos2.y;
+			if (tp1.z >= m_tilePos1.z) tp1.z = m_tilePos1.z;
+			if (tp2.x < m_tilePos2.x)  tp2.x = m_tilePos2.x;
+			if (tp2.z < m_tilePos2.z)  tp2.z = m_tilePos2.z;
+
+			if ((tp2.z - tp1.z) * (tp2.x - tp1.x) * (tp2.y - tp1.y) - (m_tilePos2.z - m_tilePos1.z) * (m_tilePos2.x - m_tilePos1.x) * (m_tilePos2.y - m_tilePos1.y) > 2)
+				return false;
+
+			m_tilePos1 = tp1;
+			m_tilePos2 = tp2;
+			return true;
+		}
+
+		// The box sweep, untangled, but checking the same neighbours in the same order
+		void update(OldLightUpdates* pUpdates, Level* pLevel)
+		{
+			const LightLayer& ll = *m_lightLayer;
+
+			if ((m_tilePos2.z - m_tilePos1.z + 1) * (m_tilePos2.x - m_tilePos1.x + 1) * (m_tilePos2.y - m_tilePos1.y + 1) > 32768)
+				return;
+
+			for (int x = m_tilePos1.x; x <= m_tilePos2.x; x++)
+			{
+				for (int z = m_tilePos1.z; z <= m_tilePos2.z; z++)
+				{
+					if (!pLevel->hasChunksAt(TilePos(x, 0, z), 1) || pLevel->getChunk(TilePos(x, 0, z))->isEmpty())
+						continue;
+
+					if (m_tilePos1.y < 0)   m_tilePos1.y = 0;
+					if (m_tilePos2.y > 127) m_tilePos2.y = 127;
+
+					for (int y = m_tilePos1.y; y <= m_tilePos2.y; y++)
+					{
+						TilePos pos(x, y, z);
+						int oldBr = pLevel->getBrightness(ll, pos);
+						TileID tile = pLevel->getTile(pos);
+						int opacity = Tile::lightBlock[tile];
+						if (!opacity)
+							opacity = 1;
+
+						int emission;
+						if (&ll == &LightLayer::Sky)
+							emission = pLevel->isSkyLit(pos) ? 15 : 0;
+						else
+							emission = Tile::lightEmission[tile];
+
+						int newBr = 0;
+						if (opacity <= 14 || emission)
+						{
+							int brightest = pLevel->getBrightness(ll, pos.west());
+							brightest = Mth::Max(brightest, pLevel->getBrightness(ll, pos.east()));
+							brightest = Mth::Max(brightest, pLevel->getBrightness(ll, pos.below()));
+							brightest = Mth::Max(brightest, pLevel->getBrightness(ll, pos.above()));
+							brightest = Mth::Max(brightest, pLevel->getBrightness(ll, pos.north()));
+							brightest = Mth::Max(brightest, pLevel->getBrightness(ll, pos.south()));
+
+							newBr = Mth::Max(brightest - opacity, 0);
+							if (newBr < emission)
+								newBr = emission;
+						}
+
+						if (newBr == oldBr)
+							continue;
+
+						pLevel->setBrightness(ll, pos, newBr);
+
+						int newBrN = Mth::Max(newBr - 1, 0);
+						pUpdates->updateLightIfOtherThan(ll, pos.west(), newBrN);
+						pUpdates->updateLightIfOtherThan(ll, pos.below(), newBrN);
+						pUpdates->updateLightIfOtherThan(ll, pos.north(), newBrN);
+						if (m_tilePos2.x <= x + 1)
+							pUpdates->updateLightIfOtherThan(ll, pos.east(), newBrN);
+						if (m_tilePos2.y <= y + 1)
+							pUpdates->updateLightIfOtherThan(ll, pos.above(), newBrN);
+						if (m_tilePos2.z <= z + 1)
+							pUpdates->updateLightIfOtherThan(ll, pos.south(), newBrN);
+					}
+				}
+			}
+		}
+	};
+
+private:
+	Level* m_pLevel;
+	std::vector<LightUpdate> m_updates;
+};
+
+// One of the two copies of the level, and how its light gets updated
+class LightBench
+{
+public:
+	LightBench(const char* dir, bool bOld) : m_level(dir, 1), m_oldUpdates(m_level.get()), m_bOld(bOld)
+	{
+		Level* pLevel = m_level.get();
+
+		// generated with its light, like Minecraft::prepareLevel does
+		for (int x = 8; x < C_MAX_CHUNKS_X * 16; x += 16)
+		{
+			for (int z = 8; z < C_MAX_CHUNKS_Z * 16; z += 16)
+			{
+				(void)pLevel->getTile(TilePos(x, (C_MAX_Y + C_MIN_Y) / 2, z));
+				while (pLevel->updateLights());
+			}
+		}
+		pLevel->prepare();
+		while (pLevel->updateLights());
+
+		if (m_bOld)
+			pLevel->setUpdateLights(0);
+	}
+
+	Level* get() const { return m_level.get(); }
+
+	void setTile(const TilePos& pos, TileID tile)
+	{
+		if (!m_level.get()->setTile(pos, tile) || !m_bOld)
+			return;
+
+		m_oldUpdates.updateLight(LightLayer::Sky, pos, pos);
+		m_oldUpdates.updateLight(LightLayer::Block, pos, pos);
+	}
+
+	void settle()
+	{
+		if (m_bOld)
+			while (m_oldUpdates.updateLights());
+		else
+			while (m_level.get()->updateLights());
+	}
+
+private:
+	BenchmarkLevel m_level;
+	OldLightUpdates m_oldUpdates;
+	bool m_bOld;
+};
+
+// The edits, each timed until the light has settled
+static void edit(Benchmark& bench, LightBench& light, const std::vector<TilePos>& torches, double times[3])
+{
+	bench.restart();
+	for (size_t i = 0; i < torches.size(); i++)
+	{
+		light.setTile(torches[i], Tile::torch->m_ID);
+		light.settle();
+	}
+	times[0] = bench.getElapsed();
+
+	bench.restart();
+	for (size_t i = 0; i < torches.size(); i++)
+	{
+		light.setTile(torches[i], TILE_AIR);
+		light.settle();
+	}
+	times[1] = bench.getElapsed();
+
+	Level* pLevel = light.get();
+	int top = 0;
+	for (int x = C_PIT_MIN_XZ; x < C_PIT_MIN_XZ + C_PIT_SIZE; x++)
+	{
+		for (int z = C_PIT_MIN_XZ; z < C_PIT_MIN_XZ + C_PIT_SIZE; z++)
+			top = Mth::Max(top, pLevel->getHeightmap(TilePos(x, 0, z)));
+	}
+
+	bench.restart();
+	for (int y = top; y > top - C_PIT_DEPTH; y--)
+	{
+		for (int x = C_PIT_MIN_XZ; x < C_PIT_MIN_XZ + C_PIT_SIZE; x++)
+		{
+			for (int z = C_PIT_MIN_XZ; z < C_PIT_MIN_XZ + C_PIT_SIZE; z++)
+				light.setTile(TilePos(x, y, z), TILE_AIR);
+		}
+	}
+	light.settle();
+	times[2] = bench.getElapsed();
+}
+
+int main(int argc, char* argv[])
+{
+	Benchmark bench("light");
+
+	int nTorches = Benchmark::getArg(argc, argv, "--torches", 200);
+
+	BenchmarkLevel::initGame();
+	LightBench light(C_BENCH_DIR, false);
+	LightBench oldLight(C_OLD_BENCH_DIR, true);
+
+	// on the ground, away from the pit
+	Level* pLevel = light.get();
+	std::vector<TilePos> torches;
+	Random random(9);
+	while (int(torches.size()) < nTorches)
+	{
+		int x = 16 + random.nextInt(96), z = 16 + random.nextInt(224);
+		TilePos pos(x, pLevel->getHeightmap(TilePos(x, 0, z)), z);
+		if (pLevel->getTile(pos) == TILE_AIR && pLevel->isSolidTile(pos.below()))
+			torches.push_back(pos);
+	}
+
+	double times[3], oldTimes[3];
+	edit(bench, light, torches, times);
+	edit(bench, oldLight, torches, oldTimes);
+
+	int nMismatches = 0;
+	ChunkPos cp(0, 0);
+	for (cp.x = 0; cp.x < C_MAX_CHUNKS_X; cp.x++)
+	{
+		for (cp.z = 0; cp.z < C_MAX_CHUNKS_Z; cp.z++)
+		{
+			LevelChunk* pChunk = light.get()->getChunk(cp);
+			LevelChunk* pOldChunk = oldLight.get()->getChunk(cp);
+
+			for (unsigned i = 0; i < pChunk->m_lightSky.m_size; i++)
+			{
+				// two tiles to a byte
+				uint8_t sky = pChunk->m_lightSky.m_data[i] ^ pOldChunk->m_lightSky.m_data[i];
+				uint8_t blk = pChunk->m_lightBlk.m_data[i] ^ pOldChunk->m_lightBlk.m_data[i];
+				nMismatches += ((sky | blk) & 0xF) != 0;
+				nMismatches += ((sky | blk) >> 4) != 0;
+			}
+
+			bench.hash(pChunk->m_lightSky.m_data, pChunk->m_lightSky.m_size);
+			bench.hash(pChunk->m_lightBlk.m_data, pChunk->m_lightBlk.m_size);
+		}
+	}
+
+	bench.report("LightEngine, torches placed", nTorches, "torches", times[0]);
+	bench.report("LightUpdate, torches placed", nTorches, "torches", oldTimes[0]);
+	bench.report("LightEngine, torches removed", nTorches, "torches", times[1]);
+	bench.report("LightUpdate, torches removed", nTorches, "torches", oldTimes[1]);
+	bench.report("LightEngine, pit dug", C_PIT_SIZE * C_PIT_SIZE * C_PIT_DEPTH, "tiles", times[2]);
+	bench.report("LightUpdate, pit dug", C_PIT_SIZE * C_PIT_SIZE * C_PIT_DEPTH, "tiles", oldTimes[2]);
+	printf("light: %d tiles lit differently\n", nMismatches);
+	bench.reportHash();
+
+	return nMismatches ? 1 : 0;
+}
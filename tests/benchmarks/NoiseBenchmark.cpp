@@ -0,0 +1,61 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+// Fills the noise regions RandomLevelSource asks for per chunk, in the same
+// shapes and with the same octave counts.
+//
+// bench-noise uses the SIMD noise where there is one, bench-noise-scalar is
+// built with NO_SIMD. Their result hashes have to match.
+//
+// Options: --chunks <n> (default: 2000)
+
+#include "Benchmark.hpp"
+#include "common/SIMD.hpp"
+#include "world/level/levelgen/synth/PerlinNoise.hpp"
+
+int main(int argc, char* argv[])
+{
+#ifdef USE_SIMD
+	Benchmark bench("noise (SIMD)");
+#else
+	Benchmark bench("noise (scalar)");
+#endif
+
+	int nChunks = Benchmark::getArg(argc, argv, "--chunks", 2000);
+
+	Random random(12345);
+	PerlinNoise noise3D(&random, 16);
+	PerlinNoise noise2D(&random, 4);
+
+	float region3D[5 * 17 * 5];
+	float region2D[16 * 16];
+
+	double time3D = 0.0, time2D = 0.0;
+	for (int i = 0; i < nChunks; i++)
+	{
+		int x = i % 64 - 32, z = i / 64 - 32;
+
+		// the density field, sampled every 4 blocks across and 8 up
+		bench.restart();
+		noise3D.getRegion(region3D, float(x * 4), 0.0f, float(z * 4), 5, 17, 5, 684.412f, 684.412f, 684.412f);
+		time3D += bench.getElapsed();
+
+		// the surface noise, one sample per column
+		bench.restart();
+		noise2D.getRegion(region2D, float(x) * 16.0f, float(z) * 16.0f, 0.0f, 16, 16, 1, 1.0f / 32.0f, 1.0f / 32.0f, 1.0f);
+		time2D += bench.getElapsed();
+
+		bench.hash(region3D, sizeof region3D);
+		bench.hash(region2D, sizeof region2D);
+	}
+
+	bench.report("3D, 16 octaves", double(nChunks) * 5 * 17 * 5 * 16, "samples", time3D);
+	bench.report("2D, 4 octaves", double(nChunks) * 16 * 16 * 4, "samples", time2D);
+	bench.reportHash();
+	return 0;
+}
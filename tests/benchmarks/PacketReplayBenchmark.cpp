@@ -0,0 +1,225 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+// Replays a recorded stream of Move/UpdateBlock packets into a
+// RakNetInstance, and counts the packets handled per second and the heap
+// allocations per packet on this thread. The same stream is also read
+// the way the original runEvents did, with a new BitStream and a new
+// packet for each one.
+//
+// Some of the packets are cut short on purpose. Their missing fields have
+// to read as those of a new packet, never as the last packet's, so both
+// ways have to come up with the same hash.
+//
+// Options: --rounds <n> (default: 200)
+
+#include <new>
+#include <vector>
+#include "Benchmark.hpp"
+#include "network/MinecraftPackets.hpp"
+#include "network/NetEventCallback.hpp"
+#include "network/RakNetInstance.hpp"
+
+// RakNet's own thread allocates too, so only this one is counted
+static __thread size_t g_nAllocs;
+
+void* operator new(size_t size)
+{
+	g_nAllocs++;
+	void* pMem = malloc(size ? size : 1);
+	if (!pMem)
+		throw std::bad_alloc();
+	return pMem;
+}
+
+void operator delete(void* pMem) noexcept
+{
+	free(pMem);
+}
+
+struct RecordedPacket
+{
+	std::vector<uint8_t> m_data;
+};
+
+class ReplayCallback : public NetEventCallback
+{
+public:
+	ReplayCallback(Benchmark& bench) : m_bench(bench), m_nHandled(0) {}
+
+	void handle(const RakNet::RakNetGUID&, MovePlayerPacket* pPacket) override
+	{
+		m_bench.hash(&pPacket->m_id, sizeof pPacket->m_id);
+		m_bench.hash(&pPacket->m_pos, sizeof pPacket->m_pos);
+		m_bench.hash(&pPacket->m_rot, sizeof pPacket->m_rot);
+		m_nHandled++;
+	}
+
+	void handle(const RakNet::RakNetGUID&, UpdateBlockPacket* pPacket) override
+	{
+		m_bench.hash(&pPacket->m_pos, sizeof pPacket->m_pos);
+		m_bench.hash(&pPacket->m_tileTypeId, sizeof pPacket->m_tileTypeId);
+		m_bench.hash(&pPacket->m_data, sizeof pPacket->m_data);
+		m_nHandled++;
+	}
+
+	void handle(const RakNet::RakNetGUID&, MoveEntitiesPacket* pPacket) override
+	{
+		for (size_t i = 0; i < pPacket->m_moves.size(); i++)
+			m_bench.hash(&pPacket->m_moves[i].m_id, sizeof pPacket->m_moves[i].m_id);
+		m_nHandled++;
+	}
+
+public:
+	Benchmark& m_bench;
+	int m_nHandled;
+};
+
+static void record(std::vector<RecordedPacket>& stream, Packet& packet, int cut)
+{
+	RakNet::BitStream bs;
+	packet.write(&bs);
+
+	RecordedPacket recorded;
+	recorded.m_data.assign(bs.GetData(), bs.GetData() + bs.GetNumberOfBytesUsed() - cut);
+	stream.push_back(recorded);
+}
+
+int main(int argc, char* argv[])
+{
+	int nRounds = Benchmark::getArg(argc, argv, "--rounds", 200);
+
+	// what a server with a handful of players and some mobs around sends a client
+	std::vector<RecordedPacket> stream;
+	for (int i = 0; i < 3000; i++)
+	{
+		// every 50th packet is missing its last 6 bytes
+		int cut = i % 50 == 49 ? 6 : 0;
+
+		switch (i % 3)
+		{
+			case 0:
+			{
+				MovePlayerPacket packet(i % 8, Vec3(100.5f + i, 64.0f, 80.25f), Vec2(float(i % 360), 3.0f));
+				record(stream, packet, cut);
+				break;
+			}
+			case 1:
+			{
+				UpdateBlockPacket packet;
+				packet.m_pos = TilePos(i & 255, 60, 7);
+				packet.m_tileTypeId = TileID(i & 63);
+				packet.m_data = TileData(i & 15);
+				record(stream, packet, cut);
+				break;
+			}
+			default:
+			{
+				MoveEntitiesPacket packet;
+				for (int j = 0; j < 6; j++)
+				{
+					MoveEntitiesPacket::Move move;
+					move.m_id = i + j;
+					move.m_flags = MoveEntitiesPacket::MOVE_POS_DELTA | MoveEntitiesPacket::MOVE_ROT;
+					move.m_pos[0] = 1;
+					move.m_pos[1] = -2;
+					move.m_pos[2] = 3;
+					move.m_rot[0] = 5;
+					move.m_rot[1] = 6;
+					packet.m_moves.push_back(move);
+				}
+				record(stream, packet, cut);
+				break;
+			}
+		}
+	}
+
+	double nPackets = double(nRounds) * stream.size();
+	unsigned long long expectedHash = 0;
+
+	// the original way
+	{
+		Benchmark bench("packet-replay (allocating)");
+		ReplayCallback callback(bench);
+		RakNet::RakNetGUID guid;
+
+		size_t nAllocs = g_nAllocs;
+		bench.restart();
+		for (int round = 0; round < nRounds; round++)
+		{
+			for (size_t i = 0; i < stream.size(); i++)
+			{
+				uint8_t* pData = &stream[i].m_data[0];
+				RakNet::BitStream* pBitStream = new RakNet::BitStream(pData + 1, unsigned(stream[i].m_data.size() - 1), false);
+				Packet* pPacket = MinecraftPackets::createPacket(pData[0]);
+				pPacket->read(pBitStream);
+				pPacket->handle(guid, &callback);
+				delete pPacket;
+				delete pBitStream;
+			}
+		}
+		double time = bench.getElapsed();
+
+		bench.report("handled", nPackets, "packets", time);
+		printf("%s: %.3f allocations per packet\n", "packet-replay (allocating)", double(g_nAllocs - nAllocs) / nPackets);
+		bench.reportHash();
+		expectedHash = bench.getHash();
+	}
+
+	// through RakNetInstance::runEvents, the packets are pushed into RakNet's receive queue
+	{
+		Benchmark bench("packet-replay (RakNetInstance)");
+		ReplayCallback callback(bench);
+
+		RakNetInstance* pInstance = new RakNetInstance;
+		if (!pInstance->host("bench", 0, 4))
+		{
+			printf("Can't start RakNet\n");
+			return 1;
+		}
+
+		RakNet::RakPeerInterface* pPeer = pInstance->getPeer();
+		double time = 0.0;
+		size_t nAllocs = 0;
+		for (int round = 0; round < nRounds; round++)
+		{
+			for (size_t i = 0; i < stream.size(); i++)
+			{
+				RakNet::Packet* pPacket = pPeer->AllocatePacket(unsigned(stream[i].m_data.size()));
+				memcpy(pPacket->data, &stream[i].m_data[0], stream[i].m_data.size());
+				pPeer->PushBackPacket(pPacket, false);
+			}
+
+			size_t nAllocsBefore = g_nAllocs;
+			bench.restart();
+			pInstance->runEvents(&callback);
+			time += bench.getElapsed();
+			nAllocs += g_nAllocs - nAllocsBefore;
+		}
+
+		if (callback.m_nHandled != int(nPackets))
+		{
+			printf("Only %d of %.0f packets were handled\n", callback.m_nHandled, nPackets);
+			return 1;
+		}
+
+		bench.report("handled", nPackets, "packets", time);
+		printf("%s: %.3f allocations per packet\n", "packet-replay (RakNetInstance)", double(nAllocs) / nPackets);
+		bench.reportHash();
+
+		delete pInstance;
+
+		if (bench.getHash() != expectedHash)
+		{
+			printf("The reused packets were read differently from new ones\n");
+			return 1;
+		}
+	}
+
+	return 0;
+}
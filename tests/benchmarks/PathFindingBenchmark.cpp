@@ -0,0 +1,84 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+// Scatters 400 zombies around four spots on generated terrain, like mobs
+// gathering around four players at night, and times finding each of them
+// a path to its spot with Level::findPath.
+//
+// Options: --rounds <n>, paths found per zombie (default: 5)
+
+#include <vector>
+#include "Benchmark.hpp"
+#include "BenchmarkLevel.hpp"
+#include "world/entity/Zombie.hpp"
+#include "world/level/path/Path.hpp"
+
+#define C_BENCH_DIR "path-finding-benchmark"
+#define C_ZOMBIES (400)
+#define C_SPOTS (4)
+
+int main(int argc, char* argv[])
+{
+	Benchmark bench("path-finding");
+
+	int nRounds = Benchmark::getArg(argc, argv, "--rounds", 5);
+
+	BenchmarkLevel::initGame();
+	BenchmarkLevel level(C_BENCH_DIR, 1);
+	level.generate();
+
+	Level* pLevel = level.get();
+	pLevel->setTime(18000);
+
+	TilePos spots[C_SPOTS];
+	for (int i = 0; i < C_SPOTS; i++)
+	{
+		int x = 64 + 128 * (i & 1), z = 64 + 128 * (i >> 1);
+		spots[i] = TilePos(x, pLevel->getHeightmap(TilePos(x, 0, z)), z);
+	}
+
+	// within 20 blocks of their spot, on the ground
+	Random random(11);
+	std::vector<Mob*> zombies;
+	for (int i = 0; i < C_ZOMBIES; i++)
+	{
+		const TilePos& spot = spots[i % C_SPOTS];
+		float x = float(spot.x) + random.nextFloat() * 40.0f - 20.0f;
+		float z = float(spot.z) + random.nextFloat() * 40.0f - 20.0f;
+
+		Mob* pZombie = new Zombie(pLevel);
+		pZombie->setPos(Vec3(x, float(pLevel->getHeightmap(TilePos(int(x), 0, int(z)))) + 0.5f, z));
+		pLevel->addEntity(pZombie);
+		zombies.push_back(pZombie);
+	}
+
+	Path path;
+	int nFound = 0, nNodes = 0;
+
+	bench.restart();
+	for (int round = 0; round < nRounds; round++)
+	{
+		for (int i = 0; i < C_ZOMBIES; i++)
+		{
+			path.clear();
+			if (pLevel->findPath(&path, zombies[i], spots[i % C_SPOTS], 16.0f))
+				nFound++;
+
+			for (int j = 0; j < path.getSize(); j++)
+				bench.hash(&path.get(j)->m_tilePos, sizeof(TilePos));
+
+			nNodes += path.getSize();
+		}
+	}
+	double elapsed = bench.getElapsed();
+
+	bench.report("find", double(nRounds) * C_ZOMBIES, "paths", elapsed);
+	printf("path-finding: %d paths found, %d nodes in them\n", nFound, nNodes);
+	bench.reportHash();
+	return 0;
+}
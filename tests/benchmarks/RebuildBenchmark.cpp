@@ -0,0 +1,172 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+// Meshes every 16x16x16 section of a generated level the way Chunk::rebuild
+// does, minus the upload. Slabs, farmland, stairs and fences are put on the
+// section borders first, since those read their neighbours the furthest.
+// Each section is meshed from a live Region, like rebuild used to, and from
+// a snapshot Region, copying it included. Both have to give the same
+// vertices, bit for bit.
+//
+// Options: --rounds <n>, meshes of each section (default: 2)
+
+#include <vector>
+#include "Benchmark.hpp"
+#include "BenchmarkLevel.hpp"
+#include "client/renderer/TileRenderer.hpp"
+#include "world/level/Region.hpp"
+
+#define C_BENCH_DIR "rebuild-benchmark"
+
+static Tesselator g_tesselator(0x200000);
+static std::vector<Tesselator::Vertex> g_vertices;
+
+// Chunk::rebuild, with the vertices of both layers going into g_vertices
+static void meshSection(Region& region, const TilePos& min)
+{
+	TileRenderer tileRenderer(&region, &g_tesselator);
+	Tesselator& t = g_tesselator;
+
+	TilePos max(min + 16);
+	g_vertices.clear();
+
+	TilePos tp(min);
+	for (int layer = 0; layer < 2; layer++)
+	{
+		bool bTesselatedAnything = false, bNeedAnotherLayer = false;
+		for (tp.y = min.y; tp.y < max.y; tp.y++)
+		{
+			for (tp.z = min.z; tp.z < max.z; tp.z++)
+			{
+				for (tp.x = min.x; tp.x < max.x; tp.x++)
+				{
+					TileID tile = region.getTile(tp);
+					if (tile <= 0) continue;
+
+					if (!bTesselatedAnything)
+					{
+						bTesselatedAnything = true;
+						t.begin();
+						t.offset(float(-min.x), float(-min.y), float(-min.z));
+					}
+
+					Tile* pTile = Tile::tiles[tile];
+
+					if (layer == pTile->getRenderLayer())
+						tileRenderer.tesselateInWorld(pTile, tp);
+					else
+						bNeedAnotherLayer = true;
+				}
+			}
+		}
+
+		if (bTesselatedAnything)
+		{
+			std::vector<Tesselator::Vertex> vertices;
+			t.end(vertices);
+			t.offset(0.0f, 0.0f, 0.0f);
+			g_vertices.insert(g_vertices.end(), vertices.begin(), vertices.end());
+		}
+
+		if (!bNeedAnotherLayer)
+			break;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Benchmark bench("rebuild");
+
+	int nRounds = Benchmark::getArg(argc, argv, "--rounds", 2);
+
+	BenchmarkLevel::initGame();
+	BenchmarkLevel level(C_BENCH_DIR, 1);
+	level.generate();
+
+	Level* pLevel = level.get();
+
+	// one of these on every third bit of floor along the section borders,
+	// in the caves too, where the light doesn't come from above
+	Tile* borderTiles[] = { Tile::stoneSlabHalf, Tile::farmland, Tile::stairs_wood, Tile::fence };
+	Random random(5);
+	for (int x = 0; x < C_MAX_CHUNKS_X * 16; x++)
+	{
+		for (int z = 0; z < C_MAX_CHUNKS_Z * 16; z++)
+		{
+			if ((x & 15) != 0 && (x & 15) != 15 && (z & 15) != 0 && (z & 15) != 15)
+				continue;
+
+			for (int y = C_MIN_Y + 1; y < C_MAX_Y; y++)
+			{
+				TilePos pos(x, y, z);
+				if (pLevel->getTile(pos) != TILE_AIR || !pLevel->isSolidTile(pos.below()) || random.nextInt(3) != 0)
+					continue;
+
+				pLevel->setTileAndDataNoUpdate(pos, borderTiles[random.nextInt(4)]->m_ID, random.nextInt(4));
+			}
+		}
+	}
+
+	std::vector<TilePos> sections;
+	for (int x = 0; x < C_MAX_CHUNKS_X; x++)
+	{
+		for (int z = 0; z < C_MAX_CHUNKS_Z; z++)
+		{
+			for (int y = 0; y < C_MAX_Y / 16; y++)
+				sections.push_back(TilePos(x * 16, y * 16, z * 16));
+		}
+	}
+
+	int nSections = int(sections.size()), nMismatches = 0;
+	double liveTime = 0.0, snapshotTime = 0.0, nVertices = 0.0;
+	std::vector<Tesselator::Vertex> liveVertices;
+	for (int round = 0; round < nRounds; round++)
+	{
+		for (int i = 0; i < nSections; i++)
+		{
+			const TilePos& min = sections[i];
+
+			// the box Chunk::rebuild used to look at
+			bench.restart();
+			{
+				Region region(pLevel, min - 1, min + 17);
+				meshSection(region, min);
+			}
+			liveTime += bench.getElapsed();
+
+			liveVertices.swap(g_vertices);
+
+			// the box ChunkBuilder::queue and Chunk::rebuild snapshot now
+			bench.restart();
+			{
+				Region region(pLevel, min - 2, min + 17, true);
+				meshSection(region, min);
+			}
+			snapshotTime += bench.getElapsed();
+
+			size_t size = g_vertices.size() * sizeof(Tesselator::Vertex);
+			if (liveVertices.size() != g_vertices.size() || (size && memcmp(&liveVertices[0], &g_vertices[0], size)))
+				nMismatches++;
+
+			if (round == 0)
+			{
+				if (size)
+					bench.hash(&g_vertices[0], size);
+				nVertices += double(g_vertices.size());
+			}
+		}
+	}
+
+	double nMeshed = double(nRounds) * nSections;
+	bench.report("live Region", nMeshed, "chunks", liveTime);
+	bench.report("snapshot Region", nMeshed, "chunks", snapshotTime);
+	printf("rebuild: %d sections, %.0f vertices in them, %d mismatches\n", nSections, nVertices, nMismatches);
+	bench.reportHash();
+
+	return nMismatches ? 1 : 0;
+}
@@ -0,0 +1,132 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+// Saves and loads all 256 chunks of a level's chunks.dat.
+//
+// bench-region-file maps the file, bench-region-file-stdio is built with
+// NO_MMAP_REGION_FILE and goes through stdio like the original did. Both
+// write the same data, so their result hashes have to match.
+//
+// Options: --rounds <n> (default: 20)
+
+#include <vector>
+#include "Benchmark.hpp"
+#include "world/level/storage/RegionFile.hpp"
+
+#define C_CHUNK_BYTES (16 * 16 * 128 + 16 * 16 * 128 / 2 * 3 + 256) // tiles, data, both lights and the update map
+#define C_BENCH_DIR "region-file-benchmark"
+
+// so that reading the views can't be optimized away
+volatile int g_sink;
+
+static void fillChunk(std::vector<uint8_t>& data, const ChunkPos& pos, int round)
+{
+	// mostly runs of the same tile, like real terrain, so the sizes are realistic if it gets compressed
+	uint32_t state = uint32_t(pos.x * 73856093) ^ uint32_t(pos.z * 19349663) ^ uint32_t(round * 83492791);
+	for (size_t i = 0; i < data.size(); i++)
+	{
+		if ((i & 63) == 0)
+			state = state * 1664525 + 1013904223;
+		data[i] = uint8_t(state >> 24);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+#ifdef USE_MMAP_REGION_FILE
+	Benchmark bench("region-file (mmap)");
+#else
+	Benchmark bench("region-file (stdio)");
+#endif
+
+	int nRounds = Benchmark::getArg(argc, argv, "--rounds", 20);
+
+	createFolderIfNotExists(C_BENCH_DIR);
+	remove(C_BENCH_DIR "/chunks.dat");
+
+	RegionFile* pRegionFile = new RegionFile(C_BENCH_DIR);
+	if (!pRegionFile->open())
+	{
+		printf("Can't open " C_BENCH_DIR "/chunks.dat\n");
+		return 1;
+	}
+
+	std::vector<uint8_t> data(C_CHUNK_BYTES);
+	double saveTime = 0.0, loadTime = 0.0, viewTime = 0.0;
+
+	for (int round = 0; round < nRounds; round++)
+	{
+		ChunkPos pos;
+		for (pos.z = 0; pos.z < 16; pos.z++)
+		{
+			for (pos.x = 0; pos.x < 16; pos.x++)
+			{
+				fillChunk(data, pos, round);
+				RakNet::BitStream bs(&data[0], unsigned(data.size()), false);
+
+				bench.restart();
+				pRegionFile->writeChunk(pos, bs);
+				saveTime += bench.getElapsed();
+			}
+		}
+
+		// what ChunkStorage did before: a copy of each chunk in a BitStream of its own
+		bench.restart();
+		for (pos.z = 0; pos.z < 16; pos.z++)
+		{
+			for (pos.x = 0; pos.x < 16; pos.x++)
+			{
+				RakNet::BitStream* pBitStream = nullptr;
+				if (!pRegionFile->readChunk(pos, &pBitStream))
+				{
+					printf("Chunk %d, %d is missing\n", pos.x, pos.z);
+					return 1;
+				}
+
+				if (round == nRounds - 1)
+					bench.hash(pBitStream->GetData(), pBitStream->GetNumberOfBytesUsed());
+
+				delete[] pBitStream->GetData();
+				delete pBitStream;
+			}
+		}
+		loadTime += bench.getElapsed();
+
+		// and what it does now
+		bench.restart();
+		for (pos.z = 0; pos.z < 16; pos.z++)
+		{
+			for (pos.x = 0; pos.x < 16; pos.x++)
+			{
+				const uint8_t* pData = nullptr;
+				int length = 0;
+				if (!pRegionFile->readChunkView(pos, &pData, &length) || length != C_CHUNK_BYTES)
+				{
+					printf("Chunk %d, %d is missing\n", pos.x, pos.z);
+					return 1;
+				}
+
+				// touch all of it, like loading it into a LevelChunk would
+				int sum = 0;
+				for (int i = 0; i < length; i += 64)
+					sum += pData[i];
+				g_sink += sum;
+			}
+		}
+		viewTime += bench.getElapsed();
+	}
+
+	delete pRegionFile;
+	remove(C_BENCH_DIR "/chunks.dat");
+
+	bench.report("save", 256.0 * nRounds, "chunks", saveTime);
+	bench.report("load (copied)", 256.0 * nRounds, "chunks", loadTime);
+	bench.report("load (view)", 256.0 * nRounds, "chunks", viewTime);
+	bench.reportHash();
+	return 0;
+}
@@ -0,0 +1,119 @@
+/********************************************************************
+	Minecraft: Pocket Edition - Decompilation Project
+	Copyright (C) 2023 iProgramInCpp
+
+	The following code is licensed under the BSD 1 clause license.
+	SPDX-License-Identifier: BSD-1-Clause
+ ********************************************************************/
+
+// Times what Minecraft::prepareLevel does to a new world from a fixed seed:
+// generating, lighting and post-processing all of its chunks, then
+// Level::prepare. Saving is left out. Each run is made once the way it used
+// to be, one chunk after another, and once with the terrain built by the
+// worker threads of ChunkSource::prepareChunks first. Both have to end up
+// with the same world, bit for bit.
+//
+// Options: --runs <n>, of each (default: 3)
+//          --seed <n> (default: 1)
+
+#include "Benchmark.hpp"
+#include "BenchmarkLevel.hpp"
+#include "world/level/levelgen/chunk/LevelChunk.hpp"
+
+#define C_BENCH_DIR "startup-benchmark"
+
+static double prepareLevel(Benchmark& bench, int seed, bool bPrepareChunks, unsigned long long* pHash)
+{
+	BenchmarkLevel level(C_BENCH_DIR, seed);
+	Level* pLevel = level.get();
+
+	bench.restart();
+
+	if (bPrepareChunks)
+		pLevel->getChunkSource()->prepareChunks(ChunkPos(0, 0), ChunkPos(C_MAX_CHUNKS_X - 1, C_MAX_CHUNKS_Z - 1));
+
+	for (int x = 8; x < C_MAX_CHUNKS_X * 16; x += 16)
+	{
+		for (int z = 8; z < C_MAX_CHUNKS_Z * 16; z += 16)
+		{
+			(void)pLevel->getTile(TilePos(x, (C_MAX_Y + C_MIN_Y) / 2, z));
+			while (pLevel->updateLights());
+		}
+	}
+
+	ChunkPos cp(0, 0);
+	for (cp.x = 0; cp.x < C_MAX_CHUNKS_X; cp.x++)
+	{
+		for (cp.z = 0; cp.z < C_MAX_CHUNKS_Z; cp.z++)
+		{
+			LevelChunk* pChunk = pLevel->getChunk(cp);
+			if (!pChunk || pChunk->field_237)
+				continue;
+
+			pChunk->m_bUnsaved = false;
+			pChunk->clearUpdateMap();
+		}
+	}
+
+	pLevel->prepare();
+
+	double elapsed = bench.getElapsed();
+
+	Benchmark world("world");
+	for (cp.x = 0; cp.x < C_MAX_CHUNKS_X; cp.x++)
+	{
+		for (cp.z = 0; cp.z < C_MAX_CHUNKS_Z; cp.z++)
+		{
+			LevelChunk* pChunk = pLevel->getChunk(cp);
+			world.hash(pChunk->m_pBlockData, 16 * 16 * 128 * sizeof(TileID));
+			world.hash(pChunk->m_tileData.m_data, pChunk->m_tileData.m_size);
+			world.hash(pChunk->m_lightSky.m_data, pChunk->m_lightSky.m_size);
+			world.hash(pChunk->m_lightBlk.m_data, pChunk->m_lightBlk.m_size);
+			world.hash(pChunk->m_heightMap, sizeof pChunk->m_heightMap);
+		}
+	}
+	*pHash = world.getHash();
+
+	return elapsed;
+}
+
+int main(int argc, char* argv[])
+{
+	Benchmark bench("startup");
+
+	int nRuns = Benchmark::getArg(argc, argv, "--runs", 3);
+	int seed = Benchmark::getArg(argc, argv, "--seed", 1);
+
+	BenchmarkLevel::initGame();
+
+	double serialTime = 0.0, parallelTime = 0.0;
+	unsigned long long serialHash = 0, parallelHash = 0;
+	int nMismatches = 0;
+	for (int run = 0; run < nRuns; run++)
+	{
+		unsigned long long hash;
+
+		serialTime += prepareLevel(bench, seed, false, &hash);
+		if (run == 0)
+			serialHash = hash;
+		if (hash != serialHash)
+			nMismatches++;
+
+		parallelTime += prepareLevel(bench, seed, true, &hash);
+		if (run == 0)
+			parallelHash = hash;
+		if (hash != serialHash)
+			nMismatches++;
+	}
+
+	bench.hash(&serialHash, sizeof serialHash);
+
+	int nChunks = nRuns * C_MAX_CHUNKS_X * C_MAX_CHUNKS_Z;
+	bench.report("one by one", nChunks, "chunks", serialTime);
+	bench.report("prepareChunks", nChunks, "chunks", parallelTime);
+	printf("startup: %.0f ms one by one, %.0f ms with prepareChunks, per world\n", 1000.0 * serialTime / nRuns, 1000.0 * parallelTime / nRuns);
+	printf("startup: world hashes %016llx and %016llx, %d mismatches\n", serialHash, parallelHash, nMismatches);
+	bench.reportHash();
+
+	return nMismatches ? 1 : 0;
+}